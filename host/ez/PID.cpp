@@ -0,0 +1,191 @@
+/**
+ * @file PID.cpp
+ * @brief Host stand-in for ez::PID: derivative on measurement, gated integral, timed exit conditions.
+ */
+
+#include <cmath>
+
+#include "EZ-Template/api.hpp"
+
+namespace ez {
+
+PID::PID() { reset_i_sgn = true; }
+
+PID::PID(double p, double i, double d, double start_i, std::string name) {
+    reset_i_sgn = true;
+    constants_set(p, i, d, start_i);
+    if (!name.empty()) name_set(name);
+}
+
+void PID::constants_set(double p, double i, double d, double p_start_i) { constants = {p, i, d, p_start_i}; }
+
+PID::Constants PID::constants_get() { return constants; }
+
+bool PID::constants_set_check() { return !(constants.kp == 0 && constants.ki == 0 && constants.kd == 0 && constants.start_i == 0); }
+
+void PID::exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time,
+                             int p_mA_timeout) {
+    exit = {p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout};
+}
+
+void PID::target_set(double input) { target = input; }
+
+double PID::target_get() { return target; }
+
+void PID::name_set(std::string p_name) {
+    name = p_name;
+    name_active = !name.empty();
+}
+
+std::string PID::name_get() { return name; }
+
+void PID::i_reset_toggle(bool toggle) { reset_i_sgn = toggle; }
+
+bool PID::i_reset_get() { return reset_i_sgn; }
+
+void PID::variables_reset() {
+    output = 0;
+    target = 0;
+    error = 0;
+    prev_error = 0;
+    integral = 0;
+    time = 0;
+    prev_time = 0;
+}
+
+void PID::velocity_sensor_secondary_set(double secondary_sensor) { second_sensor = secondary_sensor; }
+double PID::velocity_sensor_secondary_get() { return second_sensor; }
+void PID::velocity_sensor_secondary_toggle_set(bool toggle) { use_second_sensor = toggle; }
+bool PID::velocity_sensor_secondary_toggle_get() { return use_second_sensor; }
+void PID::velocity_sensor_main_exit_set(double zero) { velocity_zero_main = zero; }
+double PID::velocity_sensor_main_exit_get() { return velocity_zero_main; }
+void PID::velocity_sensor_secondary_exit_set(double zero) { velocity_zero_secondary = zero; }
+double PID::velocity_sensor_secondary_exit_get() { return velocity_zero_secondary; }
+
+double PID::compute(double current) { return compute_error(target - current, current); }
+
+double PID::compute_error(double err, double current) {
+    error = err;
+    cur = current;
+    return raw_compute();
+}
+
+double PID::raw_compute() {
+    // Derivative on measurement so target changes don't kick the output
+    derivative = cur - prev_current;
+
+    if (constants.ki != 0) {
+        if (std::fabs(error) < constants.start_i) integral += error;
+        if (util::sgn(error) != util::sgn(prev_error) && reset_i_sgn) integral = 0;
+    }
+
+    output = (error * constants.kp) + (integral * constants.ki) - (derivative * constants.kd);
+
+    prev_current = cur;
+    prev_error = error;
+    return output;
+}
+
+void PID::timers_reset() {
+    i = 0;
+    j = 0;
+    k = 0;
+    l = 0;
+    m = 0;
+    is_mA = false;
+}
+
+void PID::exit_condition_print(ez::exit_output exit_type) {
+    std::string label = name_active ? name + " " : "";
+    printf("   %s%s Exit.\n", label.c_str(), exit_to_string(exit_type).c_str());
+}
+
+ez::exit_output PID::exit_condition(bool print) {
+    if (exit.small_error == 0 && exit.small_exit_time == 0 && exit.big_error == 0 && exit.big_exit_time == 0 &&
+        exit.velocity_exit_time == 0 && exit.mA_timeout == 0) {
+        if (print) exit_condition_print(ERROR_NO_CONSTANTS);
+        return ERROR_NO_CONSTANTS;
+    }
+
+    // Within small_error for small_exit_time, the motion is done
+    if (exit.small_error != 0) {
+        if (std::fabs(error) < exit.small_error) {
+            j += util::DELAY_TIME;
+            i = 0;  // big exit doesn't run while small exit is counting
+            if (j > exit.small_exit_time) {
+                timers_reset();
+                if (print) exit_condition_print(SMALL_EXIT);
+                return SMALL_EXIT;
+            }
+        } else {
+            j = 0;
+        }
+    }
+
+    // Within big_error but not getting closer for big_exit_time, good enough
+    if (exit.big_error != 0 && exit.big_exit_time != 0) {
+        if (std::fabs(error) < exit.big_error) {
+            i += util::DELAY_TIME;
+            if (i > exit.big_exit_time) {
+                timers_reset();
+                if (print) exit_condition_print(BIG_EXIT);
+                return BIG_EXIT;
+            }
+        } else {
+            i = 0;
+        }
+    }
+
+    // Not moving for velocity_exit_time, something is in the way
+    if (exit.velocity_exit_time != 0) {
+        bool stopped = std::fabs(derivative) <= velocity_zero_main;
+        if (use_second_sensor) stopped = stopped && std::fabs(second_sensor) <= velocity_zero_secondary;
+        if (stopped) {
+            k += util::DELAY_TIME;
+            if (k > exit.velocity_exit_time) {
+                timers_reset();
+                if (print) exit_condition_print(VELOCITY_EXIT);
+                return VELOCITY_EXIT;
+            }
+        } else {
+            k = 0;
+        }
+    }
+
+    return RUNNING;
+}
+
+ez::exit_output PID::exit_condition(pros::Motor sensor, bool print) {
+    return exit_condition(std::vector<pros::Motor>{sensor}, print);
+}
+
+ez::exit_output PID::exit_condition(std::vector<pros::Motor> sensor, bool print) {
+    // Motors pulling over their limit for mA_timeout means the robot is pushing on something
+    if (exit.mA_timeout != 0) {
+        is_mA = false;
+        for (auto& motor : sensor)
+            if (motor.is_over_current()) is_mA = true;
+
+        if (is_mA) {
+            l += util::DELAY_TIME;
+            if (l > exit.mA_timeout) {
+                timers_reset();
+                if (print) exit_condition_print(mA_EXIT);
+                return mA_EXIT;
+            }
+        } else {
+            l = 0;
+        }
+    }
+
+    return exit_condition(print);
+}
+
+ez::exit_output PID::exit_condition(pros::MotorGroup sensor, bool print) {
+    std::vector<pros::Motor> motors;
+    for (auto port : sensor.get_port_all())
+        motors.emplace_back(port);
+    return exit_condition(motors, print);
+}
+
+}  // namespace ez
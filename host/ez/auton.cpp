@@ -0,0 +1,20 @@
+/**
+ * @file auton.cpp
+ * @brief Host stand-in for ez::Auton, a named autonomous routine.
+ */
+
+#include "EZ-Template/api.hpp"
+
+namespace ez {
+
+Auton::Auton() {
+    Name = "";
+    auton_call = nullptr;
+}
+
+Auton::Auton(std::string name, std::function<void()> callback) {
+    Name = name;
+    auton_call = callback;
+}
+
+}  // namespace ez
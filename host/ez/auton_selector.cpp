@@ -0,0 +1,41 @@
+/**
+ * @file auton_selector.cpp
+ * @brief Host stand-in for ez::AutonSelector, the paged list of autonomous routines.
+ */
+
+#include "EZ-Template/api.hpp"
+
+namespace ez {
+
+AutonSelector::AutonSelector() {
+    auton_count = 0;
+    auton_page_current = 0;
+    last_auton_page_current = 0;
+}
+
+AutonSelector::AutonSelector(std::vector<Auton> autons) {
+    auton_count = autons.size();
+    auton_page_current = 0;
+    last_auton_page_current = 0;
+    Autons = autons;
+}
+
+void AutonSelector::selected_auton_print() {
+    if (auton_count == 0 || auton_page_current >= auton_count) return;
+    for (int i = 0; i < 8; i++)
+        pros::lcd::clear_line(i);
+    ez::screen_print("Page " + std::to_string(auton_page_current + 1) + "\n" + Autons[auton_page_current].Name);
+}
+
+void AutonSelector::selected_auton_call() {
+    if (auton_count == 0 || auton_page_current >= auton_count) return;
+    Autons[auton_page_current].auton_call();
+}
+
+void AutonSelector::autons_add(std::vector<Auton> autons) {
+    auton_count += autons.size();
+    for (auto& auton : autons)
+        Autons.push_back(auton);
+}
+
+}  // namespace ez
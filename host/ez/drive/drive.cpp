@@ -0,0 +1,298 @@
+/**
+ * @file drive.cpp
+ * @brief Host stand-in for ez::Drive construction, sensors, and motor output.
+ */
+
+#include <cmath>
+
+#include "EZ-Template/api.hpp"
+
+using namespace ez;
+
+Drive::Drive(std::vector<int> left_motor_ports, std::vector<int> right_motor_ports, int imu_port, double wheel_diameter, double ticks,
+             double ratio)
+    : imu(imu_port),
+      left_tracker(0, 0, false),
+      right_tracker(0, 0, false),
+      left_rotation(0),
+      right_rotation(0),
+      ez_auto([this] { this->ez_auto_task(); }) {
+    is_tracker = DRIVE_INTEGRATED;
+    odom_tracker_left = nullptr;
+    odom_tracker_right = nullptr;
+    odom_tracker_front = nullptr;
+    odom_tracker_back = nullptr;
+
+    // EZ's "ticks" argument is the wheel RPM, the cartridge is the closest one at or above it
+    pros::motor_gearset_e_t gearset = ticks > 200 ? pros::E_MOTOR_GEARSET_06 : ticks > 100 ? pros::E_MOTOR_GEARSET_18 : pros::E_MOTOR_GEARSET_36;
+    for (auto port : left_motor_ports) {
+        pros::Motor motor(port);
+        motor.set_gearing(gearset);
+        motor.set_encoder_units(pros::E_MOTOR_ENCODER_COUNTS);
+        left_motors.push_back(motor);
+    }
+    for (auto port : right_motor_ports) {
+        pros::Motor motor(port);
+        motor.set_gearing(gearset);
+        motor.set_encoder_units(pros::E_MOTOR_ENCODER_COUNTS);
+        right_motors.push_back(motor);
+    }
+
+    WHEEL_DIAMETER = wheel_diameter;
+    RATIO = ratio;
+    CARTRIDGE = ticks;
+    drive_tick_per_inch();
+
+    drive_defaults_set();
+}
+
+void Drive::drive_defaults_set() {
+    std::cout << std::fixed;
+    std::cout << std::setprecision(2);
+
+    // PID constants
+    pid_drive_constants_set(20.0, 0.0, 100.0);
+    pid_heading_constants_set(11.0, 0.0, 20.0);
+    pid_turn_constants_set(3.0, 0.05, 20.0, 15.0);
+    pid_swing_constants_set(6.0, 0.0, 65.0);
+    pid_odom_angular_constants_set(6.5, 0.0, 52.5);
+    pid_odom_boomerang_constants_set(5.8, 0.0, 32.5);
+    pid_turn_min_set(30);
+    pid_swing_min_set(30);
+
+    // Exit conditions
+    pid_turn_exit_condition_set(90_ms, 3_deg, 250_ms, 7_deg, 500_ms, 500_ms);
+    pid_swing_exit_condition_set(90_ms, 3_deg, 250_ms, 7_deg, 500_ms, 500_ms);
+    pid_drive_exit_condition_set(90_ms, 1_in, 250_ms, 3_in, 500_ms, 500_ms);
+    pid_odom_turn_exit_condition_set(90_ms, 3_deg, 250_ms, 7_deg, 500_ms, 750_ms);
+    pid_odom_drive_exit_condition_set(90_ms, 1_in, 250_ms, 3_in, 500_ms, 750_ms);
+    pid_turn_chain_constant_set(3_deg);
+    pid_swing_chain_constant_set(5_deg);
+    pid_drive_chain_constant_set(3_in);
+
+    // Slew constants
+    slew_turn_constants_set(3_deg, 70);
+    slew_drive_constants_set(3_in, 70);
+    slew_swing_constants_set(3_in, 80);
+
+    // Odom
+    odom_path_spacing_set(0.5_in);
+    odom_path_smooth_constants_set(0.75, 0.03, 0.0001);
+    odom_look_ahead_set(7_in);
+    odom_boomerang_distance_set(12_in);
+    odom_boomerang_dlead_set(0.625);
+    pid_angle_behavior_tolerance_set(3_deg);
+    pid_angle_behavior_bias_set(ez::left_turn);
+    pid_turn_behavior_set(ez::shortest);
+    pid_swing_behavior_set(ez::shortest);
+    pid_odom_behavior_set(ez::shortest);
+
+    // Opcontrol
+    opcontrol_joystick_threshold_set(5);
+    opcontrol_curve_default_set(0.0, 0.0);
+    opcontrol_curve_buttons_left_set(pros::E_CONTROLLER_DIGITAL_LEFT, pros::E_CONTROLLER_DIGITAL_RIGHT);
+    opcontrol_curve_buttons_right_set(pros::E_CONTROLLER_DIGITAL_Y, pros::E_CONTROLLER_DIGITAL_A);
+
+    pid_speed_max_set(127);
+    pid_drive_toggle(true);
+    pid_print_toggle(true);
+    mode = DISABLE;
+}
+
+void Drive::initialize() {
+    opcontrol_curve_sd_initialize();
+    drive_imu_calibrate();
+    drive_sensor_reset();
+}
+
+// Motors
+void Drive::private_drive_set(int left, int right) {
+    if (!drive_toggle) return;
+
+    left = util::clamp(left, 127);
+    right = util::clamp(right, 127);
+    for (auto& motor : left_motors)
+        if (!pto_check(motor)) motor.move_voltage(left * (12000.0 / 127.0));
+    for (auto& motor : right_motors)
+        if (!pto_check(motor)) motor.move_voltage(right * (12000.0 / 127.0));
+}
+
+void Drive::drive_set(int left, int right) {
+    drive_mode_set(DISABLE, false);
+    private_drive_set(left, right);
+}
+
+std::vector<int> Drive::drive_get() {
+    return {left_motors.front().get_voltage() * 127 / 12000, right_motors.front().get_voltage() * 127 / 12000};
+}
+
+void Drive::drive_mode_set(e_mode p_mode, bool stop_drive) {
+    mode = p_mode;
+    if (mode == DISABLE && stop_drive) private_drive_set(0, 0);
+}
+
+e_mode Drive::drive_mode_get() { return mode; }
+
+void Drive::drive_brake_set(pros::motor_brake_mode_e_t brake_type) {
+    CURRENT_BRAKE = brake_type;
+    for (auto& motor : left_motors) motor.set_brake_mode(brake_type);
+    for (auto& motor : right_motors) motor.set_brake_mode(brake_type);
+}
+
+pros::motor_brake_mode_e_t Drive::drive_brake_get() { return CURRENT_BRAKE; }
+
+void Drive::drive_current_limit_set(int mA) {
+    CURRENT_MA = util::clamp(mA, 2500, 0);
+    for (auto& motor : left_motors) motor.set_current_limit(CURRENT_MA);
+    for (auto& motor : right_motors) motor.set_current_limit(CURRENT_MA);
+}
+
+int Drive::drive_current_limit_get() { return CURRENT_MA; }
+
+void Drive::pid_drive_toggle(bool toggle) { drive_toggle = toggle; }
+bool Drive::pid_drive_toggle_get() { return drive_toggle; }
+void Drive::pid_print_toggle(bool toggle) { print_toggle = toggle; }
+bool Drive::pid_print_toggle_get() { return print_toggle; }
+
+// PTO
+bool Drive::pto_check(pros::Motor check_if_pto) {
+    for (auto port : pto_active)
+        if (port == check_if_pto.get_port()) return true;
+    return false;
+}
+
+void Drive::pto_add(std::vector<pros::Motor> pto_list) {
+    for (auto& motor : pto_list)
+        if (!pto_check(motor)) pto_active.push_back(motor.get_port());
+}
+
+void Drive::pto_remove(std::vector<pros::Motor> pto_list) {
+    for (auto& motor : pto_list)
+        std::erase(pto_active, motor.get_port());
+}
+
+void Drive::pto_toggle(std::vector<pros::Motor> pto_list, bool toggle) {
+    if (toggle) pto_add(pto_list);
+    else pto_remove(pto_list);
+}
+
+// Sensors
+double Drive::drive_tick_per_inch() {
+    CIRCUMFERENCE = WHEEL_DIAMETER * M_PI;
+    TICK_PER_REV = (50.0 * (3600.0 / CARTRIDGE)) * RATIO;
+    TICK_PER_INCH = TICK_PER_REV / CIRCUMFERENCE;
+    return TICK_PER_INCH;
+}
+
+void Drive::drive_ratio_set(double ratio) {
+    RATIO = ratio;
+    drive_tick_per_inch();
+}
+
+void Drive::drive_rpm_set(double rpm) {
+    CARTRIDGE = rpm;
+    drive_tick_per_inch();
+}
+
+double Drive::drive_ratio_get() { return RATIO; }
+double Drive::drive_rpm_get() { return CARTRIDGE; }
+
+int Drive::drive_sensor_left_raw() { return left_motors.front().get_position(); }
+int Drive::drive_sensor_right_raw() { return right_motors.front().get_position(); }
+
+double Drive::drive_sensor_left() {
+    if (odom_tracker_left_enabled) return odom_tracker_left->get();
+    return drive_sensor_left_raw() / drive_tick_per_inch();
+}
+
+double Drive::drive_sensor_right() {
+    if (odom_tracker_right_enabled) return odom_tracker_right->get();
+    return drive_sensor_right_raw() / drive_tick_per_inch();
+}
+
+int Drive::drive_velocity_left() { return left_motors.front().get_actual_velocity(); }
+int Drive::drive_velocity_right() { return right_motors.front().get_actual_velocity(); }
+double Drive::drive_mA_left() { return left_motors.front().get_current_draw(); }
+double Drive::drive_mA_right() { return right_motors.front().get_current_draw(); }
+bool Drive::drive_current_left_over() { return left_motors.front().is_over_current(); }
+bool Drive::drive_current_right_over() { return right_motors.front().is_over_current(); }
+
+void Drive::drive_sensor_reset() {
+    for (auto& motor : left_motors) motor.tare_position();
+    for (auto& motor : right_motors) motor.tare_position();
+    if (odom_tracker_left_enabled) odom_tracker_left->reset();
+    if (odom_tracker_right_enabled) odom_tracker_right->reset();
+    if (odom_tracker_front_enabled) odom_tracker_front->reset();
+    if (odom_tracker_back_enabled) odom_tracker_back->reset();
+
+    // Odometry works off deltas, so the last readings follow the sensors back to zero
+    h_last = 0.0;
+    l_last = 0.0;
+    r_last = 0.0;
+}
+
+// IMU
+void Drive::drive_imu_reset(double new_heading) {
+    imu.set_rotation(new_heading);
+    t_last = new_heading;
+}
+
+double Drive::drive_imu_get() { return imu.get_rotation() * IMU_SCALER; }
+
+double Drive::drive_imu_accel_get() {
+    pros::imu_accel_s_t accel = imu.get_accel();
+    return accel.x + accel.y;
+}
+
+void Drive::drive_imu_scaler_set(double scaler) { IMU_SCALER = scaler; }
+double Drive::drive_imu_scaler_get() { return IMU_SCALER; }
+
+bool Drive::drive_imu_calibrate(bool run_loading_animation) {
+    imu.reset();
+    int iter = 0;
+    while (true) {
+        iter += util::DELAY_TIME;
+        if (run_loading_animation) drive_imu_display_loading(iter);
+
+        if (iter >= 2000) {
+            if (!(imu.is_calibrating())) break;
+            if (iter >= 3000) {
+                printf("No IMU plugged in, (took %d ms to realize that)\n", iter);
+                imu_calibrate_took_too_long = true;
+                return false;
+            }
+        }
+        pros::delay(util::DELAY_TIME);
+    }
+    imu_calibration_complete = true;
+    return true;
+}
+
+bool Drive::drive_imu_calibrated() { return imu_calibration_complete; }
+
+void Drive::drive_imu_display_loading(int iter) {
+    if (iter % 500 == 0) pros::lcd::set_text(1, "Calibrating IMU" + std::string(iter / 500, '.'));
+}
+
+// Heading
+void Drive::pid_targets_reset() {
+    headingPID.target_set(0);
+    leftPID.target_set(0);
+    rightPID.target_set(0);
+    forward_drivePID.target_set(0);
+    backward_drivePID.target_set(0);
+    turnPID.target_set(0);
+    swingPID.target_set(0);
+    xyPID.target_set(0);
+    current_a_odomPID.target_set(0);
+    odom_target = {0.0, 0.0, 0.0};
+    drive_mode_set(DISABLE, false);
+}
+
+void Drive::drive_angle_set(double angle) {
+    headingPID.target_set(angle);
+    drive_imu_reset(angle);
+    odom_current.theta = angle;
+}
+
+void Drive::drive_angle_set(okapi::QAngle p_angle) { drive_angle_set(p_angle.convert(okapi::degree)); }
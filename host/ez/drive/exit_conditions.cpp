@@ -0,0 +1,238 @@
+/**
+ * @file exit_conditions.cpp
+ * @brief Host stand-in for ez::Drive's pid_wait family.
+ */
+
+#include <cmath>
+
+#include "EZ-Template/api.hpp"
+#include "sim/profile.hpp"
+
+using namespace ez;
+
+namespace {
+
+// Exit names as the profiler reports them, both sides are only listed when they differ
+std::string exit_name(exit_output exit) {
+    switch (exit) {
+        case SMALL_EXIT: return "SMALL_EXIT";
+        case BIG_EXIT: return "BIG_EXIT";
+        case VELOCITY_EXIT: return "VELOCITY_EXIT";
+        case mA_EXIT: return "mA_EXIT";
+        default: return exit_to_string(exit);
+    }
+}
+
+std::string exit_name(exit_output first, exit_output second) {
+    return first == second ? exit_name(first) : exit_name(first) + "/" + exit_name(second);
+}
+
+}  // namespace
+
+void Drive::pid_wait() {
+    sim::ProfileScope profile(sim::ProfileKind::WAIT, "pid_wait");
+    interfered = false;
+
+    if (mode == DRIVE) {
+        exit_output left_exit = RUNNING;
+        exit_output right_exit = RUNNING;
+        while (left_exit == RUNNING || right_exit == RUNNING) {
+            left_exit = left_exit != RUNNING ? left_exit : leftPID.exit_condition(left_motors[0]);
+            right_exit = right_exit != RUNNING ? right_exit : rightPID.exit_condition(right_motors[0]);
+            pros::delay(util::DELAY_TIME);
+        }
+        if (print_toggle) printf("  Left: %s Exit, error: %.2f.   Right: %s Exit, error: %.2f\n", exit_to_string(left_exit).c_str(), leftPID.error,
+                                 exit_to_string(right_exit).c_str(), rightPID.error);
+        sim::ProfileExitSet(exit_name(left_exit, right_exit));
+        if (left_exit == mA_EXIT || left_exit == VELOCITY_EXIT || right_exit == mA_EXIT || right_exit == VELOCITY_EXIT) interfered = true;
+    }
+
+    else if (mode == TURN || mode == TURN_TO_POINT) {
+        exit_output turn_exit = RUNNING;
+        while (turn_exit == RUNNING) {
+            turn_exit = turnPID.exit_condition({left_motors[0], right_motors[0]});
+            pros::delay(util::DELAY_TIME);
+        }
+        if (print_toggle) printf("  Turn: %s Exit, error: %.2f\n", exit_to_string(turn_exit).c_str(), turnPID.error);
+        sim::ProfileExitSet(exit_name(turn_exit));
+        if (turn_exit == mA_EXIT || turn_exit == VELOCITY_EXIT) interfered = true;
+    }
+
+    else if (mode == SWING) {
+        exit_output swing_exit = RUNNING;
+        pros::Motor& sensor = current_swing == LEFT_SWING ? left_motors[0] : right_motors[0];
+        while (swing_exit == RUNNING) {
+            swing_exit = swingPID.exit_condition(sensor);
+            pros::delay(util::DELAY_TIME);
+        }
+        if (print_toggle) printf("  Swing: %s Exit, error: %.2f\n", exit_to_string(swing_exit).c_str(), swingPID.error);
+        sim::ProfileExitSet(exit_name(swing_exit));
+        if (swing_exit == mA_EXIT || swing_exit == VELOCITY_EXIT) interfered = true;
+    }
+
+    else if (mode == POINT_TO_POINT || mode == PURE_PURSUIT) {
+        // Pure pursuit only starts checking exits once it's targeting the final point
+        while (mode == PURE_PURSUIT && pp_index < static_cast<int>(pp_movements.size()) - 1)
+            pros::delay(util::DELAY_TIME);
+
+        exit_output xy_exit = RUNNING;
+        exit_output a_exit = RUNNING;
+        while (xy_exit == RUNNING || a_exit == RUNNING) {
+            xy_exit = xy_exit != RUNNING ? xy_exit : xyPID.exit_condition({left_motors[0], right_motors[0]});
+            a_exit = a_exit != RUNNING ? a_exit : current_a_odomPID.exit_condition({left_motors[0], right_motors[0]});
+            pros::delay(util::DELAY_TIME);
+        }
+        if (print_toggle) printf("  XY: %s Exit, error: %.2f.   Angle: %s Exit, error: %.2f\n", exit_to_string(xy_exit).c_str(), xyPID.error,
+                                 exit_to_string(a_exit).c_str(), current_a_odomPID.error);
+        sim::ProfileExitSet(exit_name(xy_exit, a_exit));
+        if (xy_exit == mA_EXIT || xy_exit == VELOCITY_EXIT || a_exit == mA_EXIT || a_exit == VELOCITY_EXIT) interfered = true;
+    }
+}
+
+void Drive::wait_until_drive(double target) {
+    // Targets are relative to where the motion started
+    double l_tar = l_start + target;
+    double r_tar = r_start + target;
+    double l_error = l_tar - drive_sensor_left();
+    double r_error = r_tar - drive_sensor_right();
+    int l_sgn = util::sgn(l_error);
+    int r_sgn = util::sgn(r_error);
+
+    exit_output left_exit = RUNNING;
+    exit_output right_exit = RUNNING;
+    while (true) {
+        l_error = l_tar - drive_sensor_left();
+        r_error = r_tar - drive_sensor_right();
+
+        // Once both sides are past the target, move on
+        if (util::sgn(l_error) != l_sgn && util::sgn(r_error) != r_sgn) {
+            if (print_toggle) printf("  Drive Wait Until Exit Success, triggered at: L,R(%.2f, %.2f).  Target: L,R(%.2f, %.2f)\n", l_tar - l_error,
+                                     r_tar - r_error, l_tar, r_tar);
+            sim::ProfileExitSet("UNTIL");
+            return;
+        }
+
+        // Otherwise stop waiting if the robot can't get there
+        left_exit = left_exit != RUNNING ? left_exit : leftPID.exit_condition(left_motors[0]);
+        right_exit = right_exit != RUNNING ? right_exit : rightPID.exit_condition(right_motors[0]);
+        if (left_exit != RUNNING && right_exit != RUNNING) {
+            if (print_toggle) printf("  Left: %s Wait Until Exit Failed.   Right: %s Wait Until Exit Failed.\n", exit_to_string(left_exit).c_str(),
+                                     exit_to_string(right_exit).c_str());
+            sim::ProfileExitSet(exit_name(left_exit, right_exit));
+            if (left_exit == mA_EXIT || left_exit == VELOCITY_EXIT || right_exit == mA_EXIT || right_exit == VELOCITY_EXIT) interfered = true;
+            return;
+        }
+
+        pros::delay(util::DELAY_TIME);
+    }
+}
+
+void Drive::wait_until_turn_swing(double target) {
+    double g_error = target - drive_imu_get();
+    int g_sgn = util::sgn(g_error);
+
+    exit_output exit = RUNNING;
+    PID& pid = mode == SWING ? swingPID : turnPID;
+    while (true) {
+        g_error = target - drive_imu_get();
+
+        if (util::sgn(g_error) != g_sgn) {
+            if (print_toggle) printf("  Turn/Swing Wait Until Exit Success, triggered at: %.2f.  Target: %.2f\n", target - g_error, target);
+            sim::ProfileExitSet("UNTIL");
+            return;
+        }
+
+        exit = exit != RUNNING ? exit : pid.exit_condition({left_motors[0], right_motors[0]});
+        if (exit != RUNNING) {
+            if (print_toggle) printf("  Turn/Swing: %s Wait Until Exit Failed.\n", exit_to_string(exit).c_str());
+            sim::ProfileExitSet(exit_name(exit));
+            if (exit == mA_EXIT || exit == VELOCITY_EXIT) interfered = true;
+            return;
+        }
+
+        pros::delay(util::DELAY_TIME);
+    }
+}
+
+void Drive::pid_wait_until(double target) {
+    sim::ProfileScope profile(sim::ProfileKind::WAIT, "pid_wait_until(%.1f)", target);
+    if (mode == DRIVE) wait_until_drive(target);
+    else if (mode == TURN || mode == TURN_TO_POINT || mode == SWING) wait_until_turn_swing(flip_angle_target(target));
+    else printf("Not in a valid drive mode!\n");
+}
+
+void Drive::pid_wait_until(okapi::QLength target) {
+    sim::ProfileScope profile(sim::ProfileKind::WAIT, "pid_wait_until(%.1f in)", target.convert(okapi::inch));
+    if (mode == POINT_TO_POINT || mode == PURE_PURSUIT) {
+        // For odom motions, wait until the robot has covered this distance from where it started
+        double distance = target.convert(okapi::inch);
+        while (util::distance_to_point(odom_current, odom_start) < std::fabs(distance) && (mode == POINT_TO_POINT || mode == PURE_PURSUIT))
+            pros::delay(util::DELAY_TIME);
+        return;
+    }
+    pid_wait_until(target.convert(okapi::inch));
+}
+
+void Drive::pid_wait_until(okapi::QAngle target) {
+    sim::ProfileScope profile(sim::ProfileKind::WAIT, "pid_wait_until(%.1f deg)", target.convert(okapi::degree));
+    pid_wait_until(target.convert(okapi::degree));
+}
+
+void Drive::pid_wait_quick() {
+    sim::ProfileScope profile(sim::ProfileKind::WAIT, "pid_wait_quick");
+    if (mode == DRIVE) pid_wait_until(leftPID.target_get() - l_start);
+    else if (mode == TURN || mode == TURN_TO_POINT) pid_wait_until(turnPID.target_get());
+    else if (mode == SWING) pid_wait_until(swingPID.target_get());
+    else pid_wait();
+}
+
+void Drive::pid_wait_quick_chain() {
+    sim::ProfileScope profile(sim::ProfileKind::WAIT, "pid_wait_quick_chain");
+    // Push the target past where the motion should end, then wait until the real target is crossed
+    if (mode == DRIVE) {
+        double chain = used_motion_chain_scale * util::sgn(chain_target_start);
+        leftPID.target_set(leftPID.target_get() + chain);
+        rightPID.target_set(rightPID.target_get() + chain);
+        pid_wait_until(chain_target_start);
+    } else if (mode == TURN || mode == TURN_TO_POINT) {
+        double chain = used_motion_chain_scale * util::sgn(chain_target_start - chain_sensor_start);
+        turnPID.target_set(turnPID.target_get() + chain);
+        wait_until_turn_swing(chain_target_start);
+    } else if (mode == SWING) {
+        double chain = used_motion_chain_scale * util::sgn(chain_target_start - chain_sensor_start);
+        swingPID.target_set(swingPID.target_get() + chain);
+        wait_until_turn_swing(chain_target_start);
+    } else {
+        pid_wait();
+    }
+}
+
+void Drive::pid_wait_until_index(int index) {
+    sim::ProfileScope profile(sim::ProfileKind::WAIT, "pid_wait_until_index(%d)", index);
+    if (mode != PURE_PURSUIT) {
+        pid_wait();
+        return;
+    }
+    int target = index < static_cast<int>(injected_pp_index.size()) ? injected_pp_index[index] : static_cast<int>(pp_movements.size()) - 1;
+    while (mode == PURE_PURSUIT && pp_index < target)
+        pros::delay(util::DELAY_TIME);
+}
+
+void Drive::pid_wait_until_index_started(int index) {
+    sim::ProfileScope profile(sim::ProfileKind::WAIT, "pid_wait_until_index_started(%d)", index);
+    if (mode != PURE_PURSUIT) return;
+    int target = index < static_cast<int>(injected_pp_index.size()) ? injected_pp_index[index] : static_cast<int>(pp_movements.size()) - 1;
+    while (mode == PURE_PURSUIT && pp_index < target - 1)
+        pros::delay(util::DELAY_TIME);
+}
+
+void Drive::pid_wait_until_point(pose target) {
+    sim::ProfileScope profile(sim::ProfileKind::WAIT, "pid_wait_until_point(%.1f, %.1f)", target.x, target.y);
+    pose flipped = flip_pose(target);
+    while (is_past_target(flipped, odom_current) < 0 && mode != DISABLE)
+        pros::delay(util::DELAY_TIME);
+}
+
+void Drive::pid_wait_until_point(united_pose target) { pid_wait_until_point(util::united_pose_to_pose(target)); }
+void Drive::pid_wait_until(pose target) { pid_wait_until_point(target); }
+void Drive::pid_wait_until(united_pose target) { pid_wait_until_point(target); }
@@ -0,0 +1,447 @@
+/**
+ * @file odom.cpp
+ * @brief Host stand-in for ez::Drive odometry and the point to point, boomerang, and pure pursuit motions.
+ */
+
+#include <cmath>
+
+#include "EZ-Template/api.hpp"
+#include "sim/profile.hpp"
+
+using namespace ez;
+
+// Tracking
+void Drive::ez_tracking_task() {
+    if (!odometry_enabled) return;
+
+    double theta = drive_imu_get();
+    double delta_t = util::to_rad(theta - t_last);
+
+    // Vertical motion comes from a tracker when there is one, otherwise the integrated encoders
+    double vert = 0.0, vert_last = 0.0, vert_offset = 0.0;
+    if (odom_tracker_left_enabled) {
+        vert = odom_tracker_left->get();
+        vert_last = l_last;
+        vert_offset = odom_tracker_left->distance_to_center_get();
+        l_last = vert;
+    } else if (odom_tracker_right_enabled) {
+        vert = odom_tracker_right->get();
+        vert_last = r_last;
+        vert_offset = odom_tracker_right->distance_to_center_get();
+        r_last = vert;
+    } else {
+        vert = (drive_sensor_left_raw() + drive_sensor_right_raw()) / 2.0 / drive_tick_per_inch();
+        vert_last = l_last;
+        l_last = vert;
+    }
+
+    double horiz = 0.0, horiz_offset = 0.0;
+    tracking_wheel* horiz_tracker = odom_tracker_back_enabled ? odom_tracker_back : odom_tracker_front_enabled ? odom_tracker_front : nullptr;
+    if (horiz_tracker != nullptr) {
+        horiz = horiz_tracker->get();
+        horiz_offset = horiz_tracker->distance_to_center_get();
+    }
+    double delta_vert = vert - vert_last;
+    double delta_horiz = horiz_tracker != nullptr ? horiz - h_last : 0.0;
+    h_last = horiz;
+
+    // Each tracker reads the center's motion along its axis plus offset * dtheta, so take the arc the center drove
+    double local_y = delta_vert;
+    double local_x = delta_horiz;
+    if (std::fabs(delta_t) > 1e-9) {
+        double chord = 2.0 * std::sin(delta_t / 2.0);
+        local_y = chord * (delta_vert / delta_t - vert_offset);
+        local_x = chord * (delta_horiz / delta_t - horiz_offset);
+    }
+
+    // Forward is (sin, cos) and right is (cos, -sin) with theta clockwise from +y
+    double avg_t = util::to_rad(t_last) + delta_t / 2.0;
+    odom_current.x += local_y * std::sin(avg_t) + local_x * std::cos(avg_t);
+    odom_current.y += local_y * std::cos(avg_t) - local_x * std::sin(avg_t);
+    odom_current.theta = theta;
+    t_last = theta;
+}
+
+void Drive::odom_enable(bool input) { odometry_enabled = input; }
+bool Drive::odom_enabled() { return odometry_enabled; }
+
+void Drive::odom_tracker_left_set(tracking_wheel* input) {
+    odom_tracker_left = input;
+    odom_tracker_left_enabled = input != nullptr;
+    l_last = input != nullptr ? input->get() : 0.0;
+}
+
+void Drive::odom_tracker_right_set(tracking_wheel* input) {
+    odom_tracker_right = input;
+    odom_tracker_right_enabled = input != nullptr;
+    r_last = input != nullptr ? input->get() : 0.0;
+}
+
+void Drive::odom_tracker_front_set(tracking_wheel* input) {
+    odom_tracker_front = input;
+    odom_tracker_front_enabled = input != nullptr;
+    h_last = input != nullptr ? input->get() : 0.0;
+}
+
+void Drive::odom_tracker_back_set(tracking_wheel* input) {
+    odom_tracker_back = input;
+    odom_tracker_back_enabled = input != nullptr;
+    h_last = input != nullptr ? input->get() : 0.0;
+}
+
+// Pose
+void Drive::odom_x_set(double x) { odom_current.x = x; }
+void Drive::odom_y_set(double y) { odom_current.y = y; }
+void Drive::odom_theta_set(double a) { drive_angle_set(a); }
+void Drive::odom_x_set(okapi::QLength p_x) { odom_x_set(p_x.convert(okapi::inch)); }
+void Drive::odom_y_set(okapi::QLength p_y) { odom_y_set(p_y.convert(okapi::inch)); }
+void Drive::odom_theta_set(okapi::QAngle p_a) { odom_theta_set(p_a.convert(okapi::degree)); }
+double Drive::odom_x_get() { return odom_current.x; }
+double Drive::odom_y_get() { return odom_current.y; }
+double Drive::odom_theta_get() { return odom_current.theta; }
+
+void Drive::odom_xy_set(double x, double y) {
+    odom_x_set(x);
+    odom_y_set(y);
+}
+
+void Drive::odom_xy_set(okapi::QLength p_x, okapi::QLength p_y) { odom_xy_set(p_x.convert(okapi::inch), p_y.convert(okapi::inch)); }
+
+void Drive::odom_xyt_set(double x, double y, double t) {
+    odom_xy_set(x, y);
+    odom_theta_set(t);
+}
+
+void Drive::odom_xyt_set(okapi::QLength p_x, okapi::QLength p_y, okapi::QAngle p_t) {
+    odom_xyt_set(p_x.convert(okapi::inch), p_y.convert(okapi::inch), p_t.convert(okapi::degree));
+}
+
+void Drive::odom_pose_set(pose itarget) {
+    if (itarget.theta == ANGLE_NOT_SET) odom_xy_set(itarget.x, itarget.y);
+    else odom_xyt_set(itarget.x, itarget.y, itarget.theta);
+}
+
+void Drive::odom_pose_set(united_pose itarget) { odom_pose_set(util::united_pose_to_pose(itarget)); }
+pose Drive::odom_pose_get() { return odom_current; }
+void Drive::odom_reset() { odom_xyt_set(0.0, 0.0, 0.0); }
+
+void Drive::odom_x_flip(bool flip) { x_flipped = flip; }
+bool Drive::odom_x_direction_get() { return x_flipped; }
+void Drive::odom_y_flip(bool flip) { y_flipped = flip; }
+bool Drive::odom_y_direction_get() { return y_flipped; }
+void Drive::odom_theta_flip(bool flip) { theta_flipped = flip; }
+bool Drive::odom_theta_direction_get() { return theta_flipped; }
+
+pose Drive::flip_pose(pose input) {
+    pose output = input;
+    if (x_flipped) output.x = -output.x;
+    if (y_flipped) output.y = -output.y;
+    if (theta_flipped && output.theta != ANGLE_NOT_SET) output.theta = -output.theta;
+    return output;
+}
+
+// Odom constants
+void Drive::drive_width_set(double input) { global_track_width = std::fabs(input); }
+void Drive::drive_width_set(okapi::QLength p_input) { drive_width_set(p_input.convert(okapi::inch)); }
+double Drive::drive_width_get() { return global_track_width; }
+void Drive::odom_boomerang_dlead_set(double input) { dlead = input; }
+double Drive::odom_boomerang_dlead_get() { return dlead; }
+void Drive::odom_boomerang_distance_set(double distance) { max_boomerang_distance = std::fabs(distance); }
+void Drive::odom_boomerang_distance_set(okapi::QLength p_distance) { odom_boomerang_distance_set(p_distance.convert(okapi::inch)); }
+double Drive::odom_boomerang_distance_get() { return max_boomerang_distance; }
+void Drive::odom_turn_bias_set(double bias) { odom_turn_bias_amount = bias; }
+double Drive::odom_turn_bias_get() { return odom_turn_bias_amount; }
+bool Drive::odom_turn_bias_enabled() { return is_odom_turn_bias_enabled; }
+void Drive::odom_turn_bias_enable(bool set) { is_odom_turn_bias_enabled = set; }
+void Drive::odom_path_spacing_set(double spacing) { SPACING = std::fabs(spacing); }
+void Drive::odom_path_spacing_set(okapi::QLength p_spacing) { odom_path_spacing_set(p_spacing.convert(okapi::inch)); }
+double Drive::odom_path_spacing_get() { return SPACING; }
+void Drive::odom_look_ahead_set(double distance) { LOOK_AHEAD = std::fabs(distance); }
+void Drive::odom_look_ahead_set(okapi::QLength p_distance) { odom_look_ahead_set(p_distance.convert(okapi::inch)); }
+double Drive::odom_look_ahead_get() { return LOOK_AHEAD; }
+
+void Drive::odom_path_smooth_constants_set(double weight_smooth, double weight_data, double tolerance) {
+    odom_smooth_weight_smooth = weight_smooth;
+    odom_smooth_weight_data = weight_data;
+    odom_smooth_tolerance = tolerance;
+}
+
+std::vector<double> Drive::odom_path_smooth_constants_get() { return {odom_smooth_weight_smooth, odom_smooth_weight_data, odom_smooth_tolerance}; }
+
+void Drive::odom_path_print() {
+    for (auto& point : pp_movements)
+        printf("(%.2f, %.2f, %.2f)\n", point.target.x, point.target.y, point.target.theta);
+}
+
+// Paths
+std::vector<odom> Drive::inject_points(std::vector<odom> imovements) {
+    injected_pp_index.clear();
+    std::vector<odom> output;
+    if (imovements.empty()) return output;
+
+    // Start from where the robot is so the first segment gets points too
+    std::vector<odom> input = imovements;
+    input.insert(input.begin(), {odom_current, imovements.front().drive_direction, imovements.front().max_xy_speed});
+
+    for (std::size_t i = 0; i < input.size() - 1; i++) {
+        pose start = input[i].target;
+        pose end = input[i + 1].target;
+        double distance = util::distance_to_point(end, start);
+        int points = std::max(1, static_cast<int>(std::ceil(distance / SPACING)));
+
+        for (int j = 0; j < points; j++) {
+            double t = static_cast<double>(j) / points;
+            odom point = input[i + 1];
+            point.target = {start.x + (end.x - start.x) * t, start.y + (end.y - start.y) * t, ANGLE_NOT_SET};
+            if (j == 0 && i > 0) point = input[i];
+            output.push_back(point);
+        }
+        injected_pp_index.push_back(output.size());
+    }
+    output.push_back(input.back());
+
+    // Indices point at each original target within the injected path
+    for (auto& index : injected_pp_index)
+        index = std::min(index, static_cast<int>(output.size()) - 1);
+    return output;
+}
+
+std::vector<odom> Drive::smooth_path(std::vector<odom> ipath, double weight_smooth, double weight_data, double tolerance) {
+    std::vector<odom> path = ipath;
+    if (path.size() < 3) return path;
+
+    // Gradient descent toward a smooth path while staying near the original, ends stay put
+    double change = tolerance;
+    int iterations = 0;
+    while (change >= tolerance && iterations++ < 1000) {
+        change = 0.0;
+        for (std::size_t i = 1; i < path.size() - 1; i++) {
+            double x = path[i].target.x;
+            double y = path[i].target.y;
+            path[i].target.x += weight_data * (ipath[i].target.x - x) + weight_smooth * (path[i - 1].target.x + path[i + 1].target.x - 2.0 * x);
+            path[i].target.y += weight_data * (ipath[i].target.y - y) + weight_smooth * (path[i - 1].target.y + path[i + 1].target.y - 2.0 * y);
+            change += std::fabs(x - path[i].target.x) + std::fabs(y - path[i].target.y);
+        }
+    }
+    return path;
+}
+
+double Drive::is_past_target(pose target, pose current) {
+    // Positive once the robot has crossed the line through target perpendicular to the approach
+    double dx = target.x - odom_second_to_last.x;
+    double dy = target.y - odom_second_to_last.y;
+    return (current.x - target.x) * dx + (current.y - target.y) * dy;
+}
+
+// Motion entry points
+void Drive::raw_pid_odom_ptp_set(odom imovement, bool slew_on) {
+    sim::ProfileScope profile(sim::ProfileKind::MOTION, "Odom to (%.1f, %.1f) @ %d", imovement.target.x, imovement.target.y, imovement.max_xy_speed);
+    odom_second_to_last = odom_current;
+    odom_start = odom_current;
+    odom_target = flip_pose(imovement.target);
+    odom_target_start = odom_target;
+    current_drive_direction = imovement.drive_direction;
+    current_angle_behavior = imovement.turn_behavior;
+
+    bool is_backwards = current_drive_direction == REV;
+    PID::Constants xy_consts = is_backwards ? backward_drivePID.constants_get() : forward_drivePID.constants_get();
+    PID::Constants a_consts = odom_target.theta != ANGLE_NOT_SET ? boomerangPID.constants_get() : odom_angularPID.constants_get();
+    xyPID.constants_set(xy_consts.kp, xy_consts.ki, xy_consts.kd, xy_consts.start_i);
+    current_a_odomPID.constants_set(a_consts.kp, a_consts.ki, a_consts.kd, a_consts.start_i);
+    used_motion_chain_scale = is_backwards ? drive_backward_motion_chain_scale : drive_forward_motion_chain_scale;
+
+    pid_speed_max_set(imovement.max_xy_speed);
+    current_slew_on = slew_on;
+    slew::Constants slew_consts = is_backwards ? slew_backward.constants_get() : slew_forward.constants_get();
+    slew_left.constants_set(slew_consts.distance_to_travel, slew_consts.min_speed);
+    slew_left.initialize(slew_on, max_speed, util::distance_to_point(odom_target, odom_start), 0.0);
+
+    if (print_toggle) printf("Odom Motion Started... Target: (%.2f, %.2f, %.2f)\n", odom_target.x, odom_target.y, odom_target.theta);
+    drive_mode_set(POINT_TO_POINT);
+}
+
+void Drive::raw_pid_odom_pp_set(std::vector<odom> imovements, bool slew_on) {
+    sim::ProfileScope profile(sim::ProfileKind::MOTION, "Pure pursuit through %zu points", imovements.size());
+    if (imovements.empty()) return;
+
+    pp_movements.clear();
+    for (auto& movement : imovements) {
+        odom flipped = movement;
+        flipped.target = flip_pose(movement.target);
+        pp_movements.push_back(flipped);
+    }
+    pp_index = 0;
+
+    raw_pid_odom_ptp_set(imovements.front(), slew_on);
+    slew_left.initialize(slew_on, max_speed, util::distance_to_point(pp_movements.back().target, odom_start), 0.0);
+    drive_mode_set(PURE_PURSUIT);
+}
+
+void Drive::pid_odom_ptp_set(odom imovement, bool slew_on) {
+    imovement.target.theta = ANGLE_NOT_SET;
+    raw_pid_odom_ptp_set(imovement, slew_on);
+}
+
+void Drive::pid_odom_boomerang_set(odom imovement, bool slew_on) { raw_pid_odom_ptp_set(imovement, slew_on); }
+
+void Drive::pid_odom_set(odom imovement, bool slew_on) {
+    if (imovement.target.theta == ANGLE_NOT_SET) pid_odom_ptp_set(imovement, slew_on);
+    else pid_odom_boomerang_set(imovement, slew_on);
+}
+
+void Drive::pid_odom_set(double target, int speed, bool slew_on) {
+    // Straight odom drives aim at a point along the current heading
+    pose start = odom_current;
+    start.theta = headingPID.target_get();
+    pose end = util::vector_off_point(target, start);
+    end.theta = ANGLE_NOT_SET;
+    pid_odom_ptp_set({end, target < 0 ? REV : FWD, speed}, slew_on);
+}
+
+void Drive::pid_odom_pp_set(std::vector<odom> imovements, bool slew_on) {
+    injected_pp_index.clear();
+    for (std::size_t i = 0; i < imovements.size(); i++)
+        injected_pp_index.push_back(i);
+    raw_pid_odom_pp_set(imovements, slew_on);
+}
+
+void Drive::pid_odom_injected_pp_set(std::vector<odom> imovements, bool slew_on) {
+    std::vector<odom> path = inject_points(imovements);
+    raw_pid_odom_pp_set(path, slew_on);
+}
+
+void Drive::pid_odom_smooth_pp_set(std::vector<odom> imovements, bool slew_on) {
+    std::vector<odom> path = smooth_path(inject_points(imovements), odom_smooth_weight_smooth, odom_smooth_weight_data, odom_smooth_tolerance);
+    raw_pid_odom_pp_set(path, slew_on);
+}
+
+void Drive::pid_odom_set(std::vector<odom> imovements, bool slew_on) {
+    if (imovements.size() == 1) pid_odom_set(imovements.front(), slew_on);
+    else pid_odom_smooth_pp_set(imovements, slew_on);
+}
+
+void Drive::pid_odom_set(double target, int speed) { pid_odom_set(target, speed, target < 0 ? global_backward_drive_slew_enabled : global_forward_drive_slew_enabled); }
+void Drive::pid_odom_set(okapi::QLength p_target, int speed) { pid_odom_set(p_target.convert(okapi::inch), speed); }
+void Drive::pid_odom_set(okapi::QLength p_target, int speed, bool slew_on) { pid_odom_set(p_target.convert(okapi::inch), speed, slew_on); }
+void Drive::pid_odom_set(odom imovement) { pid_odom_set(imovement, imovement.drive_direction == REV ? global_backward_drive_slew_enabled : global_forward_drive_slew_enabled); }
+void Drive::pid_odom_ptp_set(odom imovement) { pid_odom_ptp_set(imovement, imovement.drive_direction == REV ? global_backward_drive_slew_enabled : global_forward_drive_slew_enabled); }
+
+void Drive::pid_odom_boomerang_set(odom imovement) {
+    pid_odom_boomerang_set(imovement, imovement.drive_direction == REV ? global_backward_drive_slew_enabled : global_forward_drive_slew_enabled);
+}
+
+void Drive::pid_odom_set(std::vector<odom> imovements) { pid_odom_set(imovements, false); }
+void Drive::pid_odom_pp_set(std::vector<odom> imovements) { pid_odom_pp_set(imovements, false); }
+void Drive::pid_odom_injected_pp_set(std::vector<odom> imovements) { pid_odom_injected_pp_set(imovements, false); }
+void Drive::pid_odom_smooth_pp_set(std::vector<odom> imovements) { pid_odom_smooth_pp_set(imovements, false); }
+void Drive::pid_odom_set(united_odom p_imovement) { pid_odom_set(util::united_odom_to_odom(p_imovement)); }
+void Drive::pid_odom_set(united_odom p_imovement, bool slew_on) { pid_odom_set(util::united_odom_to_odom(p_imovement), slew_on); }
+void Drive::pid_odom_ptp_set(united_odom p_imovement) { pid_odom_ptp_set(util::united_odom_to_odom(p_imovement)); }
+void Drive::pid_odom_ptp_set(united_odom p_imovement, bool slew_on) { pid_odom_ptp_set(util::united_odom_to_odom(p_imovement), slew_on); }
+void Drive::pid_odom_boomerang_set(united_odom p_imovement) { pid_odom_boomerang_set(util::united_odom_to_odom(p_imovement)); }
+
+void Drive::pid_odom_boomerang_set(united_odom p_imovement, bool slew_on) {
+    pid_odom_boomerang_set(util::united_odom_to_odom(p_imovement), slew_on);
+}
+
+void Drive::pid_odom_set(std::vector<united_odom> p_imovements) { pid_odom_set(util::united_odoms_to_odoms(p_imovements)); }
+void Drive::pid_odom_set(std::vector<united_odom> p_imovements, bool slew_on) { pid_odom_set(util::united_odoms_to_odoms(p_imovements), slew_on); }
+void Drive::pid_odom_pp_set(std::vector<united_odom> p_imovements) { pid_odom_pp_set(util::united_odoms_to_odoms(p_imovements)); }
+
+void Drive::pid_odom_pp_set(std::vector<united_odom> p_imovements, bool slew_on) {
+    pid_odom_pp_set(util::united_odoms_to_odoms(p_imovements), slew_on);
+}
+
+void Drive::pid_odom_injected_pp_set(std::vector<united_odom> p_imovements) { pid_odom_injected_pp_set(util::united_odoms_to_odoms(p_imovements)); }
+
+void Drive::pid_odom_injected_pp_set(std::vector<united_odom> p_imovements, bool slew_on) {
+    pid_odom_injected_pp_set(util::united_odoms_to_odoms(p_imovements), slew_on);
+}
+
+void Drive::pid_odom_smooth_pp_set(std::vector<united_odom> p_imovements) { pid_odom_smooth_pp_set(util::united_odoms_to_odoms(p_imovements)); }
+
+void Drive::pid_odom_smooth_pp_set(std::vector<united_odom> p_imovements, bool slew_on) {
+    pid_odom_smooth_pp_set(util::united_odoms_to_odoms(p_imovements), slew_on);
+}
+
+// Motion tasks
+void Drive::ptp_task() {
+    double distance = util::distance_to_point(odom_target, odom_current);
+    bool is_backwards = current_drive_direction == REV;
+
+    // Aim at the target until close enough that the angle to it swings around, then hold heading
+    if (distance > LOOK_AHEAD / 2.0 || odom_target.theta != ANGLE_NOT_SET) {
+        double angle = odom_target.theta != ANGLE_NOT_SET && distance <= LOOK_AHEAD / 2.0 ? odom_target.theta
+                                                                                          : util::absolute_angle_to_point(odom_target, odom_current);
+        if (is_backwards && !(odom_target.theta != ANGLE_NOT_SET && distance <= LOOK_AHEAD / 2.0)) angle += 180.0;
+        current_a_odomPID.target_set(new_turn_target_compute(angle, drive_imu_get(), current_angle_behavior));
+    }
+
+    // Distance left along the direction the robot is facing, so it slows down when pointed away
+    double heading = util::to_rad(drive_imu_get());
+    double xy_error = (odom_target.x - odom_current.x) * std::sin(heading) + (odom_target.y - odom_current.y) * std::cos(heading);
+    double xy_out = xyPID.compute_error(xy_error, -xy_error);
+    double a_out = current_a_odomPID.compute(drive_imu_get());
+    current_a_odomPID.velocity_sensor_secondary_set(drive_imu_accel_get());
+
+    // Slew the forward speed over the distance travelled since the motion started
+    double slew_out = slew_left.iterate(util::distance_to_point(odom_current, odom_start));
+    xy_out = util::clamp(xy_out, slew_out, -slew_out);
+
+    // Turning gets priority when the outputs saturate
+    if (is_odom_turn_bias_enabled) {
+        double xy_max = std::max(0.0, max_speed - std::fabs(a_out) * odom_turn_bias_amount);
+        xy_out = util::clamp(xy_out, xy_max, -xy_max);
+    }
+
+    double l_out = xy_out + a_out;
+    double r_out = xy_out - a_out;
+    double faster_side = std::max(std::fabs(l_out), std::fabs(r_out));
+    if (faster_side > max_speed) {
+        l_out *= max_speed / faster_side;
+        r_out *= max_speed / faster_side;
+    }
+
+    if (drive_toggle) private_drive_set(l_out, r_out);
+}
+
+void Drive::boomerang_task() {
+    // Chase a carrot point behind the target along its final heading, then finish at the target itself
+    pose target = odom_target;
+    double distance = util::distance_to_point(target, odom_current);
+    double lead = std::min(dlead * distance, max_boomerang_distance);
+    double direction = current_drive_direction == REV ? -1.0 : 1.0;
+    double theta = util::to_rad(target.theta);
+
+    if (distance > LOOK_AHEAD / 2.0) {
+        odom_target = {target.x - std::sin(theta) * lead * direction, target.y - std::cos(theta) * lead * direction, ANGLE_NOT_SET};
+        ptp_task();
+        odom_target = target;
+    } else {
+        ptp_task();
+    }
+}
+
+void Drive::pp_task() {
+    // Move the chased point forward once the robot is within look ahead of it
+    int last = static_cast<int>(pp_movements.size()) - 1;
+    while (pp_index < last && util::distance_to_point(pp_movements[pp_index].target, odom_current) < LOOK_AHEAD)
+        pp_index++;
+
+    odom current_point = pp_movements[pp_index];
+    if (odom_target.x != current_point.target.x || odom_target.y != current_point.target.y) {
+        odom_second_to_last = odom_target;
+        odom_target = current_point.target;
+        current_drive_direction = current_point.drive_direction;
+        if (current_point.max_xy_speed != max_speed) pid_speed_max_set(current_point.max_xy_speed);
+    }
+
+    if (pp_index == last && odom_target.theta != ANGLE_NOT_SET) boomerang_task();
+    else {
+        // Only the final point cares about heading
+        pose target = odom_target;
+        if (pp_index != last) odom_target.theta = ANGLE_NOT_SET;
+        ptp_task();
+        odom_target = target;
+    }
+}
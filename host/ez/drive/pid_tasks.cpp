@@ -0,0 +1,108 @@
+/**
+ * @file pid_tasks.cpp
+ * @brief Host stand-in for ez::Drive's background task and the per-mode PID loops.
+ */
+
+#include <cmath>
+
+#include "EZ-Template/api.hpp"
+
+using namespace ez;
+
+void Drive::ez_auto_task() {
+    while (true) {
+        switch (drive_mode_get()) {
+            case DRIVE: drive_pid_task(); break;
+            case TURN:
+            case TURN_TO_POINT: turn_pid_task(); break;
+            case SWING: swing_pid_task(); break;
+            case POINT_TO_POINT: odom_target.theta != ANGLE_NOT_SET ? boomerang_task() : ptp_task(); break;
+            case PURE_PURSUIT: pp_task(); break;
+            case DISABLE: break;
+        }
+
+        ez_tracking_task();
+
+        // Motions only run during autonomous unless the PID tuner is driving them
+        if (pros::competition::is_autonomous() && !util::AUTON_RAN) util::AUTON_RAN = true;
+        else if (!pros::competition::is_autonomous() && drive_mode_get() != DISABLE && !pid_tuner_enabled()) drive_mode_set(DISABLE, false);
+
+        pros::delay(util::DELAY_TIME);
+    }
+}
+
+void Drive::drive_pid_task() {
+    // Compute PID
+    leftPID.compute(drive_sensor_left());
+    rightPID.compute(drive_sensor_right());
+    headingPID.compute(drive_imu_get());
+
+    // Compute slew
+    double l_slew_out = slew_left.iterate(drive_sensor_left());
+    double r_slew_out = slew_right.iterate(drive_sensor_right());
+
+    // Clip leftPID and rightPID to slew (if slew is disabled, it returns max_speed)
+    double l_drive_out = util::clamp(leftPID.output, l_slew_out, -l_slew_out);
+    double r_drive_out = util::clamp(rightPID.output, r_slew_out, -r_slew_out);
+
+    // Toggle heading
+    double gyro_out = heading_on ? headingPID.output : 0;
+
+    // Combine heading with drive
+    double l_out = l_drive_out + gyro_out;
+    double r_out = r_drive_out - gyro_out;
+
+    // Vector scaling so heading correction survives when the drive output is saturated
+    double faster_side = std::max(std::fabs(l_out), std::fabs(r_out));
+    if (faster_side > max_speed) {
+        l_out = l_out * (max_speed / faster_side);
+        r_out = r_out * (max_speed / faster_side);
+    }
+
+    if (drive_toggle) private_drive_set(l_out, r_out);
+}
+
+void Drive::turn_pid_task() {
+    // Compute PID
+    turnPID.compute(drive_imu_get());
+    turnPID.velocity_sensor_secondary_set(drive_imu_accel_get());
+
+    // Compute slew
+    double slew_out = slew_turn.iterate(drive_imu_get());
+
+    // Clip gyroPID to max speed
+    double gyro_out = util::clamp(turnPID.output, slew_out, -slew_out);
+
+    // Clip the speed of the turn when the robot is within StartI, only do this when target is larger then StartI
+    if (turnPID.constants.ki != 0 && (std::fabs(turnPID.target_get()) > turnPID.constants.start_i && std::fabs(turnPID.error) < turnPID.constants.start_i)) {
+        if (pid_turn_min_get() != 0) gyro_out = util::clamp(gyro_out, pid_turn_min_get(), -pid_turn_min_get());
+    }
+
+    if (drive_toggle) private_drive_set(gyro_out, -gyro_out);
+}
+
+void Drive::swing_pid_task() {
+    // Compute PID
+    swingPID.compute(drive_imu_get());
+    swingPID.velocity_sensor_secondary_set(drive_imu_accel_get());
+
+    // Compute slew, either over the angle turned or the distance the driving side travels
+    double current = current_swing == LEFT_SWING ? drive_sensor_left() : drive_sensor_right();
+    double slew_out = slew_swing.iterate(slew_swing_using_angle ? drive_imu_get() : current);
+
+    // Clip swingPID to max speed
+    double swing_out = util::clamp(swingPID.output, slew_out, -slew_out);
+
+    // Clip the speed of the swing when the robot is within StartI, only do this when target is larger then StartI
+    if (swingPID.constants.ki != 0 && (std::fabs(swingPID.target_get()) > swingPID.constants.start_i && std::fabs(swingPID.error) < swingPID.constants.start_i)) {
+        if (pid_swing_min_get() != 0) swing_out = util::clamp(swing_out, pid_swing_min_get(), -pid_swing_min_get());
+    }
+
+    // The opposite side runs proportionally to the driving side
+    double opposite_out = max_speed == 0 ? 0 : swing_out * (static_cast<double>(swing_opposite_speed) / max_speed);
+
+    if (drive_toggle) {
+        if (current_swing == LEFT_SWING) private_drive_set(swing_out, opposite_out);
+        else private_drive_set(-opposite_out, -swing_out);
+    }
+}
@@ -0,0 +1,581 @@
+/**
+ * @file set_pid.cpp
+ * @brief Host stand-in for ez::Drive constant setters and the pid_drive/turn/swing motion entry points.
+ */
+
+#include <cmath>
+
+#include "EZ-Template/api.hpp"
+#include "sim/profile.hpp"
+
+using namespace ez;
+
+// Constants
+void Drive::pid_drive_constants_set(double p, double i, double d, double p_start_i) {
+    pid_drive_constants_forward_set(p, i, d, p_start_i);
+    pid_drive_constants_backward_set(p, i, d, p_start_i);
+    fwd_rev_drivePID.constants_set(p, i, d, p_start_i);
+}
+
+void Drive::pid_drive_constants_forward_set(double p, double i, double d, double p_start_i) { forward_drivePID.constants_set(p, i, d, p_start_i); }
+void Drive::pid_drive_constants_backward_set(double p, double i, double d, double p_start_i) { backward_drivePID.constants_set(p, i, d, p_start_i); }
+PID::Constants Drive::pid_drive_constants_get() { return fwd_rev_drivePID.constants_get(); }
+PID::Constants Drive::pid_drive_constants_forward_get() { return forward_drivePID.constants_get(); }
+PID::Constants Drive::pid_drive_constants_backward_get() { return backward_drivePID.constants_get(); }
+
+void Drive::pid_heading_constants_set(double p, double i, double d, double p_start_i) { headingPID.constants_set(p, i, d, p_start_i); }
+PID::Constants Drive::pid_heading_constants_get() { return headingPID.constants_get(); }
+
+void Drive::pid_turn_constants_set(double p, double i, double d, double p_start_i) { turnPID.constants_set(p, i, d, p_start_i); }
+PID::Constants Drive::pid_turn_constants_get() { return turnPID.constants_get(); }
+
+void Drive::pid_swing_constants_set(double p, double i, double d, double p_start_i) {
+    pid_swing_constants_forward_set(p, i, d, p_start_i);
+    pid_swing_constants_backward_set(p, i, d, p_start_i);
+    fwd_rev_swingPID.constants_set(p, i, d, p_start_i);
+}
+
+void Drive::pid_swing_constants_forward_set(double p, double i, double d, double p_start_i) { forward_swingPID.constants_set(p, i, d, p_start_i); }
+void Drive::pid_swing_constants_backward_set(double p, double i, double d, double p_start_i) { backward_swingPID.constants_set(p, i, d, p_start_i); }
+PID::Constants Drive::pid_swing_constants_get() { return fwd_rev_swingPID.constants_get(); }
+PID::Constants Drive::pid_swing_constants_forward_get() { return forward_swingPID.constants_get(); }
+PID::Constants Drive::pid_swing_constants_backward_get() { return backward_swingPID.constants_get(); }
+
+void Drive::pid_odom_angular_constants_set(double p, double i, double d, double p_start_i) { odom_angularPID.constants_set(p, i, d, p_start_i); }
+void Drive::pid_odom_boomerang_constants_set(double p, double i, double d, double p_start_i) { boomerangPID.constants_set(p, i, d, p_start_i); }
+
+void Drive::pid_turn_min_set(int min) { turn_min = std::abs(min); }
+void Drive::pid_swing_min_set(int min) { swing_min = std::abs(min); }
+int Drive::pid_turn_min_get() { return turn_min; }
+int Drive::pid_swing_min_get() { return swing_min; }
+
+void Drive::pid_speed_max_set(int speed) {
+    max_speed = std::abs(util::clamp(speed, 127, -127));
+    slew_left.speed_max_set(max_speed);
+    slew_right.speed_max_set(max_speed);
+    slew_turn.speed_max_set(max_speed);
+    slew_swing.speed_max_set(max_speed);
+}
+
+int Drive::pid_speed_max_get() { return max_speed; }
+
+// Exit conditions
+void Drive::pid_drive_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time,
+                                         int p_mA_timeout, bool use_imu) {
+    leftPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout);
+    rightPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout);
+    leftPID.velocity_sensor_secondary_toggle_set(use_imu);
+    rightPID.velocity_sensor_secondary_toggle_set(use_imu);
+}
+
+void Drive::pid_turn_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time,
+                                        int p_mA_timeout, bool use_imu) {
+    turnPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout);
+    turnPID.velocity_sensor_secondary_toggle_set(use_imu);
+}
+
+void Drive::pid_swing_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time,
+                                         int p_mA_timeout, bool use_imu) {
+    swingPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout);
+    swingPID.velocity_sensor_secondary_toggle_set(use_imu);
+}
+
+void Drive::pid_odom_drive_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error,
+                                              int p_velocity_exit_time, int p_mA_timeout, bool use_imu) {
+    xyPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout);
+    xyPID.velocity_sensor_secondary_toggle_set(use_imu);
+}
+
+void Drive::pid_odom_turn_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error,
+                                             int p_velocity_exit_time, int p_mA_timeout, bool use_imu) {
+    current_a_odomPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout);
+    current_a_odomPID.velocity_sensor_secondary_toggle_set(use_imu);
+}
+
+void Drive::pid_drive_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QLength p_small_error, okapi::QTime p_big_exit_time,
+                                         okapi::QLength p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu) {
+    pid_drive_exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::inch), p_big_exit_time.convert(okapi::millisecond),
+                                 p_big_error.convert(okapi::inch), p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond),
+                                 use_imu);
+}
+
+void Drive::pid_turn_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QAngle p_small_error, okapi::QTime p_big_exit_time,
+                                        okapi::QAngle p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu) {
+    pid_turn_exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::degree), p_big_exit_time.convert(okapi::millisecond),
+                                p_big_error.convert(okapi::degree), p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond),
+                                use_imu);
+}
+
+void Drive::pid_swing_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QAngle p_small_error, okapi::QTime p_big_exit_time,
+                                         okapi::QAngle p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu) {
+    pid_swing_exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::degree), p_big_exit_time.convert(okapi::millisecond),
+                                 p_big_error.convert(okapi::degree), p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond),
+                                 use_imu);
+}
+
+void Drive::pid_odom_drive_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QLength p_small_error, okapi::QTime p_big_exit_time,
+                                              okapi::QLength p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu) {
+    pid_odom_drive_exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::inch),
+                                      p_big_exit_time.convert(okapi::millisecond), p_big_error.convert(okapi::inch),
+                                      p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond), use_imu);
+}
+
+void Drive::pid_odom_turn_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QAngle p_small_error, okapi::QTime p_big_exit_time,
+                                             okapi::QAngle p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu) {
+    pid_odom_turn_exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::degree),
+                                     p_big_exit_time.convert(okapi::millisecond), p_big_error.convert(okapi::degree),
+                                     p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond), use_imu);
+}
+
+// Motion chaining
+void Drive::pid_drive_chain_constant_set(double input) {
+    pid_drive_chain_forward_constant_set(input);
+    pid_drive_chain_backward_constant_set(input);
+}
+
+void Drive::pid_drive_chain_forward_constant_set(double input) { drive_forward_motion_chain_scale = std::fabs(input); }
+void Drive::pid_drive_chain_backward_constant_set(double input) { drive_backward_motion_chain_scale = std::fabs(input); }
+double Drive::pid_drive_chain_forward_constant_get() { return drive_forward_motion_chain_scale; }
+double Drive::pid_drive_chain_backward_constant_get() { return drive_backward_motion_chain_scale; }
+void Drive::pid_drive_chain_constant_set(okapi::QLength input) { pid_drive_chain_constant_set(input.convert(okapi::inch)); }
+void Drive::pid_drive_chain_forward_constant_set(okapi::QLength input) { pid_drive_chain_forward_constant_set(input.convert(okapi::inch)); }
+void Drive::pid_drive_chain_backward_constant_set(okapi::QLength input) { pid_drive_chain_backward_constant_set(input.convert(okapi::inch)); }
+
+void Drive::pid_turn_chain_constant_set(double input) { turn_motion_chain_scale = std::fabs(input); }
+double Drive::pid_turn_chain_constant_get() { return turn_motion_chain_scale; }
+void Drive::pid_turn_chain_constant_set(okapi::QAngle input) { pid_turn_chain_constant_set(input.convert(okapi::degree)); }
+
+void Drive::pid_swing_chain_constant_set(double input) {
+    pid_swing_chain_forward_constant_set(input);
+    pid_swing_chain_backward_constant_set(input);
+}
+
+void Drive::pid_swing_chain_forward_constant_set(double input) { swing_forward_motion_chain_scale = std::fabs(input); }
+void Drive::pid_swing_chain_backward_constant_set(double input) { swing_backward_motion_chain_scale = std::fabs(input); }
+double Drive::pid_swing_chain_forward_constant_get() { return swing_forward_motion_chain_scale; }
+double Drive::pid_swing_chain_backward_constant_get() { return swing_backward_motion_chain_scale; }
+void Drive::pid_swing_chain_constant_set(okapi::QAngle input) { pid_swing_chain_constant_set(input.convert(okapi::degree)); }
+void Drive::pid_swing_chain_forward_constant_set(okapi::QAngle input) { pid_swing_chain_forward_constant_set(input.convert(okapi::degree)); }
+void Drive::pid_swing_chain_backward_constant_set(okapi::QAngle input) { pid_swing_chain_backward_constant_set(input.convert(okapi::degree)); }
+
+// Slew
+void Drive::slew_drive_constants_forward_set(okapi::QLength distance, int min_speed) {
+    slew_forward.constants_set(distance.convert(okapi::inch), min_speed);
+}
+
+void Drive::slew_drive_constants_backward_set(okapi::QLength distance, int min_speed) {
+    slew_backward.constants_set(distance.convert(okapi::inch), min_speed);
+}
+
+void Drive::slew_drive_constants_set(okapi::QLength distance, int min_speed) {
+    slew_drive_constants_forward_set(distance, min_speed);
+    slew_drive_constants_backward_set(distance, min_speed);
+}
+
+void Drive::slew_turn_constants_set(okapi::QAngle distance, int min_speed) { slew_turn.constants_set(distance.convert(okapi::degree), min_speed); }
+
+void Drive::slew_swing_constants_forward_set(okapi::QLength distance, int min_speed) {
+    slew_swing_forward.constants_set(distance.convert(okapi::inch), min_speed);
+    slew_swing_fwd_using_angle = false;
+}
+
+void Drive::slew_swing_constants_backward_set(okapi::QLength distance, int min_speed) {
+    slew_swing_backward.constants_set(distance.convert(okapi::inch), min_speed);
+    slew_swing_rev_using_angle = false;
+}
+
+void Drive::slew_swing_constants_set(okapi::QLength distance, int min_speed) {
+    slew_swing_constants_forward_set(distance, min_speed);
+    slew_swing_constants_backward_set(distance, min_speed);
+}
+
+void Drive::slew_swing_constants_forward_set(okapi::QAngle distance, int min_speed) {
+    slew_swing_forward.constants_set(distance.convert(okapi::degree), min_speed);
+    slew_swing_fwd_using_angle = true;
+}
+
+void Drive::slew_swing_constants_backward_set(okapi::QAngle distance, int min_speed) {
+    slew_swing_backward.constants_set(distance.convert(okapi::degree), min_speed);
+    slew_swing_rev_using_angle = true;
+}
+
+void Drive::slew_swing_constants_set(okapi::QAngle distance, int min_speed) {
+    slew_swing_constants_forward_set(distance, min_speed);
+    slew_swing_constants_backward_set(distance, min_speed);
+}
+
+void Drive::slew_drive_set(bool slew_on) {
+    slew_drive_forward_set(slew_on);
+    slew_drive_backward_set(slew_on);
+}
+
+void Drive::slew_drive_forward_set(bool slew_on) { global_forward_drive_slew_enabled = slew_on; }
+bool Drive::slew_drive_forward_get() { return global_forward_drive_slew_enabled; }
+void Drive::slew_drive_backward_set(bool slew_on) { global_backward_drive_slew_enabled = slew_on; }
+bool Drive::slew_drive_backward_get() { return global_backward_drive_slew_enabled; }
+
+void Drive::slew_swing_set(bool slew_on) {
+    slew_swing_forward_set(slew_on);
+    slew_swing_backward_set(slew_on);
+}
+
+void Drive::slew_swing_forward_set(bool slew_on) { global_forward_swing_slew_enabled = slew_on; }
+bool Drive::slew_swing_forward_get() { return global_forward_swing_slew_enabled; }
+void Drive::slew_swing_backward_set(bool slew_on) { global_backward_swing_slew_enabled = slew_on; }
+bool Drive::slew_swing_backward_get() { return global_backward_swing_slew_enabled; }
+void Drive::slew_turn_set(bool slew_on) { global_turn_slew_enabled = slew_on; }
+bool Drive::slew_turn_get() { return global_turn_slew_enabled; }
+void Drive::slew_odom_reenable(bool reenable) { slew_reenables_when_max_speed_changes = reenable; }
+bool Drive::slew_odom_reenabled() { return slew_reenables_when_max_speed_changes; }
+
+// Angle behavior
+void Drive::pid_angle_behavior_set(e_angle_behavior behavior) {
+    pid_turn_behavior_set(behavior);
+    pid_swing_behavior_set(behavior);
+    pid_odom_behavior_set(behavior);
+}
+
+void Drive::pid_turn_behavior_set(e_angle_behavior behavior) { default_turn_type = behavior; }
+void Drive::pid_swing_behavior_set(e_angle_behavior behavior) { default_swing_type = behavior; }
+void Drive::pid_odom_behavior_set(e_angle_behavior behavior) { default_odom_type = behavior; }
+e_angle_behavior Drive::pid_turn_behavior_get() { return default_turn_type; }
+e_angle_behavior Drive::pid_swing_behavior_get() { return default_swing_type; }
+e_angle_behavior Drive::pid_odom_behavior_get() { return default_odom_type; }
+void Drive::pid_angle_behavior_tolerance_set(double tolerance) { turn_tolerance = tolerance; }
+void Drive::pid_angle_behavior_tolerance_set(okapi::QAngle p_tolerance) { pid_angle_behavior_tolerance_set(p_tolerance.convert(okapi::degree)); }
+double Drive::pid_angle_behavior_tolerance_get() { return turn_tolerance; }
+void Drive::pid_angle_behavior_bias_set(e_angle_behavior behavior) { turn_biased_left = behavior == ez::left_turn; }
+e_angle_behavior Drive::pid_angle_behavior_bias_get() { return turn_biased_left ? ez::left_turn : ez::right_turn; }
+
+double Drive::turn_short(double target, double current, bool print) { return util::turn_shortest(target, current, print); }
+double Drive::turn_long(double target, double current, bool print) { return util::turn_longest(target, current, print); }
+
+double Drive::turn_left(double target, double current, bool print) {
+    double new_target = current - std::fmod(std::fmod(current - target, 360.0) + 360.0, 360.0);
+    if (print) printf("Turn left: %.2f -> %.2f\n", target, new_target);
+    return new_target;
+}
+
+double Drive::turn_right(double target, double current, bool print) {
+    double new_target = current + std::fmod(std::fmod(target - current, 360.0) + 360.0, 360.0);
+    if (print) printf("Turn right: %.2f -> %.2f\n", target, new_target);
+    return new_target;
+}
+
+double Drive::turn_is_toleranced(double target, double current, double input, double longest, double shortest) {
+    // Near 180 either way is the same distance, so take the biased side instead of jittering between them
+    double error = std::fabs(util::wrap_angle(target - current));
+    if (std::fabs(error - 180.0) < turn_tolerance)
+        return turn_biased_left ? turn_left(target, current) : turn_right(target, current);
+    return input;
+}
+
+double Drive::new_turn_target_compute(double target, double current, e_angle_behavior behavior) {
+    if (target == ANGLE_NOT_SET) return current;
+
+    double shortest = turn_short(target, current);
+    double longest = turn_long(target, current);
+    switch (behavior) {
+        case ez::raw: return target;
+        case ez::left_turn: return turn_left(target, current);
+        case ez::right_turn: return turn_right(target, current);
+        case ez::shortest: return turn_is_toleranced(target, current, shortest, longest, shortest);
+        case ez::longest: return turn_is_toleranced(target, current, longest, longest, shortest);
+    }
+    return target;
+}
+
+double Drive::flip_angle_target(double target) { return theta_flipped ? -target : target; }
+
+// Drive motions
+void Drive::pid_drive_set(double target, int speed, bool slew_on, bool toggle_heading) {
+    sim::ProfileScope profile(sim::ProfileKind::MOTION, "Drive %.1f in @ %d", target, speed);
+    bool is_backwards = target < 0;
+    if (print_toggle) printf("Drive Started... Target Value: %.2f", target);
+
+    // Heading holds whatever the robot is pointing at when the motion starts
+    heading_on = toggle_heading;
+    l_start = drive_sensor_left();
+    r_start = drive_sensor_right();
+    double l_target = l_start + target;
+    double r_target = r_start + target;
+    if (print_toggle) printf("  (l_start: %.2f  r_start: %.2f)\n", l_start, r_start);
+
+    PID::Constants pid_consts = is_backwards ? backward_drivePID.constants_get() : forward_drivePID.constants_get();
+    slew::Constants slew_consts = is_backwards ? slew_backward.constants_get() : slew_forward.constants_get();
+    used_motion_chain_scale = is_backwards ? drive_backward_motion_chain_scale : drive_forward_motion_chain_scale;
+    leftPID.constants_set(pid_consts.kp, pid_consts.ki, pid_consts.kd, pid_consts.start_i);
+    rightPID.constants_set(pid_consts.kp, pid_consts.ki, pid_consts.kd, pid_consts.start_i);
+    slew_left.constants_set(slew_consts.distance_to_travel, slew_consts.min_speed);
+    slew_right.constants_set(slew_consts.distance_to_travel, slew_consts.min_speed);
+
+    leftPID.target_set(l_target);
+    rightPID.target_set(r_target);
+    pid_speed_max_set(speed);
+    slew_left.initialize(slew_on, max_speed, l_target, drive_sensor_left());
+    slew_right.initialize(slew_on, max_speed, r_target, drive_sensor_right());
+
+    chain_target_start = target;
+    chain_sensor_start = drive_sensor_left();
+    motion_chain_backward = is_backwards;
+
+    drive_mode_set(DRIVE);
+}
+
+void Drive::pid_drive_set(double target, int speed) {
+    bool slew_on = target < 0 ? global_backward_drive_slew_enabled : global_forward_drive_slew_enabled;
+    pid_drive_set(target, speed, slew_on);
+}
+
+void Drive::pid_drive_set(okapi::QLength p_target, int speed, bool slew_on, bool toggle_heading) {
+    pid_drive_set(p_target.convert(okapi::inch), speed, slew_on, toggle_heading);
+}
+
+void Drive::pid_drive_set(okapi::QLength p_target, int speed) { pid_drive_set(p_target.convert(okapi::inch), speed); }
+
+// Turn motions
+void Drive::pid_turn_set(double target, int speed, e_angle_behavior behavior, bool slew_on) {
+    sim::ProfileScope profile(sim::ProfileKind::MOTION, "Turn %.1f deg @ %d", target, speed);
+    double current = drive_imu_get();
+    double new_target = new_turn_target_compute(flip_angle_target(target), current, behavior);
+    if (print_toggle) printf("Turn Started... Target Value: %.2f (%.2f)\n", target, new_target);
+
+    turnPID.target_set(new_target);
+    headingPID.target_set(new_target);
+    pid_speed_max_set(speed);
+    slew_turn.initialize(slew_on, max_speed, new_target, current);
+
+    chain_target_start = new_target;
+    chain_sensor_start = current;
+    used_motion_chain_scale = turn_motion_chain_scale;
+
+    drive_mode_set(TURN);
+}
+
+void Drive::pid_turn_set(double target, int speed) { pid_turn_set(target, speed, default_turn_type, global_turn_slew_enabled); }
+void Drive::pid_turn_set(double target, int speed, e_angle_behavior behavior) { pid_turn_set(target, speed, behavior, global_turn_slew_enabled); }
+void Drive::pid_turn_set(double target, int speed, bool slew_on) { pid_turn_set(target, speed, default_turn_type, slew_on); }
+void Drive::pid_turn_set(okapi::QAngle p_target, int speed) { pid_turn_set(p_target.convert(okapi::degree), speed); }
+
+void Drive::pid_turn_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior) {
+    pid_turn_set(p_target.convert(okapi::degree), speed, behavior);
+}
+
+void Drive::pid_turn_set(okapi::QAngle p_target, int speed, bool slew_on) { pid_turn_set(p_target.convert(okapi::degree), speed, slew_on); }
+
+void Drive::pid_turn_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on) {
+    pid_turn_set(p_target.convert(okapi::degree), speed, behavior, slew_on);
+}
+
+void Drive::pid_turn_relative_set(double target, int speed, e_angle_behavior behavior, bool slew_on) {
+    pid_turn_set(headingPID.target_get() + target, speed, behavior, slew_on);
+}
+
+void Drive::pid_turn_relative_set(double target, int speed) { pid_turn_relative_set(target, speed, ez::raw, global_turn_slew_enabled); }
+void Drive::pid_turn_relative_set(double target, int speed, e_angle_behavior behavior) { pid_turn_relative_set(target, speed, behavior, global_turn_slew_enabled); }
+void Drive::pid_turn_relative_set(double target, int speed, bool slew_on) { pid_turn_relative_set(target, speed, ez::raw, slew_on); }
+void Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed) { pid_turn_relative_set(p_target.convert(okapi::degree), speed); }
+
+void Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior) {
+    pid_turn_relative_set(p_target.convert(okapi::degree), speed, behavior);
+}
+
+void Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed, bool slew_on) {
+    pid_turn_relative_set(p_target.convert(okapi::degree), speed, slew_on);
+}
+
+void Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on) {
+    pid_turn_relative_set(p_target.convert(okapi::degree), speed, behavior, slew_on);
+}
+
+void Drive::pid_turn_set(pose itarget, drive_directions dir, int speed, e_angle_behavior behavior, bool slew_on) {
+    sim::ProfileScope profile(sim::ProfileKind::MOTION, "Turn to (%.1f, %.1f) @ %d", itarget.x, itarget.y, speed);
+    pose target = flip_pose(itarget);
+    double angle = util::absolute_angle_to_point(target, odom_current);
+    if (dir == REV) angle += 180.0;
+    turn_to_point_target = target;
+    pid_turn_set(flip_angle_target(angle), speed, behavior, slew_on);
+    drive_mode_set(TURN_TO_POINT);
+}
+
+void Drive::pid_turn_set(pose itarget, drive_directions dir, int speed) { pid_turn_set(itarget, dir, speed, default_turn_type, global_turn_slew_enabled); }
+
+void Drive::pid_turn_set(pose itarget, drive_directions dir, int speed, bool slew_on) {
+    pid_turn_set(itarget, dir, speed, default_turn_type, slew_on);
+}
+
+void Drive::pid_turn_set(pose itarget, drive_directions dir, int speed, e_angle_behavior behavior) {
+    pid_turn_set(itarget, dir, speed, behavior, global_turn_slew_enabled);
+}
+
+void Drive::pid_turn_set(united_pose p_itarget, drive_directions dir, int speed) { pid_turn_set(util::united_pose_to_pose(p_itarget), dir, speed); }
+
+void Drive::pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, bool slew_on) {
+    pid_turn_set(util::united_pose_to_pose(p_itarget), dir, speed, slew_on);
+}
+
+void Drive::pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, e_angle_behavior behavior) {
+    pid_turn_set(util::united_pose_to_pose(p_itarget), dir, speed, behavior);
+}
+
+void Drive::pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, e_angle_behavior behavior, bool slew_on) {
+    pid_turn_set(util::united_pose_to_pose(p_itarget), dir, speed, behavior, slew_on);
+}
+
+// Swing motions
+bool Drive::is_swing_slew_enabled(e_swing type, double target, double current) {
+    // A left swing turning right drives the left side forward, and the other way around for right swings
+    bool is_forward = type == LEFT_SWING ? target > current : target < current;
+    return is_forward ? global_forward_swing_slew_enabled : global_backward_swing_slew_enabled;
+}
+
+void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on) {
+    sim::ProfileScope profile(sim::ProfileKind::MOTION, "%s swing %.1f deg @ %d", type == LEFT_SWING ? "Left" : "Right", target, speed);
+    double current = drive_imu_get();
+    double new_target = new_turn_target_compute(flip_angle_target(target), current, behavior);
+    if (print_toggle) printf("Swing Started... Target Value: %.2f (%.2f)\n", target, new_target);
+
+    current_swing = type;
+    swing_opposite_speed = opposite_speed;
+
+    bool is_forward = type == LEFT_SWING ? new_target > current : new_target < current;
+    PID::Constants pid_consts = is_forward ? forward_swingPID.constants_get() : backward_swingPID.constants_get();
+    slew::Constants slew_consts = is_forward ? slew_swing_forward.constants_get() : slew_swing_backward.constants_get();
+    slew_swing_using_angle = is_forward ? slew_swing_fwd_using_angle : slew_swing_rev_using_angle;
+    used_motion_chain_scale = is_forward ? swing_forward_motion_chain_scale : swing_backward_motion_chain_scale;
+    swingPID.constants_set(pid_consts.kp, pid_consts.ki, pid_consts.kd, pid_consts.start_i);
+    slew_swing.constants_set(slew_consts.distance_to_travel, slew_consts.min_speed);
+
+    swingPID.target_set(new_target);
+    headingPID.target_set(new_target);
+    pid_speed_max_set(speed);
+
+    // Slew either ramps over the turned angle or over the distance the driving side travels
+    if (slew_swing_using_angle) {
+        slew_swing.initialize(slew_on, max_speed, new_target, current);
+    } else {
+        double side = type == LEFT_SWING ? drive_sensor_left() : drive_sensor_right();
+        double arc = util::to_rad(new_target - current) * (type == LEFT_SWING ? 1 : -1) * drive_width_get() / 2.0;
+        slew_swing.initialize(slew_on, max_speed, side + arc, side);
+    }
+
+    chain_target_start = new_target;
+    chain_sensor_start = current;
+
+    drive_mode_set(SWING);
+}
+
+void Drive::pid_swing_set(e_swing type, double target, int speed) {
+    pid_swing_set(type, target, speed, 0, default_swing_type, is_swing_slew_enabled(type, target, drive_imu_get()));
+}
+
+void Drive::pid_swing_set(e_swing type, double target, int speed, e_angle_behavior behavior) {
+    pid_swing_set(type, target, speed, 0, behavior, is_swing_slew_enabled(type, target, drive_imu_get()));
+}
+
+void Drive::pid_swing_set(e_swing type, double target, int speed, bool slew_on) { pid_swing_set(type, target, speed, 0, default_swing_type, slew_on); }
+
+void Drive::pid_swing_set(e_swing type, double target, int speed, e_angle_behavior behavior, bool slew_on) {
+    pid_swing_set(type, target, speed, 0, behavior, slew_on);
+}
+
+void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed) {
+    pid_swing_set(type, target, speed, opposite_speed, default_swing_type, is_swing_slew_enabled(type, target, drive_imu_get()));
+}
+
+void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior) {
+    pid_swing_set(type, target, speed, opposite_speed, behavior, is_swing_slew_enabled(type, target, drive_imu_get()));
+}
+
+void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed, bool slew_on) {
+    pid_swing_set(type, target, speed, opposite_speed, default_swing_type, slew_on);
+}
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed) { pid_swing_set(type, p_target.convert(okapi::degree), speed); }
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior) {
+    pid_swing_set(type, p_target.convert(okapi::degree), speed, behavior);
+}
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, bool slew_on) {
+    pid_swing_set(type, p_target.convert(okapi::degree), speed, slew_on);
+}
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on) {
+    pid_swing_set(type, p_target.convert(okapi::degree), speed, behavior, slew_on);
+}
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed) {
+    pid_swing_set(type, p_target.convert(okapi::degree), speed, opposite_speed);
+}
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior) {
+    pid_swing_set(type, p_target.convert(okapi::degree), speed, opposite_speed, behavior);
+}
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, bool slew_on) {
+    pid_swing_set(type, p_target.convert(okapi::degree), speed, opposite_speed, slew_on);
+}
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on) {
+    pid_swing_set(type, p_target.convert(okapi::degree), speed, opposite_speed, behavior, slew_on);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on) {
+    pid_swing_set(type, headingPID.target_get() + target, speed, opposite_speed, behavior, slew_on);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed) { pid_swing_relative_set(type, target, speed, 0); }
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed, e_angle_behavior behavior) { pid_swing_relative_set(type, target, speed, 0, behavior); }
+
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed, bool slew_on) {
+    pid_swing_relative_set(type, target, speed, 0, ez::raw, slew_on);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed, e_angle_behavior behavior, bool slew_on) {
+    pid_swing_relative_set(type, target, speed, 0, behavior, slew_on);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed) {
+    pid_swing_relative_set(type, target, speed, opposite_speed, ez::raw);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior) {
+    pid_swing_relative_set(type, target, speed, opposite_speed, behavior, is_swing_slew_enabled(type, target, 0.0));
+}
+
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, bool slew_on) {
+    pid_swing_relative_set(type, target, speed, opposite_speed, ez::raw, slew_on);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed) {
+    pid_swing_relative_set(type, p_target.convert(okapi::degree), speed);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior) {
+    pid_swing_relative_set(type, p_target.convert(okapi::degree), speed, behavior);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, bool slew_on) {
+    pid_swing_relative_set(type, p_target.convert(okapi::degree), speed, slew_on);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on) {
+    pid_swing_relative_set(type, p_target.convert(okapi::degree), speed, behavior, slew_on);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed) {
+    pid_swing_relative_set(type, p_target.convert(okapi::degree), speed, opposite_speed);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior) {
+    pid_swing_relative_set(type, p_target.convert(okapi::degree), speed, opposite_speed, behavior);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, bool slew_on) {
+    pid_swing_relative_set(type, p_target.convert(okapi::degree), speed, opposite_speed, slew_on);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on) {
+    pid_swing_relative_set(type, p_target.convert(okapi::degree), speed, opposite_speed, behavior, slew_on);
+}
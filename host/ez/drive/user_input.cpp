@@ -0,0 +1,217 @@
+/**
+ * @file user_input.cpp
+ * @brief Host stand-in for ez::Drive joystick control, curves, active brake, and the PID tuner toggles.
+ */
+
+#include <cmath>
+
+#include "EZ-Template/api.hpp"
+
+using namespace ez;
+
+// Curves
+void Drive::opcontrol_curve_sd_initialize() {
+    // There's no SD card on the host, the defaults are the saved curve
+}
+
+void Drive::save_l_curve_sd() {}
+void Drive::save_r_curve_sd() {}
+
+void Drive::opcontrol_curve_default_set(double left, double right) {
+    left_curve_scale = left;
+    right_curve_scale = right;
+}
+
+std::vector<double> Drive::opcontrol_curve_default_get() { return {left_curve_scale, right_curve_scale}; }
+
+double Drive::opcontrol_curve_left(double x) {
+    if (left_curve_scale != 0)
+        return (std::pow(2.718, -(left_curve_scale / 10)) + std::pow(2.718, (std::fabs(x) - 127) / 10) * (1 - std::pow(2.718, -(left_curve_scale / 10)))) * x;
+    return x;
+}
+
+double Drive::opcontrol_curve_right(double x) {
+    if (right_curve_scale != 0)
+        return (std::pow(2.718, -(right_curve_scale / 10)) + std::pow(2.718, (std::fabs(x) - 127) / 10) * (1 - std::pow(2.718, -(right_curve_scale / 10)))) * x;
+    return x;
+}
+
+void Drive::opcontrol_curve_buttons_toggle(bool toggle) { disable_controller = toggle; }
+bool Drive::opcontrol_curve_buttons_toggle_get() { return disable_controller; }
+
+void Drive::opcontrol_curve_buttons_left_set(pros::controller_digital_e_t decrease, pros::controller_digital_e_t increase) {
+    l_decrease_ = {.button = decrease};
+    l_increase_ = {.button = increase};
+}
+
+void Drive::opcontrol_curve_buttons_right_set(pros::controller_digital_e_t decrease, pros::controller_digital_e_t increase) {
+    r_decrease_ = {.button = decrease};
+    r_increase_ = {.button = increase};
+}
+
+std::vector<pros::controller_digital_e_t> Drive::opcontrol_curve_buttons_left_get() { return {l_decrease_.button, l_increase_.button}; }
+std::vector<pros::controller_digital_e_t> Drive::opcontrol_curve_buttons_right_get() { return {r_decrease_.button, r_increase_.button}; }
+
+void Drive::l_decrease() { left_curve_scale = std::max(left_curve_scale - 0.1, 0.0); }
+void Drive::l_increase() { left_curve_scale += 0.1; }
+void Drive::r_decrease() { right_curve_scale = std::max(right_curve_scale - 0.1, 0.0); }
+void Drive::r_increase() { right_curve_scale += 0.1; }
+
+void Drive::button_press(button_* input_name, int button, std::function<void()> change_curve, std::function<void()> save) {
+    // Change once on press, then repeat every 100ms after holding for 500ms
+    if (button && !input_name->lock) {
+        change_curve();
+        input_name->lock = true;
+        input_name->release_reset = true;
+    } else if (button && input_name->lock) {
+        input_name->hold_timer += util::DELAY_TIME;
+        if (input_name->hold_timer > 500) {
+            input_name->increase_timer += util::DELAY_TIME;
+            if (input_name->increase_timer > 100) {
+                change_curve();
+                input_name->increase_timer = 0;
+            }
+        }
+    } else if (!button) {
+        input_name->lock = false;
+        input_name->hold_timer = 0;
+        if (input_name->release_reset) {
+            input_name->release_timer += util::DELAY_TIME;
+            if (input_name->release_timer > 250) {
+                save();
+                input_name->release_timer = 0;
+                input_name->release_reset = false;
+            }
+        }
+    }
+}
+
+void Drive::opcontrol_curve_buttons_iterate() {
+    if (!disable_controller) return;
+
+    button_press(&l_increase_, master.get_digital(l_increase_.button), [this] { this->l_increase(); }, [this] { this->save_l_curve_sd(); });
+    button_press(&l_decrease_, master.get_digital(l_decrease_.button), [this] { this->l_decrease(); }, [this] { this->save_l_curve_sd(); });
+    if (!is_tank) {
+        button_press(&r_increase_, master.get_digital(r_increase_.button), [this] { this->r_increase(); }, [this] { this->save_r_curve_sd(); });
+        button_press(&r_decrease_, master.get_digital(r_decrease_.button), [this] { this->r_decrease(); }, [this] { this->save_r_curve_sd(); });
+    }
+}
+
+// Joysticks
+void Drive::opcontrol_joystick_threshold_set(int threshold) { JOYSTICK_THRESHOLD = std::abs(threshold); }
+int Drive::opcontrol_joystick_threshold_get() { return JOYSTICK_THRESHOLD; }
+void Drive::opcontrol_joystick_practicemode_toggle(bool toggle) { practice_mode_is_on = toggle; }
+bool Drive::opcontrol_joystick_practicemode_toggle_get() { return practice_mode_is_on; }
+void Drive::opcontrol_drive_reverse_set(bool toggle) { is_reversed = toggle; }
+bool Drive::opcontrol_drive_reverse_get() { return is_reversed; }
+void Drive::opcontrol_speed_max_set(int speed) { opcontrol_speed_max = std::abs(util::clamp(speed, 127, -127)); }
+int Drive::opcontrol_speed_max_get() { return opcontrol_speed_max; }
+void Drive::opcontrol_arcade_scaling(bool enable) { arcade_vector_scaling = enable; }
+bool Drive::opcontrol_arcade_scaling_enabled() { return arcade_vector_scaling; }
+
+int Drive::clipped_joystick(int joystick) {
+    // Deadzone
+    if (std::abs(joystick) < JOYSTICK_THRESHOLD) return 0;
+    return util::clamp(joystick, opcontrol_speed_max, -opcontrol_speed_max);
+}
+
+// Active brake
+void Drive::opcontrol_drive_activebrake_set(double kp, double ki, double kd, double start_i) {
+    left_activebrakePID.constants_set(kp, ki, kd, start_i);
+    right_activebrakePID.constants_set(kp, ki, kd, start_i);
+}
+
+double Drive::opcontrol_drive_activebrake_get() { return left_activebrakePID.constants_get().kp; }
+PID::Constants Drive::opcontrol_drive_activebrake_constants_get() { return left_activebrakePID.constants_get(); }
+
+void Drive::opcontrol_drive_activebrake_targets_set() {
+    left_activebrakePID.target_set(drive_sensor_left());
+    right_activebrakePID.target_set(drive_sensor_right());
+}
+
+void Drive::opcontrol_drive_sensors_reset() {
+    if (opcontrol_drive_activebrake_get() != 0) opcontrol_drive_activebrake_targets_set();
+}
+
+void Drive::opcontrol_joystick_threshold_iterate(int l_stick, int r_stick) {
+    if (is_reversed) {
+        int temp = -l_stick;
+        l_stick = -r_stick;
+        r_stick = temp;
+    }
+
+    // Drive while the sticks are out of the deadzone, otherwise hold position with the active brake
+    if (std::abs(l_stick) > 0 || std::abs(r_stick) > 0) {
+        private_drive_set(l_stick, r_stick);
+        opcontrol_drive_sensors_reset();
+    } else if (opcontrol_drive_activebrake_get() != 0) {
+        private_drive_set(left_activebrakePID.compute(drive_sensor_left()), right_activebrakePID.compute(drive_sensor_right()));
+    } else {
+        private_drive_set(0, 0);
+    }
+}
+
+void Drive::opcontrol_tank() {
+    is_tank = true;
+    if (pid_tuner_enabled()) return;
+    opcontrol_curve_buttons_iterate();
+
+    int l_stick = opcontrol_curve_left(clipped_joystick(master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y)));
+    int r_stick = opcontrol_curve_left(clipped_joystick(master.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_Y)));
+    opcontrol_joystick_threshold_iterate(l_stick, r_stick);
+}
+
+void Drive::opcontrol_arcade_standard(e_type stick_type) {
+    is_tank = false;
+    if (pid_tuner_enabled()) return;
+    opcontrol_curve_buttons_iterate();
+
+    int fwd_stick, turn_stick;
+    if (stick_type == SPLIT) {
+        fwd_stick = clipped_joystick(master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y));
+        turn_stick = clipped_joystick(master.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_X));
+    } else {
+        fwd_stick = clipped_joystick(master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y));
+        turn_stick = clipped_joystick(master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_X));
+    }
+
+    fwd_stick = opcontrol_curve_left(fwd_stick);
+    turn_stick = opcontrol_curve_right(turn_stick);
+    opcontrol_joystick_threshold_iterate(fwd_stick + turn_stick, fwd_stick - turn_stick);
+}
+
+void Drive::opcontrol_arcade_flipped(e_type stick_type) {
+    is_tank = false;
+    if (pid_tuner_enabled()) return;
+    opcontrol_curve_buttons_iterate();
+
+    int fwd_stick, turn_stick;
+    if (stick_type == SPLIT) {
+        fwd_stick = clipped_joystick(master.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_Y));
+        turn_stick = clipped_joystick(master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_X));
+    } else {
+        fwd_stick = clipped_joystick(master.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_Y));
+        turn_stick = clipped_joystick(master.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_X));
+    }
+
+    fwd_stick = opcontrol_curve_right(fwd_stick);
+    turn_stick = opcontrol_curve_left(turn_stick);
+    opcontrol_joystick_threshold_iterate(fwd_stick + turn_stick, fwd_stick - turn_stick);
+}
+
+// PID tuner
+void Drive::pid_tuner_enable() { pid_tuner_on = true; }
+void Drive::pid_tuner_disable() { pid_tuner_on = false; }
+
+void Drive::pid_tuner_toggle() {
+    if (pid_tuner_on) pid_tuner_disable();
+    else pid_tuner_enable();
+}
+
+bool Drive::pid_tuner_enabled() { return pid_tuner_on; }
+void Drive::pid_tuner_full_enable(bool enable) { is_full_pid_tuner_enabled = enable; }
+bool Drive::pid_tuner_full_enabled() { return is_full_pid_tuner_enabled; }
+
+void Drive::pid_tuner_iterate() {
+    // The brain screen tuner UI isn't simulated, constants are tuned offline on the host instead
+}
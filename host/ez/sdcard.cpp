@@ -0,0 +1,107 @@
+/**
+ * @file sdcard.cpp
+ * @brief Host stand-in for ez::as, the LLEMU auton selector and its blank debug pages.
+ *
+ * The host has no SD card, so the selected page only lives in memory; host tools
+ * pick a routine by setting auton_selector.auton_page_current directly.
+ */
+
+#include "EZ-Template/api.hpp"
+
+namespace ez::as {
+
+AutonSelector auton_selector{};
+
+bool turn_off = false;
+int amount_of_blank_pages = 0;
+
+pros::adi::DigitalIn* limit_switch_left = nullptr;
+pros::adi::DigitalIn* limit_switch_right = nullptr;
+
+namespace {
+
+int PageCount() { return auton_selector.auton_count + amount_of_blank_pages; }
+
+void PagePrint() {
+    if (auton_selector.auton_page_current < auton_selector.auton_count) {
+        auton_selector.selected_auton_print();
+    } else {
+        for (int i = 0; i < 8; i++)
+            pros::lcd::clear_line(i);
+        ez::screen_print("Page " + std::to_string(auton_selector.auton_page_current + 1));
+    }
+}
+
+}  // namespace
+
+void auton_selector_initialize() {
+    if (auton_selector.auton_page_current >= PageCount()) auton_selector.auton_page_current = 0;
+}
+
+void auto_sd_update() {}
+
+void page_up() {
+    if (PageCount() == 0) return;
+    auton_selector.auton_page_current = (auton_selector.auton_page_current + 1) % PageCount();
+    auto_sd_update();
+    PagePrint();
+}
+
+void page_down() {
+    if (PageCount() == 0) return;
+    auton_selector.auton_page_current = (auton_selector.auton_page_current + PageCount() - 1) % PageCount();
+    auto_sd_update();
+    PagePrint();
+}
+
+void initialize() {
+    if (turn_off) return;
+    pros::lcd::initialize();
+    auton_selector_initialize();
+    auton_selector_running = true;
+    PagePrint();
+}
+
+void shutdown() {
+    auton_selector_running = false;
+    for (int i = 0; i < 8; i++)
+        pros::lcd::clear_line(i);
+}
+
+bool enabled() { return auton_selector_running; }
+
+void limitSwitchTask() {
+    while (true) {
+        if (limit_switch_right && limit_switch_right->get_new_press()) page_up();
+        if (limit_switch_left && limit_switch_left->get_new_press()) page_down();
+        pros::delay(50);
+    }
+}
+
+void limit_switch_lcd_initialize(pros::adi::DigitalIn* right_limit, pros::adi::DigitalIn* left_limit) {
+    if (!right_limit && !left_limit) return;
+    limit_switch_right = right_limit;
+    limit_switch_left = left_limit;
+    static pros::Task limit_switch_task(limitSwitchTask, "EZ Limit Switch");
+}
+
+int page_blank_current() {
+    int blank = auton_selector.auton_page_current - auton_selector.auton_count;
+    return blank >= 0 ? blank : -1;
+}
+
+bool page_blank_is_on(int page) {
+    if (page >= amount_of_blank_pages) amount_of_blank_pages = page + 1;
+    return page_blank_current() == page;
+}
+
+void page_blank_remove(int page) {
+    if (page < amount_of_blank_pages) amount_of_blank_pages = page;
+    if (auton_selector.auton_page_current >= PageCount()) auton_selector.auton_page_current = 0;
+}
+
+void page_blank_remove_all() { page_blank_remove(0); }
+
+int page_blank_amount() { return amount_of_blank_pages; }
+
+}  // namespace ez::as
@@ -0,0 +1,58 @@
+/**
+ * @file slew.cpp
+ * @brief Host stand-in for ez::slew: ramps from min_speed to max over distance_to_travel.
+ */
+
+#include "EZ-Template/api.hpp"
+
+namespace ez {
+
+slew::slew() {}
+
+slew::slew(double distance, int minimum_speed) { constants_set(distance, minimum_speed); }
+
+void slew::constants_set(double distance, int minimum_speed) {
+    constants.distance_to_travel = distance;
+    constants.min_speed = minimum_speed;
+}
+
+slew::Constants slew::constants_get() { return constants; }
+
+void slew::initialize(bool enabled, double maximum_speed, double target, double current) {
+    is_enabled = enabled;
+    max_speed = maximum_speed;
+
+    // A line from (current, min_speed) to (current + distance, max_speed)
+    sign = util::sgn(target - current);
+    x_intercept = current + (constants.distance_to_travel * sign);
+    y_intercept = max_speed * sign;
+    slope = ((sign * constants.min_speed) - y_intercept) / (x_intercept - current);
+    if (constants.distance_to_travel == 0 || sign == 0) is_enabled = false;
+}
+
+double slew::iterate(double current) {
+    if (is_enabled) {
+        error = x_intercept - current;
+
+        // Once past the slew distance, run at full speed for the rest of the motion
+        if (util::sgn(error) != sign) {
+            is_enabled = false;
+        } else {
+            last_output = ((slope * error) + y_intercept) * sign;
+            return last_output;
+        }
+    }
+
+    last_output = max_speed;
+    return last_output;
+}
+
+bool slew::enabled() { return is_enabled; }
+
+double slew::output() { return last_output; }
+
+void slew::speed_max_set(double speed) { max_speed = speed; }
+
+double slew::speed_max_get() { return max_speed; }
+
+}  // namespace ez
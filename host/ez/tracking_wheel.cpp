@@ -0,0 +1,76 @@
+/**
+ * @file tracking_wheel.cpp
+ * @brief Host stand-in for ez::tracking_wheel on a rotation sensor or three-wire encoder.
+ */
+
+#include <cmath>
+
+#include "EZ-Template/api.hpp"
+
+namespace ez {
+
+tracking_wheel::tracking_wheel(std::vector<int> ports, double wheel_diameter, double distance_to_center, double ratio)
+    : adi_encoder(std::abs(ports[0]), std::abs(ports[1]), util::reversed_active(ports[0])), smart_encoder(0) {
+    IS_TRACKER = DRIVE_ADI_ENCODER;
+    ENCODER_TICKS_PER_REV = 360.0;
+    wheel_diameter_set(wheel_diameter);
+    distance_to_center_set(distance_to_center);
+    ratio_set(ratio);
+}
+
+tracking_wheel::tracking_wheel(int smart_port, std::vector<int> ports, double wheel_diameter, double distance_to_center, double ratio)
+    : adi_encoder({smart_port, std::abs(ports[0]), std::abs(ports[1])}, util::reversed_active(ports[0])), smart_encoder(0) {
+    IS_TRACKER = DRIVE_ADI_ENCODER;
+    ENCODER_TICKS_PER_REV = 360.0;
+    wheel_diameter_set(wheel_diameter);
+    distance_to_center_set(distance_to_center);
+    ratio_set(ratio);
+}
+
+tracking_wheel::tracking_wheel(int port, double wheel_diameter, double distance_to_center, double ratio)
+    : adi_encoder(0, 0, false), smart_encoder(port) {
+    IS_TRACKER = DRIVE_ROTATION;
+    ENCODER_TICKS_PER_REV = 36000.0;
+    wheel_diameter_set(wheel_diameter);
+    distance_to_center_set(distance_to_center);
+    ratio_set(ratio);
+}
+
+double tracking_wheel::get_raw() {
+    if (IS_TRACKER == DRIVE_ROTATION) return smart_encoder.get_position();
+    return adi_encoder.get_value();
+}
+
+double tracking_wheel::get() { return get_raw() / ticks_per_inch(); }
+
+void tracking_wheel::reset() {
+    if (IS_TRACKER == DRIVE_ROTATION) smart_encoder.reset_position();
+    else adi_encoder.reset();
+}
+
+double tracking_wheel::ticks_per_inch() {
+    WHEEL_TICK_PER_REV = ENCODER_TICKS_PER_REV * RATIO;
+    return WHEEL_TICK_PER_REV / (WHEEL_DIAMETER * M_PI);
+}
+
+void tracking_wheel::distance_to_center_set(double input) { DISTANCE_TO_CENTER = input; }
+
+double tracking_wheel::distance_to_center_get() { return IS_FLIPPED ? -DISTANCE_TO_CENTER : DISTANCE_TO_CENTER; }
+
+void tracking_wheel::distance_to_center_flip_set(bool input) { IS_FLIPPED = input; }
+
+bool tracking_wheel::distance_to_center_flip_get() { return IS_FLIPPED; }
+
+void tracking_wheel::ticks_per_rev_set(double input) { ENCODER_TICKS_PER_REV = input; }
+
+double tracking_wheel::ticks_per_rev_get() { return ENCODER_TICKS_PER_REV; }
+
+void tracking_wheel::ratio_set(double input) { RATIO = input; }
+
+double tracking_wheel::ratio_get() { return RATIO; }
+
+void tracking_wheel::wheel_diameter_set(double input) { WHEEL_DIAMETER = input; }
+
+double tracking_wheel::wheel_diameter_get() { return WHEEL_DIAMETER; }
+
+}  // namespace ez
@@ -0,0 +1,146 @@
+/**
+ * @file util.cpp
+ * @brief Host stand-in for EZ-Template's utility functions and the master controller.
+ *
+ * EZ-Template only ships as a prebuilt ARM archive, so the host build carries its
+ * own implementation of the parts of EZ the robot code links against. Behaviour
+ * follows EZ v3's documented semantics (angles clockwise-positive from +y).
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+
+#include "EZ-Template/api.hpp"
+
+pros::Controller master(pros::E_CONTROLLER_MASTER);
+
+namespace ez {
+
+void ez_template_print() { printf("EZ-Template (host stand-in)\n"); }
+
+void screen_print(std::string text, int line) {
+    // Split on newlines and wrap at 32 characters like the brain screen does
+    std::vector<std::string> lines;
+    std::string current;
+    for (char c : text) {
+        if (c == '\n' || current.size() >= 32) {
+            lines.push_back(current);
+            current.clear();
+            if (c == '\n') continue;
+        }
+        current += c;
+    }
+    lines.push_back(current);
+
+    for (std::size_t i = 0; i < lines.size() && line + static_cast<int>(i) < 8; i++)
+        pros::lcd::set_text(line + i, lines[i]);
+}
+
+std::string exit_to_string(exit_output input) {
+    switch (input) {
+        case RUNNING: return "Running";
+        case SMALL_EXIT: return "Small";
+        case BIG_EXIT: return "Big";
+        case VELOCITY_EXIT: return "Velocity";
+        case mA_EXIT: return "mA";
+        case ERROR_NO_CONSTANTS: return "Error: Exit condition constants not set!";
+    }
+    return "Error: Out of bounds!";
+}
+
+namespace util {
+
+bool AUTON_RAN = true;
+
+int places_after_decimal(double input, int min) {
+    int places = 0;
+    double value = std::fabs(input);
+    while (places < 6 && std::fabs(value - std::round(value)) > 1e-9) {
+        value *= 10;
+        places++;
+    }
+    return std::max(places, min);
+}
+
+std::string to_string_with_precision(double input, int n) {
+    std::ostringstream out;
+    out.precision(n);
+    out << std::fixed << input;
+    return out.str();
+}
+
+int sgn(double input) {
+    if (input > 0) return 1;
+    if (input < 0) return -1;
+    return 0;
+}
+
+bool reversed_active(double input) { return input < 0; }
+
+double clamp(double input, double max, double min) {
+    if (input > max) return max;
+    if (input < min) return min;
+    return input;
+}
+
+double clamp(double input, double max) { return clamp(input, fabs(max), -fabs(max)); }
+
+double to_deg(double input) { return input * (180.0 / M_PI); }
+
+double to_rad(double input) { return input * (M_PI / 180.0); }
+
+double absolute_angle_to_point(pose itarget, pose icurrent) {
+    // atan2(x, y) so 0 is +y and clockwise is positive
+    double angle = to_deg(std::atan2(itarget.x - icurrent.x, itarget.y - icurrent.y));
+    return std::isnan(angle) ? 0.0 : angle;
+}
+
+double distance_to_point(pose itarget, pose icurrent) { return std::hypot(itarget.x - icurrent.x, itarget.y - icurrent.y); }
+
+double wrap_angle(double theta) {
+    while (theta > 180.0) theta -= 360.0;
+    while (theta < -180.0) theta += 360.0;
+    return theta;
+}
+
+pose vector_off_point(double added, pose icurrent) {
+    double angle = to_rad(icurrent.theta);
+    return {icurrent.x + std::sin(angle) * added, icurrent.y + std::cos(angle) * added, icurrent.theta};
+}
+
+double turn_shortest(double target, double current, bool print) {
+    double new_target = current + wrap_angle(target - current);
+    if (print) printf("Turn shortest: %.2f -> %.2f\n", target, new_target);
+    return new_target;
+}
+
+double turn_longest(double target, double current, bool print) {
+    double error = wrap_angle(target - current);
+    error += error >= 0 ? -360.0 : 360.0;
+    double new_target = current + error;
+    if (print) printf("Turn longest: %.2f -> %.2f\n", target, new_target);
+    return new_target;
+}
+
+pose united_pose_to_pose(united_pose input) {
+    pose output;
+    output.x = input.x.convert(okapi::inch);
+    output.y = input.y.convert(okapi::inch);
+    output.theta = input.theta == p_ANGLE_NOT_SET ? ANGLE_NOT_SET : input.theta.convert(okapi::degree);
+    return output;
+}
+
+odom united_odom_to_odom(united_odom input) {
+    return {united_pose_to_pose(input.target), input.drive_direction, input.max_xy_speed, input.turn_behavior};
+}
+
+std::vector<odom> united_odoms_to_odoms(std::vector<united_odom> inputs) {
+    std::vector<odom> output;
+    for (auto& input : inputs)
+        output.push_back(united_odom_to_odom(input));
+    return output;
+}
+
+}  // namespace util
+}  // namespace ez
@@ -0,0 +1,220 @@
+/**
+ * @file harness.cpp
+ * @brief Host harness: boot once, fork per auton run.
+ */
+
+#include "harness/harness.hpp"
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <memory>
+
+#include "main.h"
+#include "relocalizer/relocalizer.hpp"
+#include "sim/scheduler.hpp"
+#include "sim/world.hpp"
+#include "subsystems.hpp"
+
+namespace harness {
+
+namespace {
+
+// Lady Brown's rotation sensor sits on the arm, geared down from the motors
+const int LIFT_SENSOR_PORT = 7;
+const int LIFT_MOTOR_PORT = 8;
+const double LIFT_RATIO = 1.0 / 3.0;      // arm degrees per motor degree, estimated
+const double LIFT_REST = 9000;            // centidegrees the arm rests at, BASE_POSITION in lift.cpp
+
+std::unique_ptr<sim::Chassis> plant;
+std::unique_ptr<sim::Field> field;
+double score = 0;
+
+sim::ChassisConfig ChassisConfigFromRobot() {
+    sim::ChassisConfig config;
+    for (auto& motor : chassis.left_motors) config.leftPorts.push_back(motor.get_port());
+    for (auto& motor : chassis.right_motors) config.rightPorts.push_back(motor.get_port());
+    config.imuPort = chassis.imu.get_port();
+    config.wheelDiameter = 3.25;
+    config.wheelRpm = chassis.drive_rpm_get();
+
+    auto tracker = [&](ez::tracking_wheel* wheel, bool vertical) {
+        if (wheel == nullptr) return;
+        config.trackers.push_back({wheel->smart_encoder.get_port(), wheel->wheel_diameter_get() / wheel->ratio_get(),
+                                   wheel->distance_to_center_get(), vertical});
+    };
+    tracker(chassis.odom_tracker_left, true);
+    tracker(chassis.odom_tracker_right, true);
+    tracker(chassis.odom_tracker_front, false);
+    tracker(chassis.odom_tracker_back, false);
+    return config;
+}
+
+sim::FieldConfig FieldConfigFromRobot() {
+    sim::FieldConfig config;
+    for (int i = 0; i < DISTANCE_MOUNT_COUNT; i++) {
+        const DistanceMount& mount = DISTANCE_MOUNTS[i];
+        config.sensors.push_back({mount.sensor->get_port(), mount.right, mount.forward, mount.facing});
+    }
+    return config;
+}
+
+void LiftStep([[maybe_unused]] double dt) {
+    sim::Port(LIFT_SENSOR_PORT).rotation.position = LIFT_REST + sim::Port(LIFT_MOTOR_PORT).motor.position * 100.0 * LIFT_RATIO;
+}
+
+// Sends stdout to /dev/null until restored, returning the old descriptor
+int Silence() {
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    int null = open("/dev/null", O_WRONLY);
+    dup2(null, STDOUT_FILENO);
+    close(null);
+    return saved;
+}
+
+void Restore(int saved) {
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+}
+
+// A forked run and the pipe its result comes back on
+struct Worker {
+    pid_t pid = -1;
+    int fd = -1;
+};
+
+Worker Spawn(const Options& options) {
+    int fds[2];
+    if (pipe(fds) != 0) return {};
+
+    fflush(stdout);
+    pid_t child = fork();
+    if (child == 0) {
+        close(fds[0]);
+        Result result = RunAutonInProcess(options);
+        fflush(stdout);
+        ssize_t written = write(fds[1], &result, sizeof(result));
+        _exit(written == sizeof(result) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    return {child, fds[0]};
+}
+
+Result Collect(const Worker& worker) {
+    Result result;
+    Result received;
+    if (worker.pid > 0 && read(worker.fd, &received, sizeof(received)) == sizeof(received)) result = received;
+    if (worker.fd >= 0) close(worker.fd);
+    return result;
+}
+
+}  // namespace
+
+void Boot(bool quiet) {
+    int saved = quiet ? Silence() : -1;
+
+    initialize();
+    competition_initialize();
+
+    plant = std::make_unique<sim::Chassis>(ChassisConfigFromRobot());
+    field = std::make_unique<sim::Field>(*plant, FieldConfigFromRobot());
+    sim::PlantAdd(LiftStep);
+
+    if (quiet) Restore(saved);
+}
+
+sim::Chassis& Plant() { return *plant; }
+
+sim::Field& FieldPlant() { return *field; }
+
+void ScoreAdd(double value) { score += value; }
+
+int AutonCount() { return ez::as::auton_selector.Autons.size(); }
+
+const char* AutonName(int page) { return ez::as::auton_selector.Autons[page].Name.c_str(); }
+
+Result RunAutonInProcess(const Options& options) {
+    int saved = options.quiet ? Silence() : -1;
+
+    // A host routine rides on its own selector page so it goes through autonomous() like any auton
+    ez::AutonSelector& selector = ez::as::auton_selector;
+    selector.auton_page_current = options.page;
+    if (options.routine) {
+        selector.autons_add({ez::Auton("Host routine", options.routine)});
+        selector.auton_page_current = selector.auton_count - 1;
+    }
+    score = 0;
+    if (options.setup) options.setup();
+
+    // The field starts autonomous in its own task and kills it when the period ends
+    sim::Competition().connected = true;
+    sim::Competition().autonomous = true;
+    std::uint32_t start = sim::Now();
+    pros::Task auton(autonomous, "autonomous");
+    while (auton.get_state() != pros::E_TASK_STATE_DELETED && sim::Now() - start < options.limitMs)
+        sim::RunUntil(sim::Now() + ez::util::DELAY_TIME);
+
+    Result result;
+    result.finished = auton.get_state() == pros::E_TASK_STATE_DELETED;
+    result.timeMs = sim::Now() - start;
+    if (!result.finished) auton.remove();
+    sim::Competition().autonomous = false;
+
+    result.pose = plant->Pose();
+    result.odomPose = {chassis.odom_x_get(), chassis.odom_y_get(), chassis.odom_theta_get()};
+    result.odomError = std::hypot(result.pose.x - result.odomPose.x, result.pose.y - result.odomPose.y);
+    ez::pose fused = fusedOdom.odom_pose_get();
+    result.fusedPose = {fused.x, fused.y, fused.theta};
+    result.fusedError = std::hypot(result.pose.x - fused.x, result.pose.y - fused.y);
+    result.score = score;
+    if (options.routine) {
+        selector.Autons.pop_back();
+        selector.auton_count--;
+        selector.auton_page_current = options.page;
+    }
+
+    if (options.quiet) Restore(saved);
+    return result;
+}
+
+Result RunAuton(const Options& options) {
+    Worker worker = Spawn(options);
+    if (worker.pid > 0) waitpid(worker.pid, nullptr, 0);
+    return Collect(worker);
+}
+
+std::vector<Result> RunAutons(int count, int jobs, const std::function<Options(int run)>& optionsFor) {
+    std::vector<Result> results(std::max(count, 0));
+    std::map<pid_t, std::pair<int, Worker>> running;
+    int next = 0;
+    while (next < count || !running.empty()) {
+        while (next < count && static_cast<int>(running.size()) < std::max(jobs, 1)) {
+            Worker worker = Spawn(optionsFor(next));
+            if (worker.pid <= 0) {
+                Collect(worker);
+                next++;
+                continue;
+            }
+            running[worker.pid] = {next++, worker};
+        }
+        if (running.empty()) break;
+
+        // Each result fits in the pipe buffer, so it can be read once the worker has exited
+        pid_t done = waitpid(-1, nullptr, 0);
+        auto it = running.find(done);
+        if (it == running.end()) continue;
+        results[it->second.first] = Collect(it->second.second);
+        running.erase(it);
+    }
+    return results;
+}
+
+}  // namespace harness
@@ -0,0 +1,69 @@
+/**
+ * @file harness.hpp
+ * @brief Boots this robot's code on the host and runs autons against the chassis plant.
+ *
+ * Boot() runs initialize() once and attaches the plants for the drive, the lift and
+ * the field walls, configured from the same `chassis`, tracking wheels and distance
+ * sensors the robot code builds.
+ * Every RunAuton() then forks the booted process, so each run starts from the exact
+ * same state without re-running initialize(), and the parent can keep running more.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "sim/chassis.hpp"
+#include "sim/field.hpp"
+
+namespace harness {
+
+/// One auton run.
+struct Options {
+    int page = 0;                   // auton selector page
+    std::uint32_t limitMs = 15000;  // the field kills autonomous after this
+    bool quiet = true;              // drop the robot code's terminal output
+    std::function<void()> setup;    // runs in the child right before autonomous starts
+    std::function<void()> routine;  // runs in place of the page's auton, after autonomous()'s resets
+};
+
+/// What a run did, measured from the plant's true pose.
+struct Result {
+    bool finished = false;          // autonomous returned before the limit
+    std::uint32_t timeMs = 0;       // match time used
+    sim::ChassisPose pose;          // where the robot really ended up
+    sim::ChassisPose odomPose;      // where odometry thinks it ended up
+    double odomError = 0;           // in, distance between the two
+    sim::ChassisPose fusedPose;     // where the pose estimator thinks it ended up
+    double fusedError = 0;          // in, distance from the true pose
+    double score = 0;               // whatever the routine added through ScoreAdd()
+};
+
+/// Runs initialize() and attaches the plants. Call once before RunAuton().
+void Boot(bool quiet = true);
+
+/// The drive plant, for setup callbacks that want to change the robot.
+sim::Chassis& Plant();
+
+/// The field the distance sensors see, for setup callbacks that want to place the robot on it.
+sim::Field& FieldPlant();
+
+/// Runs one auton in a forked copy of the booted robot.
+Result RunAuton(const Options& options);
+
+/// Runs `count` autons with up to `jobs` forked at once, results in run order.
+std::vector<Result> RunAutons(int count, int jobs, const std::function<Options(int run)>& optionsFor);
+
+/// Runs one auton in this process; the robot is left where the auton ended.
+Result RunAutonInProcess(const Options& options);
+
+/// Adds to the running routine's Result::score, for routines that grade themselves.
+void ScoreAdd(double value);
+
+/// Auton selector page count and names.
+int AutonCount();
+const char* AutonName(int page);
+
+}  // namespace harness
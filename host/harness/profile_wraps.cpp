@@ -0,0 +1,70 @@
+/**
+ * @file profile_wraps.cpp
+ * @brief Profiler segments around the subsystem calls autons make.
+ *
+ * The linker redirects every call into these symbols from another file to the
+ * __wrap_ versions below (see WRAPPED in the Makefile), so src/ stays untouched.
+ * Calls a subsystem makes to itself, like IntakeWait stopping the intake, aren't
+ * redirected and count toward the outer call.
+ */
+
+#include "sim/profile.hpp"
+#include "subsystems.hpp"
+
+namespace {
+
+const char* IntakeSpeedName(IntakeSpeed speed) {
+    switch (speed) {
+        case IntakeSpeed::FAST: return "FAST";
+        case IntakeSpeed::MED: return "MED";
+        case IntakeSpeed::SLOW: return "SLOW";
+        case IntakeSpeed::STOP: return "STOP";
+        case IntakeSpeed::REVERSE: return "REVERSE";
+        case IntakeSpeed::UNHOOK: return "UNHOOK";
+        case IntakeSpeed::PULSE: return "PULSE";
+    }
+    return "?";
+}
+
+}  // namespace
+
+extern "C" {
+
+// RunIntake(IntakeSpeed, int)
+void __real__Z9RunIntake11IntakeSpeedi(IntakeSpeed speed, int pulseTime);
+void __wrap__Z9RunIntake11IntakeSpeedi(IntakeSpeed speed, int pulseTime) {
+    sim::ProfileScope profile(sim::ProfileKind::SUBSYSTEM, "RunIntake(%s)", IntakeSpeedName(speed));
+    __real__Z9RunIntake11IntakeSpeedi(speed, pulseTime);
+}
+
+// IntakeWait(AllianceMode, int)
+IntakeExit __real__Z10IntakeWait12AllianceModei(AllianceMode aMode, int maxWaitTimeMs);
+IntakeExit __wrap__Z10IntakeWait12AllianceModei(AllianceMode aMode, int maxWaitTimeMs) {
+    sim::ProfileScope profile(sim::ProfileKind::SUBSYSTEM, "IntakeWait(%d ms)", maxWaitTimeMs);
+    IntakeExit exit = __real__Z10IntakeWait12AllianceModei(aMode, maxWaitTimeMs);
+    sim::ProfileExitSet(exit == IntakeExit::RING_DETECTED ? "RING_DETECTED" : "TIMEOUT");
+    return exit;
+}
+
+// PulseIntakeBlocking(int)
+void __real__Z19PulseIntakeBlockingi(int ms);
+void __wrap__Z19PulseIntakeBlockingi(int ms) {
+    sim::ProfileScope profile(sim::ProfileKind::SUBSYSTEM, "PulseIntakeBlocking(%d)", ms);
+    __real__Z19PulseIntakeBlockingi(ms);
+}
+
+// WaitLadyBrown(int)
+void __real__Z13WaitLadyBrowni(int position);
+void __wrap__Z13WaitLadyBrowni(int position) {
+    sim::ProfileScope profile(sim::ProfileKind::SUBSYSTEM, "WaitLadyBrown(%d)", position);
+    __real__Z13WaitLadyBrowni(position);
+}
+
+// CloseClamp()
+void __real__Z10CloseClampv();
+void __wrap__Z10CloseClampv() {
+    sim::ProfileScope profile(sim::ProfileKind::SUBSYSTEM, "CloseClamp");
+    __real__Z10CloseClampv();
+}
+
+}  // extern "C"
@@ -0,0 +1,24 @@
+/**
+ * @file filter.cpp
+ * @brief Host stand-in for the okapi filters the robot code uses, which ship inside okapilib.
+ */
+
+#include "okapi/api/filter/emaFilter.hpp"
+
+namespace okapi {
+
+Filter::~Filter() = default;
+
+EmaFilter::EmaFilter(double ialpha) : alpha(ialpha) {}
+
+double EmaFilter::filter(double ireading) {
+    output = alpha * ireading + (1.0 - alpha) * lastOutput;
+    lastOutput = output;
+    return output;
+}
+
+double EmaFilter::getOutput() const { return output; }
+
+void EmaFilter::setGains(double ialpha) { alpha = ialpha; }
+
+}  // namespace okapi
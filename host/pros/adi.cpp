@@ -0,0 +1,92 @@
+/**
+ * @file adi.cpp
+ * @brief Host stand-in for the three-wire ports used by the robot (pneumatics, limit switch, encoders).
+ */
+
+#include "pros/adi.hpp"
+#include "sim/world.hpp"
+
+namespace pros {
+namespace adi {
+
+namespace {
+
+// Accepts 1-8, 'a'-'h' and 'A'-'H' like PROS does
+std::uint8_t NormalizePort(std::uint8_t port) {
+    if (port >= 'a' && port <= 'h') return port - 'a' + 1;
+    if (port >= 'A' && port <= 'H') return port - 'A' + 1;
+    return port;
+}
+
+sim::AdiPort& At(std::uint8_t smartPort, std::uint8_t adiPort) { return sim::Adi(smartPort, adiPort); }
+
+}  // namespace
+
+Port::Port(std::uint8_t adi_port, adi_port_config_e_t type) : _smart_port(INTERNAL_ADI_PORT), _adi_port(NormalizePort(adi_port)) {
+    set_config(type);
+}
+
+Port::Port(ext_adi_port_pair_t port_pair, adi_port_config_e_t type)
+    : _smart_port(port_pair.first), _adi_port(NormalizePort(port_pair.second)) {
+    set_config(type);
+}
+
+std::int32_t Port::get_config() const { return At(_smart_port, _adi_port).config; }
+
+std::int32_t Port::get_value() const { return At(_smart_port, _adi_port).value; }
+
+std::int32_t Port::set_config(adi_port_config_e_t type) const {
+    At(_smart_port, _adi_port).config = type;
+    return 1;
+}
+
+std::int32_t Port::set_value(std::int32_t value) const {
+    At(_smart_port, _adi_port).value = value;
+    return 1;
+}
+
+ext_adi_port_tuple_t Port::get_port() const { return {_smart_port, _adi_port, 0}; }
+
+DigitalOut::DigitalOut(std::uint8_t adi_port, bool init_state) : Port(adi_port, E_ADI_DIGITAL_OUT) { set_value(init_state); }
+
+DigitalOut::DigitalOut(ext_adi_port_pair_t port_pair, bool init_state) : Port(port_pair, E_ADI_DIGITAL_OUT) { set_value(init_state); }
+
+DigitalIn::DigitalIn(std::uint8_t adi_port) : Port(adi_port, E_ADI_DIGITAL_IN) {}
+
+DigitalIn::DigitalIn(ext_adi_port_pair_t port_pair) : Port(port_pair, E_ADI_DIGITAL_IN) {}
+
+std::int32_t DigitalIn::get_new_press() const {
+    sim::AdiPort& port = At(_smart_port, _adi_port);
+    bool pressed = port.value != 0;
+    bool rising = pressed && !port.lastPressed;
+    port.lastPressed = pressed;
+    return rising;
+}
+
+Encoder::Encoder(std::uint8_t adi_port_top, std::uint8_t adi_port_bottom, bool reversed)
+    : Port(adi_port_top, E_ADI_LEGACY_ENCODER), _port_pair(INTERNAL_ADI_PORT, NormalizePort(adi_port_top)) {
+    if (reversed) set_config(static_cast<adi_port_config_e_t>(-E_ADI_LEGACY_ENCODER));
+}
+
+Encoder::Encoder(ext_adi_port_tuple_t port_tuple, bool reversed)
+    : Port({std::get<0>(port_tuple), std::get<1>(port_tuple)}, E_ADI_LEGACY_ENCODER),
+      _port_pair(std::get<0>(port_tuple), NormalizePort(std::get<1>(port_tuple))) {
+    if (reversed) set_config(static_cast<adi_port_config_e_t>(-E_ADI_LEGACY_ENCODER));
+}
+
+std::int32_t Encoder::reset() const {
+    sim::AdiPort& port = At(_smart_port, _adi_port);
+    port.offset = port.value;
+    return 1;
+}
+
+std::int32_t Encoder::get_value() const {
+    const sim::AdiPort& port = At(_smart_port, _adi_port);
+    std::int32_t ticks = port.value - port.offset;
+    return port.config < 0 ? -ticks : ticks;
+}
+
+ext_adi_port_tuple_t Encoder::get_port() const { return {_port_pair.first, _port_pair.second, _port_pair.second + 1}; }
+
+}  // namespace adi
+}  // namespace pros
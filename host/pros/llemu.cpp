@@ -0,0 +1,63 @@
+/**
+ * @file llemu.cpp
+ * @brief Host LLEMU: strong definitions of the weak lcd symbols that record each line's text.
+ *
+ * pros/llemu.h defines a weak lcd_print inline, so this file declares the symbols
+ * itself instead of including the header.
+ */
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "sim/world.hpp"
+
+namespace {
+
+bool initialized = false;
+
+bool Write(std::int16_t line, const std::string& text) {
+    if (line < 0 || line > 7) return false;
+    sim::Lcd()[line] = text;
+    return true;
+}
+
+}  // namespace
+
+extern "C" {
+namespace pros {
+namespace c {
+
+bool lcd_print(int16_t line, const char* fmt, ...) {
+    char buffer[128];
+    va_list args;
+    va_start(args, fmt);
+    std::vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+    return Write(line, buffer);
+}
+
+}  // namespace c
+}  // namespace pros
+}
+
+namespace pros {
+namespace lcd {
+
+using lcd_btn_cb_fn_t = void (*)(void);
+
+bool set_text(std::int16_t line, std::string text) { return Write(line, text); }
+
+bool clear_line(std::int16_t line) { return Write(line, ""); }
+
+bool initialize(void) { return initialized = true; }
+
+std::uint8_t read_buttons(void) { return 0; }
+
+void register_btn1_cb(lcd_btn_cb_fn_t cb) {}
+
+bool is_initialized(void) { return initialized; }
+
+}  // namespace lcd
+}  // namespace pros
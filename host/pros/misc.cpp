@@ -0,0 +1,157 @@
+/**
+ * @file misc.cpp
+ * @brief Host stand-in for the controller, competition, battery and SD card APIs.
+ */
+
+#include <cstdarg>
+#include <cstdio>
+
+#include "pros/error.h"
+#include "pros/misc.hpp"
+#include "sim/world.hpp"
+
+namespace pros {
+namespace c {
+
+namespace {
+
+sim::ControllerState& ControllerAt(controller_id_e_t id) { return sim::Controller(id); }
+
+void WriteLine(controller_id_e_t id, std::uint8_t line, std::uint8_t col, const char* text) {
+    if (line > 2) return;
+    std::string& out = ControllerAt(id).lines[line];
+    if (out.size() < col) out.resize(col, ' ');
+    out.replace(col, std::string::npos, text);
+}
+
+}  // namespace
+
+std::uint8_t competition_get_status(void) {
+    const sim::CompetitionState& competition = sim::Competition();
+    return (competition.disabled ? COMPETITION_DISABLED : 0) | (competition.autonomous ? COMPETITION_AUTONOMOUS : 0) |
+           (competition.connected ? COMPETITION_CONNECTED : 0);
+}
+
+std::uint8_t competition_is_disabled(void) { return sim::Competition().disabled; }
+
+std::uint8_t competition_is_connected(void) { return sim::Competition().connected; }
+
+std::uint8_t competition_is_autonomous(void) { return sim::Competition().autonomous; }
+
+std::uint8_t competition_is_field(void) { return 0; }
+
+std::uint8_t competition_is_switch(void) { return sim::Competition().connected; }
+
+std::int32_t controller_is_connected(controller_id_e_t id) { return ControllerAt(id).connected; }
+
+std::int32_t controller_get_analog(controller_id_e_t id, controller_analog_e_t channel) { return ControllerAt(id).analog[channel]; }
+
+std::int32_t controller_get_battery_capacity(controller_id_e_t id) { return 100; }
+
+std::int32_t controller_get_battery_level(controller_id_e_t id) { return 100; }
+
+std::int32_t controller_get_digital(controller_id_e_t id, controller_digital_e_t button) { return ControllerAt(id).digital[button]; }
+
+std::int32_t controller_get_digital_new_press(controller_id_e_t id, controller_digital_e_t button) {
+    sim::ControllerState& controller = ControllerAt(id);
+    bool pressed = controller.digital[button];
+    bool rising = pressed && !controller.lastRead[button];
+    controller.lastRead[button] = pressed;
+    return rising;
+}
+
+std::int32_t controller_print(controller_id_e_t id, std::uint8_t line, std::uint8_t col, const char* fmt, ...) {
+    char buffer[64];
+    va_list args;
+    va_start(args, fmt);
+    std::vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+    WriteLine(id, line, col, buffer);
+    return 1;
+}
+
+std::int32_t controller_set_text(controller_id_e_t id, std::uint8_t line, std::uint8_t col, const char* str) {
+    WriteLine(id, line, col, str);
+    return 1;
+}
+
+std::int32_t controller_clear_line(controller_id_e_t id, std::uint8_t line) {
+    if (line <= 2) ControllerAt(id).lines[line].clear();
+    return 1;
+}
+
+std::int32_t controller_clear(controller_id_e_t id) {
+    for (auto& line : ControllerAt(id).lines)
+        line.clear();
+    return 1;
+}
+
+std::int32_t controller_rumble(controller_id_e_t id, const char* rumble_pattern) {
+    ControllerAt(id).lastRumble = rumble_pattern;
+    return 1;
+}
+
+std::int32_t battery_get_voltage(void) { return sim::Battery().voltage; }
+
+std::int32_t battery_get_current(void) { return 0; }
+
+double battery_get_temperature(void) { return 30; }
+
+double battery_get_capacity(void) { return sim::Battery().capacity; }
+
+std::int32_t usd_is_installed(void) { return 0; }
+
+std::int32_t usd_list_files(const char* path, char* buffer, std::int32_t len) { return PROS_ERR; }
+
+}  // namespace c
+
+inline namespace v5 {
+
+Controller::Controller(controller_id_e_t id) : _id(id) {}
+
+std::int32_t Controller::is_connected(void) { return c::controller_is_connected(_id); }
+
+std::int32_t Controller::get_analog(controller_analog_e_t channel) { return c::controller_get_analog(_id, channel); }
+
+std::int32_t Controller::get_battery_capacity(void) { return c::controller_get_battery_capacity(_id); }
+
+std::int32_t Controller::get_battery_level(void) { return c::controller_get_battery_level(_id); }
+
+std::int32_t Controller::get_digital(controller_digital_e_t button) { return c::controller_get_digital(_id, button); }
+
+std::int32_t Controller::get_digital_new_press(controller_digital_e_t button) { return c::controller_get_digital_new_press(_id, button); }
+
+std::int32_t Controller::set_text(std::uint8_t line, std::uint8_t col, const char* str) { return c::controller_set_text(_id, line, col, str); }
+
+std::int32_t Controller::set_text(std::uint8_t line, std::uint8_t col, const std::string& str) { return set_text(line, col, str.c_str()); }
+
+std::int32_t Controller::clear_line(std::uint8_t line) { return c::controller_clear_line(_id, line); }
+
+std::int32_t Controller::rumble(const char* rumble_pattern) { return c::controller_rumble(_id, rumble_pattern); }
+
+std::int32_t Controller::clear(void) { return c::controller_clear(_id); }
+
+}  // namespace v5
+
+namespace battery {
+double get_capacity(void) { return c::battery_get_capacity(); }
+int32_t get_current(void) { return c::battery_get_current(); }
+double get_temperature(void) { return c::battery_get_temperature(); }
+int32_t get_voltage(void) { return c::battery_get_voltage(); }
+}  // namespace battery
+
+namespace competition {
+std::uint8_t get_status(void) { return c::competition_get_status(); }
+std::uint8_t is_autonomous(void) { return c::competition_is_autonomous(); }
+std::uint8_t is_connected(void) { return c::competition_is_connected(); }
+std::uint8_t is_disabled(void) { return c::competition_is_disabled(); }
+std::uint8_t is_field_control(void) { return c::competition_is_field(); }
+std::uint8_t is_competition_switch(void) { return c::competition_is_switch(); }
+}  // namespace competition
+
+namespace usd {
+std::int32_t is_installed(void) { return c::usd_is_installed(); }
+std::int32_t list_files(const char* path, char* buffer, std::int32_t len) { return c::usd_list_files(path, buffer, len); }
+}  // namespace usd
+
+}  // namespace pros
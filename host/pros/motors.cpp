@@ -0,0 +1,437 @@
+/**
+ * @file motors.cpp
+ * @brief Host stand-in for pros::Motor and pros::MotorGroup backed by sim::MotorState.
+ *
+ * Mirrors PROS 4 semantics: a negative port reverses every command and reading,
+ * positions are reported in the motor's encoder units and velocities in RPM of
+ * the installed cartridge.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+
+#include "pros/error.h"
+#include "pros/motor_group.hpp"
+#include "pros/motors.hpp"
+#include "sim/world.hpp"
+
+namespace pros {
+inline namespace v5 {
+
+namespace {
+
+sim::MotorState& State(std::int8_t port) { return sim::Port(port).motor; }
+
+double Sign(std::int8_t port) { return port < 0 ? -1.0 : 1.0; }
+
+// Degrees per one encoder unit for the motor's current settings
+double DegreesPerUnit(const sim::MotorState& motor) {
+    switch (motor.units) {
+        case 1: return 360.0;                         // rotations
+        case 2: return 360.0 / motor.countsPerRev;    // counts
+        default: return 1.0;                          // degrees
+    }
+}
+
+void ApplyGearing(sim::MotorState& motor, int gearset) {
+    motor.gearset = gearset;
+    switch (gearset) {
+        case 0: motor.freeSpeed = 100; motor.countsPerRev = 1800; break;
+        case 2: motor.freeSpeed = 600; motor.countsPerRev = 300; break;
+        default: motor.freeSpeed = 200; motor.countsPerRev = 900; break;
+    }
+}
+
+std::int32_t Voltage(std::int8_t port, std::int32_t voltage) {
+    sim::MotorState& motor = State(port);
+    motor.mode = sim::MotorMode::VOLTAGE;
+    motor.voltage = Sign(port) * std::clamp(voltage, -12000, 12000);
+    return 1;
+}
+
+std::int32_t Velocity(std::int8_t port, std::int32_t velocity) {
+    sim::MotorState& motor = State(port);
+    motor.mode = sim::MotorMode::VELOCITY;
+    motor.targetVelocity = Sign(port) * std::clamp<double>(velocity, -motor.freeSpeed, motor.freeSpeed);
+    return 1;
+}
+
+std::int32_t Absolute(std::int8_t port, double position, std::int32_t velocity) {
+    sim::MotorState& motor = State(port);
+    motor.mode = sim::MotorMode::ABSOLUTE;
+    motor.targetPosition = Sign(port) * position * DegreesPerUnit(motor) + motor.zero;
+    motor.targetVelocity = std::clamp<double>(std::abs(velocity), 0, motor.freeSpeed);
+    return 1;
+}
+
+double Position(std::int8_t port) {
+    const sim::MotorState& motor = State(port);
+    return Sign(port) * (motor.position - motor.zero) / DegreesPerUnit(motor);
+}
+
+double TargetPosition(std::int8_t port) {
+    const sim::MotorState& motor = State(port);
+    return Sign(port) * (motor.targetPosition - motor.zero) / DegreesPerUnit(motor);
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------------
+// Motor
+// ----------------------------------------------------------------------------
+
+Motor::Motor(const std::int8_t port, const MotorGears gearset, const MotorUnits encoder_units)
+    : Device(std::abs(port), DeviceType::motor), _port(port) {
+    if (gearset != MotorGears::invalid) set_gearing(gearset);
+    if (encoder_units != MotorUnits::invalid) set_encoder_units(encoder_units);
+}
+
+std::int32_t Motor::move(std::int32_t voltage) const { return Voltage(_port, voltage * 12000 / 127); }
+
+std::int32_t Motor::move_absolute(const double position, const std::int32_t velocity) const { return Absolute(_port, position, velocity); }
+
+std::int32_t Motor::move_relative(const double position, const std::int32_t velocity) const {
+    return Absolute(_port, TargetPosition(_port) + position, velocity);
+}
+
+std::int32_t Motor::move_velocity(const std::int32_t velocity) const { return Velocity(_port, velocity); }
+
+std::int32_t Motor::move_voltage(const std::int32_t voltage) const { return Voltage(_port, voltage); }
+
+std::int32_t Motor::brake(void) const { return Velocity(_port, 0); }
+
+std::int32_t Motor::modify_profiled_velocity(const std::int32_t velocity) const {
+    sim::MotorState& motor = State(_port);
+    if (motor.mode == sim::MotorMode::ABSOLUTE) motor.targetVelocity = std::abs(velocity);
+    else Velocity(_port, velocity);
+    return 1;
+}
+
+double Motor::get_target_position(const std::uint8_t index) const { return TargetPosition(_port); }
+
+std::int32_t Motor::get_target_velocity(const std::uint8_t index) const { return Sign(_port) * State(_port).targetVelocity; }
+
+double Motor::get_actual_velocity(const std::uint8_t index) const { return Sign(_port) * State(_port).velocity; }
+
+std::int32_t Motor::get_current_draw(const std::uint8_t index) const { return State(_port).current; }
+
+std::int32_t Motor::get_direction(const std::uint8_t index) const { return get_actual_velocity() < 0 ? -1 : 1; }
+
+double Motor::get_efficiency(const std::uint8_t index) const {
+    const sim::MotorState& motor = State(_port);
+    return 100.0 * std::fabs(motor.velocity) / motor.freeSpeed;
+}
+
+std::uint32_t Motor::get_faults(const std::uint8_t index) const { return 0; }
+
+std::uint32_t Motor::get_flags(const std::uint8_t index) const { return 0; }
+
+double Motor::get_position(const std::uint8_t index) const { return Position(_port); }
+
+double Motor::get_power(const std::uint8_t index) const { return get_voltage() / 1000.0 * get_current_draw() / 1000.0; }
+
+std::int32_t Motor::get_raw_position(std::uint32_t* const timestamp, const std::uint8_t index) const {
+    if (timestamp) *timestamp = pros::c::millis();
+    const sim::MotorState& motor = State(_port);
+    return Sign(_port) * motor.position / 360.0 * motor.countsPerRev;
+}
+
+double Motor::get_temperature(const std::uint8_t index) const { return 30; }
+
+double Motor::get_torque(const std::uint8_t index) const { return 2.1 * get_current_draw() / 2500.0; }
+
+std::int32_t Motor::get_voltage(const std::uint8_t index) const { return Sign(_port) * sim::MotorDrive(State(_port)) * 12000; }
+
+std::int32_t Motor::is_over_current(const std::uint8_t index) const {
+    const sim::MotorState& motor = State(_port);
+    return motor.current >= motor.currentLimit;
+}
+
+std::int32_t Motor::is_over_temp(const std::uint8_t index) const { return 0; }
+
+MotorBrake Motor::get_brake_mode(const std::uint8_t index) const { return static_cast<MotorBrake>(State(_port).brake); }
+
+std::int32_t Motor::get_current_limit(const std::uint8_t index) const { return State(_port).currentLimit; }
+
+MotorUnits Motor::get_encoder_units(const std::uint8_t index) const { return static_cast<MotorUnits>(State(_port).units); }
+
+MotorGears Motor::get_gearing(const std::uint8_t index) const { return static_cast<MotorGears>(State(_port).gearset); }
+
+std::int32_t Motor::get_voltage_limit(const std::uint8_t index) const { return State(_port).voltageLimit; }
+
+std::int32_t Motor::is_reversed(const std::uint8_t index) const { return _port < 0; }
+
+std::int32_t Motor::set_brake_mode(const MotorBrake mode, const std::uint8_t index) const {
+    State(_port).brake = static_cast<int>(mode);
+    return 1;
+}
+
+std::int32_t Motor::set_brake_mode(const pros::motor_brake_mode_e_t mode, const std::uint8_t index) const {
+    return set_brake_mode(static_cast<MotorBrake>(mode), index);
+}
+
+std::int32_t Motor::set_current_limit(const std::int32_t limit, const std::uint8_t index) const {
+    State(_port).currentLimit = std::clamp(limit, 0, 2500);
+    return 1;
+}
+
+std::int32_t Motor::set_encoder_units(const MotorUnits units, const std::uint8_t index) const {
+    State(_port).units = static_cast<int>(units);
+    return 1;
+}
+
+std::int32_t Motor::set_encoder_units(const pros::motor_encoder_units_e_t units, const std::uint8_t index) const {
+    return set_encoder_units(static_cast<MotorUnits>(units), index);
+}
+
+std::int32_t Motor::set_gearing(const MotorGears gearset, const std::uint8_t index) const {
+    ApplyGearing(State(_port), static_cast<int>(gearset));
+    return 1;
+}
+
+std::int32_t Motor::set_gearing(const pros::motor_gearset_e_t gearset, const std::uint8_t index) const {
+    return set_gearing(static_cast<MotorGears>(gearset), index);
+}
+
+std::int32_t Motor::set_reversed(const bool reverse, const std::uint8_t index) {
+    _port = reverse ? -std::abs(_port) : std::abs(_port);
+    return 1;
+}
+
+std::int32_t Motor::set_voltage_limit(const std::int32_t limit, const std::uint8_t index) const {
+    State(_port).voltageLimit = limit;
+    return 1;
+}
+
+std::int32_t Motor::set_zero_position(const double position, const std::uint8_t index) const {
+    sim::MotorState& motor = State(_port);
+    motor.zero = motor.position - Sign(_port) * position * DegreesPerUnit(motor);
+    return 1;
+}
+
+std::int32_t Motor::tare_position(const std::uint8_t index) const { return set_zero_position(0); }
+
+std::int8_t Motor::size(void) const { return 1; }
+
+std::vector<Motor> Motor::get_all_devices() { return {}; }
+
+std::int8_t Motor::get_port(const std::uint8_t index) const { return _port; }
+
+std::vector<double> Motor::get_target_position_all(void) const { return {get_target_position()}; }
+std::vector<std::int32_t> Motor::get_target_velocity_all(void) const { return {get_target_velocity()}; }
+std::vector<double> Motor::get_actual_velocity_all(void) const { return {get_actual_velocity()}; }
+std::vector<std::int32_t> Motor::get_current_draw_all(void) const { return {get_current_draw()}; }
+std::vector<std::int32_t> Motor::get_direction_all(void) const { return {get_direction()}; }
+std::vector<double> Motor::get_efficiency_all(void) const { return {get_efficiency()}; }
+std::vector<std::uint32_t> Motor::get_faults_all(void) const { return {get_faults()}; }
+std::vector<std::uint32_t> Motor::get_flags_all(void) const { return {get_flags()}; }
+std::vector<double> Motor::get_position_all(void) const { return {get_position()}; }
+std::vector<double> Motor::get_power_all(void) const { return {get_power()}; }
+std::vector<std::int32_t> Motor::get_raw_position_all(std::uint32_t* const timestamp) const { return {get_raw_position(timestamp)}; }
+std::vector<double> Motor::get_temperature_all(void) const { return {get_temperature()}; }
+std::vector<double> Motor::get_torque_all(void) const { return {get_torque()}; }
+std::vector<std::int32_t> Motor::get_voltage_all(void) const { return {get_voltage()}; }
+std::vector<std::int32_t> Motor::is_over_current_all(void) const { return {is_over_current()}; }
+std::vector<std::int32_t> Motor::is_over_temp_all(void) const { return {is_over_temp()}; }
+std::vector<MotorBrake> Motor::get_brake_mode_all(void) const { return {get_brake_mode()}; }
+std::vector<std::int32_t> Motor::get_current_limit_all(void) const { return {get_current_limit()}; }
+std::vector<MotorUnits> Motor::get_encoder_units_all(void) const { return {get_encoder_units()}; }
+std::vector<MotorGears> Motor::get_gearing_all(void) const { return {get_gearing()}; }
+std::vector<std::int8_t> Motor::get_port_all(void) const { return {_port}; }
+std::vector<std::int32_t> Motor::get_voltage_limit_all(void) const { return {get_voltage_limit()}; }
+std::vector<std::int32_t> Motor::is_reversed_all(void) const { return {is_reversed()}; }
+std::int32_t Motor::set_brake_mode_all(const MotorBrake mode) const { return set_brake_mode(mode); }
+std::int32_t Motor::set_brake_mode_all(const pros::motor_brake_mode_e_t mode) const { return set_brake_mode(mode); }
+std::int32_t Motor::set_current_limit_all(const std::int32_t limit) const { return set_current_limit(limit); }
+std::int32_t Motor::set_encoder_units_all(const MotorUnits units) const { return set_encoder_units(units); }
+std::int32_t Motor::set_encoder_units_all(const pros::motor_encoder_units_e_t units) const { return set_encoder_units(units); }
+std::int32_t Motor::set_gearing_all(const MotorGears gearset) const { return set_gearing(gearset); }
+std::int32_t Motor::set_gearing_all(const pros::motor_gearset_e_t gearset) const { return set_gearing(gearset); }
+std::int32_t Motor::set_reversed_all(const bool reverse) { return set_reversed(reverse); }
+std::int32_t Motor::set_voltage_limit_all(const std::int32_t limit) const { return set_voltage_limit(limit); }
+std::int32_t Motor::set_zero_position_all(const double position) const { return set_zero_position(position); }
+std::int32_t Motor::tare_position_all(void) const { return tare_position(); }
+
+namespace literals {
+const pros::Motor operator""_mtr(const unsigned long long int m) { return Motor(m); }
+const pros::Motor operator""_rmtr(const unsigned long long int m) { return Motor(-static_cast<std::int8_t>(m)); }
+}  // namespace literals
+
+// ----------------------------------------------------------------------------
+// MotorGroup, every call fans out to the member motors like PROS does
+// ----------------------------------------------------------------------------
+
+namespace {
+
+Motor Member(const std::vector<std::int8_t>& ports, std::uint8_t index) {
+    if (index >= ports.size()) {
+        errno = ENXIO;
+        return Motor(ports.empty() ? 0 : ports[0]);
+    }
+    return Motor(ports[index]);
+}
+
+template <typename F>
+std::int32_t ForEach(const std::vector<std::int8_t>& ports, F&& f) {
+    std::int32_t result = 1;
+    for (std::int8_t port : ports)
+        if (f(Motor(port)) != 1) result = PROS_ERR;
+    return result;
+}
+
+template <typename T, typename F>
+std::vector<T> Collect(const std::vector<std::int8_t>& ports, F&& f) {
+    std::vector<T> out;
+    for (std::int8_t port : ports)
+        out.push_back(f(Motor(port)));
+    return out;
+}
+
+}  // namespace
+
+MotorGroup::MotorGroup(const std::initializer_list<std::int8_t> ports, const MotorGears gearset, const MotorUnits encoder_units)
+    : MotorGroup(std::vector<std::int8_t>(ports), gearset, encoder_units) {}
+
+MotorGroup::MotorGroup(const std::vector<std::int8_t>& ports, const MotorGears gearset, const MotorUnits encoder_units) : _ports(ports) {
+    if (gearset != MotorGears::invalid) set_gearing_all(gearset);
+    if (encoder_units != MotorUnits::invalid) set_encoder_units_all(encoder_units);
+}
+
+MotorGroup::MotorGroup(AbstractMotor& motor_group) : _ports(motor_group.get_port_all()) {}
+
+std::int32_t MotorGroup::move(std::int32_t voltage) const { return ForEach(_ports, [&](Motor m) { return m.move(voltage); }); }
+std::int32_t MotorGroup::move_absolute(const double position, const std::int32_t velocity) const {
+    return ForEach(_ports, [&](Motor m) { return m.move_absolute(position, velocity); });
+}
+std::int32_t MotorGroup::move_relative(const double position, const std::int32_t velocity) const {
+    return ForEach(_ports, [&](Motor m) { return m.move_relative(position, velocity); });
+}
+std::int32_t MotorGroup::move_velocity(const std::int32_t velocity) const { return ForEach(_ports, [&](Motor m) { return m.move_velocity(velocity); }); }
+std::int32_t MotorGroup::move_voltage(const std::int32_t voltage) const { return ForEach(_ports, [&](Motor m) { return m.move_voltage(voltage); }); }
+std::int32_t MotorGroup::brake(void) const { return ForEach(_ports, [&](Motor m) { return m.brake(); }); }
+std::int32_t MotorGroup::modify_profiled_velocity(const std::int32_t velocity) const {
+    return ForEach(_ports, [&](Motor m) { return m.modify_profiled_velocity(velocity); });
+}
+
+double MotorGroup::get_target_position(const std::uint8_t index) const { return Member(_ports, index).get_target_position(); }
+std::int32_t MotorGroup::get_target_velocity(const std::uint8_t index) const { return Member(_ports, index).get_target_velocity(); }
+double MotorGroup::get_actual_velocity(const std::uint8_t index) const { return Member(_ports, index).get_actual_velocity(); }
+std::int32_t MotorGroup::get_current_draw(const std::uint8_t index) const { return Member(_ports, index).get_current_draw(); }
+std::int32_t MotorGroup::get_direction(const std::uint8_t index) const { return Member(_ports, index).get_direction(); }
+double MotorGroup::get_efficiency(const std::uint8_t index) const { return Member(_ports, index).get_efficiency(); }
+std::uint32_t MotorGroup::get_faults(const std::uint8_t index) const { return Member(_ports, index).get_faults(); }
+std::uint32_t MotorGroup::get_flags(const std::uint8_t index) const { return Member(_ports, index).get_flags(); }
+double MotorGroup::get_position(const std::uint8_t index) const { return Member(_ports, index).get_position(); }
+double MotorGroup::get_power(const std::uint8_t index) const { return Member(_ports, index).get_power(); }
+std::int32_t MotorGroup::get_raw_position(std::uint32_t* const timestamp, const std::uint8_t index) const {
+    return Member(_ports, index).get_raw_position(timestamp);
+}
+double MotorGroup::get_temperature(const std::uint8_t index) const { return Member(_ports, index).get_temperature(); }
+double MotorGroup::get_torque(const std::uint8_t index) const { return Member(_ports, index).get_torque(); }
+std::int32_t MotorGroup::get_voltage(const std::uint8_t index) const { return Member(_ports, index).get_voltage(); }
+std::int32_t MotorGroup::is_over_current(const std::uint8_t index) const { return Member(_ports, index).is_over_current(); }
+std::int32_t MotorGroup::is_over_temp(const std::uint8_t index) const { return Member(_ports, index).is_over_temp(); }
+MotorBrake MotorGroup::get_brake_mode(const std::uint8_t index) const { return Member(_ports, index).get_brake_mode(); }
+std::int32_t MotorGroup::get_current_limit(const std::uint8_t index) const { return Member(_ports, index).get_current_limit(); }
+MotorUnits MotorGroup::get_encoder_units(const std::uint8_t index) const { return Member(_ports, index).get_encoder_units(); }
+MotorGears MotorGroup::get_gearing(const std::uint8_t index) const { return Member(_ports, index).get_gearing(); }
+std::int32_t MotorGroup::get_voltage_limit(const std::uint8_t index) const { return Member(_ports, index).get_voltage_limit(); }
+std::int32_t MotorGroup::is_reversed(const std::uint8_t index) const { return Member(_ports, index).is_reversed(); }
+
+std::int32_t MotorGroup::set_brake_mode(const MotorBrake mode, const std::uint8_t index) const { return Member(_ports, index).set_brake_mode(mode); }
+std::int32_t MotorGroup::set_brake_mode(const pros::motor_brake_mode_e_t mode, const std::uint8_t index) const {
+    return Member(_ports, index).set_brake_mode(mode);
+}
+std::int32_t MotorGroup::set_current_limit(const std::int32_t limit, const std::uint8_t index) const {
+    return Member(_ports, index).set_current_limit(limit);
+}
+std::int32_t MotorGroup::set_encoder_units(const MotorUnits units, const std::uint8_t index) const {
+    return Member(_ports, index).set_encoder_units(units);
+}
+std::int32_t MotorGroup::set_encoder_units(const pros::motor_encoder_units_e_t units, const std::uint8_t index) const {
+    return Member(_ports, index).set_encoder_units(units);
+}
+std::int32_t MotorGroup::set_gearing(std::vector<pros::motor_gearset_e_t> gearsets) const {
+    for (std::size_t i = 0; i < gearsets.size() && i < _ports.size(); i++)
+        Motor(_ports[i]).set_gearing(gearsets[i]);
+    return 1;
+}
+std::int32_t MotorGroup::set_gearing(const pros::motor_gearset_e_t gearset, const std::uint8_t index) const {
+    return Member(_ports, index).set_gearing(gearset);
+}
+std::int32_t MotorGroup::set_gearing(std::vector<MotorGears> gearsets) const {
+    for (std::size_t i = 0; i < gearsets.size() && i < _ports.size(); i++)
+        Motor(_ports[i]).set_gearing(gearsets[i]);
+    return 1;
+}
+std::int32_t MotorGroup::set_gearing(const MotorGears gearset, const std::uint8_t index) const { return Member(_ports, index).set_gearing(gearset); }
+std::int32_t MotorGroup::set_reversed(const bool reverse, const std::uint8_t index) {
+    if (index >= _ports.size()) return PROS_ERR;
+    _ports[index] = reverse ? -std::abs(_ports[index]) : std::abs(_ports[index]);
+    return 1;
+}
+std::int32_t MotorGroup::set_voltage_limit(const std::int32_t limit, const std::uint8_t index) const {
+    return Member(_ports, index).set_voltage_limit(limit);
+}
+std::int32_t MotorGroup::set_zero_position(const double position, const std::uint8_t index) const {
+    return Member(_ports, index).set_zero_position(position);
+}
+std::int32_t MotorGroup::tare_position(const std::uint8_t index) const { return Member(_ports, index).tare_position(); }
+
+std::int8_t MotorGroup::size(void) const { return _ports.size(); }
+std::int8_t MotorGroup::get_port(const std::uint8_t index) const { return index < _ports.size() ? _ports[index] : PROS_ERR_BYTE; }
+
+void MotorGroup::operator+=(AbstractMotor& other) { append(other); }
+void MotorGroup::append(AbstractMotor& other) {
+    for (std::int8_t port : other.get_port_all())
+        _ports.push_back(port);
+}
+void MotorGroup::erase_port(std::int8_t port) { std::erase_if(_ports, [&](std::int8_t p) { return std::abs(p) == std::abs(port); }); }
+
+std::vector<double> MotorGroup::get_target_position_all(void) const { return Collect<double>(_ports, [](Motor m) { return m.get_target_position(); }); }
+std::vector<std::int32_t> MotorGroup::get_target_velocity_all(void) const { return Collect<std::int32_t>(_ports, [](Motor m) { return m.get_target_velocity(); }); }
+std::vector<double> MotorGroup::get_actual_velocity_all(void) const { return Collect<double>(_ports, [](Motor m) { return m.get_actual_velocity(); }); }
+std::vector<std::int32_t> MotorGroup::get_current_draw_all(void) const { return Collect<std::int32_t>(_ports, [](Motor m) { return m.get_current_draw(); }); }
+std::vector<std::int32_t> MotorGroup::get_direction_all(void) const { return Collect<std::int32_t>(_ports, [](Motor m) { return m.get_direction(); }); }
+std::vector<double> MotorGroup::get_efficiency_all(void) const { return Collect<double>(_ports, [](Motor m) { return m.get_efficiency(); }); }
+std::vector<std::uint32_t> MotorGroup::get_faults_all(void) const { return Collect<std::uint32_t>(_ports, [](Motor m) { return m.get_faults(); }); }
+std::vector<std::uint32_t> MotorGroup::get_flags_all(void) const { return Collect<std::uint32_t>(_ports, [](Motor m) { return m.get_flags(); }); }
+std::vector<double> MotorGroup::get_position_all(void) const { return Collect<double>(_ports, [](Motor m) { return m.get_position(); }); }
+std::vector<double> MotorGroup::get_power_all(void) const { return Collect<double>(_ports, [](Motor m) { return m.get_power(); }); }
+std::vector<std::int32_t> MotorGroup::get_raw_position_all(std::uint32_t* const timestamp) const {
+    return Collect<std::int32_t>(_ports, [&](Motor m) { return m.get_raw_position(timestamp); });
+}
+std::vector<double> MotorGroup::get_temperature_all(void) const { return Collect<double>(_ports, [](Motor m) { return m.get_temperature(); }); }
+std::vector<double> MotorGroup::get_torque_all(void) const { return Collect<double>(_ports, [](Motor m) { return m.get_torque(); }); }
+std::vector<std::int32_t> MotorGroup::get_voltage_all(void) const { return Collect<std::int32_t>(_ports, [](Motor m) { return m.get_voltage(); }); }
+std::vector<std::int32_t> MotorGroup::is_over_current_all(void) const { return Collect<std::int32_t>(_ports, [](Motor m) { return m.is_over_current(); }); }
+std::vector<std::int32_t> MotorGroup::is_over_temp_all(void) const { return Collect<std::int32_t>(_ports, [](Motor m) { return m.is_over_temp(); }); }
+std::vector<MotorBrake> MotorGroup::get_brake_mode_all(void) const { return Collect<MotorBrake>(_ports, [](Motor m) { return m.get_brake_mode(); }); }
+std::vector<std::int32_t> MotorGroup::get_current_limit_all(void) const { return Collect<std::int32_t>(_ports, [](Motor m) { return m.get_current_limit(); }); }
+std::vector<MotorUnits> MotorGroup::get_encoder_units_all(void) const { return Collect<MotorUnits>(_ports, [](Motor m) { return m.get_encoder_units(); }); }
+std::vector<MotorGears> MotorGroup::get_gearing_all(void) const { return Collect<MotorGears>(_ports, [](Motor m) { return m.get_gearing(); }); }
+std::vector<std::int8_t> MotorGroup::get_port_all(void) const { return _ports; }
+std::vector<std::int32_t> MotorGroup::get_voltage_limit_all(void) const { return Collect<std::int32_t>(_ports, [](Motor m) { return m.get_voltage_limit(); }); }
+std::vector<std::int32_t> MotorGroup::is_reversed_all(void) const { return Collect<std::int32_t>(_ports, [](Motor m) { return m.is_reversed(); }); }
+std::int32_t MotorGroup::set_brake_mode_all(const MotorBrake mode) const { return ForEach(_ports, [&](Motor m) { return m.set_brake_mode(mode); }); }
+std::int32_t MotorGroup::set_brake_mode_all(const pros::motor_brake_mode_e_t mode) const { return ForEach(_ports, [&](Motor m) { return m.set_brake_mode(mode); }); }
+std::int32_t MotorGroup::set_current_limit_all(const std::int32_t limit) const { return ForEach(_ports, [&](Motor m) { return m.set_current_limit(limit); }); }
+std::int32_t MotorGroup::set_encoder_units_all(const MotorUnits units) const { return ForEach(_ports, [&](Motor m) { return m.set_encoder_units(units); }); }
+std::int32_t MotorGroup::set_encoder_units_all(const pros::motor_encoder_units_e_t units) const {
+    return ForEach(_ports, [&](Motor m) { return m.set_encoder_units(units); });
+}
+std::int32_t MotorGroup::set_gearing_all(const MotorGears gearset) const { return ForEach(_ports, [&](Motor m) { return m.set_gearing(gearset); }); }
+std::int32_t MotorGroup::set_gearing_all(const pros::motor_gearset_e_t gearset) const { return ForEach(_ports, [&](Motor m) { return m.set_gearing(gearset); }); }
+std::int32_t MotorGroup::set_reversed_all(const bool reverse) {
+    for (std::int8_t& port : _ports)
+        port = reverse ? -std::abs(port) : std::abs(port);
+    return 1;
+}
+std::int32_t MotorGroup::set_voltage_limit_all(const std::int32_t limit) const { return ForEach(_ports, [&](Motor m) { return m.set_voltage_limit(limit); }); }
+std::int32_t MotorGroup::set_zero_position_all(const double position) const { return ForEach(_ports, [&](Motor m) { return m.set_zero_position(position); }); }
+std::int32_t MotorGroup::tare_position_all(void) const { return ForEach(_ports, [&](Motor m) { return m.tare_position(); }); }
+
+}  // namespace v5
+}  // namespace pros
@@ -0,0 +1,168 @@
+/**
+ * @file rtos.cpp
+ * @brief Host stand-in for the PROS RTOS facilities (tasks, delays, mutexes, clock).
+ *
+ * Everything forwards to the deterministic virtual-time scheduler in sim/, so
+ * pros::millis() reports simulated time and pros::delay() never sleeps for real.
+ */
+
+#include "pros/rtos.hpp"
+
+#include "sim/profile.hpp"
+#include "sim/scheduler.hpp"
+
+namespace pros {
+namespace c {
+
+uint32_t millis(void) { return sim::Now(); }
+
+uint64_t micros(void) { return sim::NowMicros(); }
+
+task_t task_create(task_fn_t function, void* const parameters, uint32_t prio, const uint16_t stack_depth, const char* const name) {
+    (void)stack_depth;
+    return sim::TaskCreate(function, parameters, prio, name);
+}
+
+void task_delete(task_t task) { sim::TaskDelete(static_cast<sim::Task*>(task ? task : sim::TaskCurrent())); }
+
+void task_delay(const uint32_t milliseconds) {
+    sim::ProfileScope profile(sim::ProfileKind::SLEEP, "delay(%u)", milliseconds);
+    sim::TaskDelay(milliseconds);
+}
+
+void delay(const uint32_t milliseconds) {
+    sim::ProfileScope profile(sim::ProfileKind::SLEEP, "delay(%u)", milliseconds);
+    sim::TaskDelay(milliseconds);
+}
+
+void task_delay_until(uint32_t* const prev_time, const uint32_t delta) {
+    sim::ProfileScope profile(sim::ProfileKind::SLEEP, "delay_until(%u)", delta);
+    sim::TaskDelayUntil(prev_time, delta);
+}
+
+uint32_t task_get_priority(task_t task) { return sim::TaskPriorityGet(static_cast<sim::Task*>(task ? task : sim::TaskCurrent())); }
+
+void task_set_priority(task_t task, uint32_t prio) { sim::TaskPrioritySet(static_cast<sim::Task*>(task ? task : sim::TaskCurrent()), prio); }
+
+task_state_e_t task_get_state(task_t task) {
+    if (!task) return E_TASK_STATE_INVALID;
+    switch (sim::TaskStateGet(static_cast<sim::Task*>(task))) {
+        case sim::TaskState::RUNNING: return E_TASK_STATE_RUNNING;
+        case sim::TaskState::READY: return E_TASK_STATE_READY;
+        case sim::TaskState::BLOCKED: return E_TASK_STATE_BLOCKED;
+        case sim::TaskState::SUSPENDED: return E_TASK_STATE_SUSPENDED;
+        case sim::TaskState::DELETED: return E_TASK_STATE_DELETED;
+    }
+    return E_TASK_STATE_INVALID;
+}
+
+void task_suspend(task_t task) { sim::TaskSuspend(static_cast<sim::Task*>(task ? task : sim::TaskCurrent())); }
+
+void task_resume(task_t task) { sim::TaskResume(static_cast<sim::Task*>(task)); }
+
+uint32_t task_get_count(void) { return sim::TaskCount(); }
+
+char* task_get_name(task_t task) {
+    if (!task) return nullptr;
+    return const_cast<char*>(sim::TaskName(static_cast<sim::Task*>(task)).c_str());
+}
+
+task_t task_get_by_name(const char* name) { return sim::TaskByName(name); }
+
+task_t task_get_current() { return sim::TaskCurrent(); }
+
+uint32_t task_notify(task_t task) { return sim::TaskNotify(static_cast<sim::Task*>(task)); }
+
+void task_join(task_t task) { sim::TaskJoin(static_cast<sim::Task*>(task)); }
+
+uint32_t task_notify_ext(task_t task, uint32_t value, notify_action_e_t action, uint32_t* prev_value) {
+    (void)value;
+    (void)action;
+    if (prev_value) *prev_value = 0;
+    return sim::TaskNotify(static_cast<sim::Task*>(task));
+}
+
+uint32_t task_notify_take(bool clear_on_exit, uint32_t timeout) { return sim::TaskNotifyTake(clear_on_exit, timeout); }
+
+bool task_notify_clear(task_t task) { return sim::TaskNotifyClear(static_cast<sim::Task*>(task)); }
+
+mutex_t mutex_create(void) { return sim::MutexCreate(); }
+
+bool mutex_take(mutex_t mutex, uint32_t timeout) { return sim::MutexTake(static_cast<sim::Mutex*>(mutex), timeout); }
+
+bool mutex_give(mutex_t mutex) { return sim::MutexGive(static_cast<sim::Mutex*>(mutex)); }
+
+void mutex_delete(mutex_t mutex) { sim::MutexDelete(static_cast<sim::Mutex*>(mutex)); }
+
+}  // namespace c
+
+inline namespace rtos {
+
+Task::Task(task_fn_t function, void* parameters, std::uint32_t prio, std::uint16_t stack_depth, const char* name)
+    : task(c::task_create(function, parameters, prio, stack_depth, name)) {}
+
+Task::Task(task_fn_t function, void* parameters, const char* name)
+    : Task(function, parameters, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, name) {}
+
+Task::Task(task_t task) : task(task) {}
+
+Task& Task::operator=(const task_t in) {
+    task = in;
+    return *this;
+}
+
+Task Task::current() { return Task(c::task_get_current()); }
+
+void Task::remove() { c::task_delete(task); }
+
+std::uint32_t Task::get_priority() { return c::task_get_priority(task); }
+
+void Task::set_priority(std::uint32_t prio) { c::task_set_priority(task, prio); }
+
+std::uint32_t Task::get_state() { return c::task_get_state(task); }
+
+void Task::suspend() { c::task_suspend(task); }
+
+void Task::resume() { c::task_resume(task); }
+
+const char* Task::get_name() { return c::task_get_name(task); }
+
+std::uint32_t Task::notify() { return c::task_notify(task); }
+
+void Task::join() { c::task_join(task); }
+
+std::uint32_t Task::notify_ext(std::uint32_t value, notify_action_e_t action, std::uint32_t* prev_value) {
+    return c::task_notify_ext(task, value, action, prev_value);
+}
+
+std::uint32_t Task::notify_take(bool clear_on_exit, std::uint32_t timeout) { return c::task_notify_take(clear_on_exit, timeout); }
+
+bool Task::notify_clear() { return c::task_notify_clear(task); }
+
+void Task::delay(const std::uint32_t milliseconds) { c::task_delay(milliseconds); }
+
+void Task::delay_until(std::uint32_t* const prev_time, const std::uint32_t delta) { c::task_delay_until(prev_time, delta); }
+
+std::uint32_t Task::get_count() { return c::task_get_count(); }
+
+Clock::time_point Clock::now() { return time_point{duration{c::millis()}}; }
+
+Mutex::Mutex() : mutex(c::mutex_create(), c::mutex_delete) {}
+
+bool Mutex::take() { return c::mutex_take(mutex.get(), TIMEOUT_MAX); }
+
+bool Mutex::take(std::uint32_t timeout) { return c::mutex_take(mutex.get(), timeout); }
+
+bool Mutex::give() { return c::mutex_give(mutex.get()); }
+
+void Mutex::lock() {
+    while (!take(TIMEOUT_MAX))
+        ;
+}
+
+void Mutex::unlock() { give(); }
+
+bool Mutex::try_lock() { return take(0); }
+
+}  // namespace rtos
+}  // namespace pros
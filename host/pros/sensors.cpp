@@ -0,0 +1,283 @@
+/**
+ * @file sensors.cpp
+ * @brief Host stand-in for the V5 smart sensors the robot uses (optical, rotation, IMU, distance).
+ *
+ * Readings come straight from the per-port state in sim/world.hpp, which plants
+ * and host tools write.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "pros/device.hpp"
+#include "pros/distance.hpp"
+#include "pros/imu.hpp"
+#include "pros/optical.hpp"
+#include "pros/rotation.hpp"
+#include "sim/world.hpp"
+
+namespace pros {
+inline namespace v5 {
+
+// ----------------------------------------------------------------------------
+// Device
+// ----------------------------------------------------------------------------
+
+Device::Device(const std::uint8_t port) : _port(port) {}
+
+std::uint8_t Device::get_port(void) const { return _port; }
+
+bool Device::is_installed() { return true; }
+
+DeviceType Device::get_plugged_type() const { return _deviceType; }
+
+// ----------------------------------------------------------------------------
+// Optical
+// ----------------------------------------------------------------------------
+
+namespace {
+sim::OpticalState& OpticalAt(std::uint8_t port) { return sim::Port(port).optical; }
+}  // namespace
+
+Optical::Optical(const std::uint8_t port) : Device(port, DeviceType::optical) {}
+
+double Optical::get_hue() { return OpticalAt(_port).hue; }
+
+double Optical::get_saturation() { return OpticalAt(_port).saturation; }
+
+double Optical::get_brightness() { return OpticalAt(_port).brightness; }
+
+std::int32_t Optical::get_proximity() { return OpticalAt(_port).proximity; }
+
+std::int32_t Optical::set_led_pwm(uint8_t value) {
+    OpticalAt(_port).ledPwm = value;
+    return 1;
+}
+
+std::int32_t Optical::get_led_pwm() { return OpticalAt(_port).ledPwm; }
+
+pros::c::optical_rgb_s_t Optical::get_rgb() {
+    // HSV to RGB so code that reads channels sees the same color as get_hue()
+    const sim::OpticalState& optical = OpticalAt(_port);
+    double c = optical.brightness * optical.saturation;
+    double h = std::fmod(optical.hue, 360.0) / 60.0;
+    double x = c * (1 - std::fabs(std::fmod(h, 2.0) - 1));
+    double m = optical.brightness - c;
+    double r = 0, g = 0, b = 0;
+    if (h < 1) r = c, g = x;
+    else if (h < 2) r = x, g = c;
+    else if (h < 3) g = c, b = x;
+    else if (h < 4) g = x, b = c;
+    else if (h < 5) r = x, b = c;
+    else r = c, b = x;
+    return {(r + m) * 255, (g + m) * 255, (b + m) * 255, optical.brightness};
+}
+
+pros::c::optical_raw_s_t Optical::get_raw() {
+    pros::c::optical_rgb_s_t rgb = get_rgb();
+    return {static_cast<uint32_t>(rgb.brightness * 1024), static_cast<uint32_t>(rgb.red * 4), static_cast<uint32_t>(rgb.green * 4),
+            static_cast<uint32_t>(rgb.blue * 4)};
+}
+
+pros::c::optical_direction_e_t Optical::get_gesture() { return pros::c::NO_GESTURE; }
+
+pros::c::optical_gesture_s_t Optical::get_gesture_raw() { return {}; }
+
+std::int32_t Optical::enable_gesture() { return 1; }
+
+std::int32_t Optical::disable_gesture() { return 1; }
+
+double Optical::get_integration_time() { return OpticalAt(_port).integrationTime; }
+
+std::int32_t Optical::set_integration_time(double time) {
+    OpticalAt(_port).integrationTime = std::clamp(time, 3.0, 712.0);
+    return 1;
+}
+
+// ----------------------------------------------------------------------------
+// Rotation, positions in centidegrees
+// ----------------------------------------------------------------------------
+
+namespace {
+sim::RotationState& RotationAt(std::uint8_t port) { return sim::Port(port).rotation; }
+
+double RotationSign(const sim::RotationState& rotation) { return rotation.reversed ? -1.0 : 1.0; }
+}  // namespace
+
+Rotation::Rotation(const std::int8_t port) : Device(std::abs(port), DeviceType::rotation) {
+    if (port < 0) RotationAt(_port).reversed = true;
+}
+
+std::int32_t Rotation::reset() { return reset_position(); }
+
+std::int32_t Rotation::set_data_rate(std::uint32_t rate) const {
+    RotationAt(_port).dataRate = std::max<std::uint32_t>(5, rate / 5 * 5);
+    return 1;
+}
+
+std::int32_t Rotation::set_position(std::uint32_t position) const {
+    sim::RotationState& rotation = RotationAt(_port);
+    rotation.offset = rotation.position - RotationSign(rotation) * static_cast<std::int32_t>(position);
+    return 1;
+}
+
+std::int32_t Rotation::reset_position(void) const { return set_position(0); }
+
+std::int32_t Rotation::get_position() const {
+    const sim::RotationState& rotation = RotationAt(_port);
+    return std::lround(RotationSign(rotation) * (rotation.position - rotation.offset));
+}
+
+std::int32_t Rotation::get_velocity() const {
+    const sim::RotationState& rotation = RotationAt(_port);
+    return std::lround(RotationSign(rotation) * rotation.velocity);
+}
+
+std::int32_t Rotation::get_angle() const {
+    const sim::RotationState& rotation = RotationAt(_port);
+    double angle = std::fmod(RotationSign(rotation) * rotation.position, 36000.0);
+    return std::lround(angle < 0 ? angle + 36000.0 : angle);
+}
+
+std::int32_t Rotation::set_reversed(bool value) const {
+    sim::RotationState& rotation = RotationAt(_port);
+    if (rotation.reversed != value) {
+        // keep the reported position continuous, like the sensor does
+        rotation.offset = 2 * rotation.position - rotation.offset;
+        rotation.reversed = value;
+    }
+    return 1;
+}
+
+std::int32_t Rotation::reverse() const { return set_reversed(!RotationAt(_port).reversed); }
+
+std::int32_t Rotation::get_reversed() const { return RotationAt(_port).reversed; }
+
+// ----------------------------------------------------------------------------
+// Imu, `yaw` in the world state is the true clockwise rotation
+// ----------------------------------------------------------------------------
+
+namespace {
+sim::ImuState& ImuAt(std::uint8_t port) { return sim::Port(port).imu; }
+
+double Wrap180(double angle) {
+    angle = std::fmod(angle + 180.0, 360.0);
+    return (angle < 0 ? angle + 360.0 : angle) - 180.0;
+}
+}  // namespace
+
+std::int32_t Imu::reset(bool blocking) const {
+    sim::ImuState& imu = ImuAt(_port);
+    imu.rotationOffset = -imu.yaw;
+    imu.headingOffset = -imu.yaw;
+    return 1;
+}
+
+std::int32_t Imu::set_data_rate(std::uint32_t rate) const { return 1; }
+
+double Imu::get_rotation() const {
+    const sim::ImuState& imu = ImuAt(_port);
+    return imu.yaw + imu.rotationOffset;
+}
+
+double Imu::get_heading() const {
+    const sim::ImuState& imu = ImuAt(_port);
+    double heading = std::fmod(imu.yaw + imu.headingOffset, 360.0);
+    return heading < 0 ? heading + 360.0 : heading;
+}
+
+pros::quaternion_s_t Imu::get_quaternion() const {
+    double half = -get_yaw() * M_PI / 360.0;
+    return {0, 0, std::sin(half), std::cos(half)};
+}
+
+pros::euler_s_t Imu::get_euler() const { return {get_pitch(), get_roll(), get_yaw()}; }
+
+double Imu::get_pitch() const { return ImuAt(_port).pitch; }
+
+double Imu::get_roll() const { return ImuAt(_port).roll; }
+
+double Imu::get_yaw() const { return Wrap180(get_heading()); }
+
+pros::imu_gyro_s_t Imu::get_gyro_rate() const { return {0, 0, ImuAt(_port).gyroZ}; }
+
+std::int32_t Imu::tare_rotation() const { return set_rotation(0); }
+
+std::int32_t Imu::tare_heading() const { return set_heading(0); }
+
+std::int32_t Imu::tare_pitch() const { return set_pitch(0); }
+
+std::int32_t Imu::tare_yaw() const { return set_yaw(0); }
+
+std::int32_t Imu::tare_roll() const { return set_roll(0); }
+
+std::int32_t Imu::tare() const {
+    tare_rotation();
+    return tare_heading();
+}
+
+std::int32_t Imu::tare_euler() const { return tare_heading(); }
+
+std::int32_t Imu::set_heading(const double target) const {
+    sim::ImuState& imu = ImuAt(_port);
+    imu.headingOffset = target - imu.yaw;
+    return 1;
+}
+
+std::int32_t Imu::set_rotation(const double target) const {
+    sim::ImuState& imu = ImuAt(_port);
+    imu.rotationOffset = target - imu.yaw;
+    return 1;
+}
+
+std::int32_t Imu::set_yaw(const double target) const { return set_heading(target); }
+
+std::int32_t Imu::set_pitch(const double target) const {
+    ImuAt(_port).pitch = target;
+    return 1;
+}
+
+std::int32_t Imu::set_roll(const double target) const {
+    ImuAt(_port).roll = target;
+    return 1;
+}
+
+std::int32_t Imu::set_euler(const pros::euler_s_t target) const {
+    set_pitch(target.pitch);
+    set_roll(target.roll);
+    return set_yaw(target.yaw);
+}
+
+pros::imu_accel_s_t Imu::get_accel() const {
+    const sim::ImuState& imu = ImuAt(_port);
+    return {imu.accelX, imu.accelY, imu.accelZ};
+}
+
+pros::ImuStatus Imu::get_status() const { return ImuAt(_port).calibrating ? ImuStatus::calibrating : ImuStatus::ready; }
+
+bool Imu::is_calibrating() const { return ImuAt(_port).calibrating; }
+
+imu_orientation_e_t Imu::get_physical_orientation() const { return E_IMU_Z_UP; }
+
+// ----------------------------------------------------------------------------
+// Distance
+// ----------------------------------------------------------------------------
+
+namespace {
+sim::DistanceState& DistanceAt(std::uint8_t port) { return sim::Port(port).distance; }
+}  // namespace
+
+Distance::Distance(const std::uint8_t port) : Device(port, DeviceType::distance) {}
+
+std::int32_t Distance::get() { return DistanceAt(_port).distance; }
+
+std::int32_t Distance::get_distance() { return DistanceAt(_port).distance; }
+
+std::int32_t Distance::get_confidence() { return DistanceAt(_port).confidence; }
+
+std::int32_t Distance::get_object_size() { return DistanceAt(_port).objectSize; }
+
+double Distance::get_object_velocity() { return DistanceAt(_port).objectVelocity; }
+
+}  // namespace v5
+}  // namespace pros
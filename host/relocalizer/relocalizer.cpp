@@ -0,0 +1,322 @@
+/**
+ * @file relocalizer.cpp
+ * @brief Particle filter that pulls odometry back onto the field using distance sensors and the walls.
+ *
+ * The field model is the four perimeter walls. Anything else a sensor sees, a
+ * goal, the ladder, another robot, reads short of the wall; the sensor model
+ * gives every reading a small chance of being such an object, and a reading no
+ * particle can explain is dropped, so one blocked sensor doesn't pull the pose.
+ */
+
+#include "relocalizer/relocalizer.hpp"
+
+#include "main.h"
+#include "subsystems.hpp"
+#include <cmath>
+
+const int RELOCALIZE_PERIOD_MS = 10;  // right after odometry, on the same slot
+
+// PLACEHOLDERS: not on the robot yet
+pros::Distance leftDistance(1);
+pros::Distance rightDistance(2);
+
+const double FIELD_HALF_WIDTH = 70.2;          // inches, a 140.4 in square inside the perimeter
+const double DISTANCE_MAX_RANGE = 78.0;        // inches, the sensor reads 2000 mm at most
+const int DISTANCE_MIN_CONFIDENCE = 32;        // of 63, only reported past 200 mm
+const int DISTANCE_CONFIDENT_MM = 200;         // closer than this the sensor reports no confidence
+
+// Motion noise added to every particle each update, standard deviation as a fraction of the travel plus a floor
+const double PARTICLE_TRAVEL_NOISE = 0.1;      // wide enough to follow a wheel that reads a few percent off
+const double PARTICLE_TRAVEL_FLOOR = 0.01;     // inches, keeps a still filter from collapsing to one particle
+const double PARTICLE_TURN_NOISE = 0.02;       // fraction of the turn
+const double PARTICLE_TURN_FLOOR = 0.0005;     // radians
+
+// Sensor model: the right reading is Gaussian about the wall, a wrong one is anywhere in range
+const double DISTANCE_NOISE = 0.03;            // fraction of the distance past 200 mm, the spec's 5% is a worst case
+const double DISTANCE_NOISE_FLOOR = 0.6;       // inches, 15 mm up close
+const double DISTANCE_HIT_WEIGHT = 0.9;        // chance a reading is the wall
+const double DISTANCE_GATE = 4.0;              // standard deviations a reading may be from every particle before it's dropped
+
+// When the relocalizer corrects odometry
+const double RELOCALIZE_MAX_SPREAD = 2.0;      // inches, particles must agree this well
+const double RELOCALIZE_MAX_TURN_RATE = 120;   // degrees per second, sensor latency smears readings past this
+const double RELOCALIZE_MAX_STEP = 6.0;        // inches, a bigger odom jump is someone setting the pose
+const int RELOCALIZE_CORRECTION_MS = 100;      // readings in a row are not independent, so only correct this often
+const double CORRECTION_VARIANCE_FLOOR = 0.01; // square inches, so a collapsed cloud never overrides odometry outright
+const double START_SPREAD = 1.0;               // inches, how well the robot is placed
+const double START_HEADING_SPREAD = 1.0;       // degrees
+
+// PLACEHOLDERS: measure these on the robot, from the tracking center, before any auton starts the relocalizer
+const DistanceMount DISTANCE_MOUNTS[] = {
+    {&leftDistance, -6.0, 0.0, -90},
+    {&rightDistance, 6.0, 0.0, 90},
+    {&backDistance, 0.0, -7.0, 180},
+};
+const int DISTANCE_MOUNT_COUNT = sizeof(DISTANCE_MOUNTS) / sizeof(DISTANCE_MOUNTS[0]);
+
+ParticleFilter particleFilter;
+pros::Mutex relocalizeMutex;
+bool relocalizing = false;
+ez::pose odomOrigin;          // field pose of odom (0, 0, 0)
+ez::pose lastOdom;            // odometry at the last tick
+std::uint32_t lastCorrection = 0;
+
+// Timing of the relocalizer
+LoopStats relocalizeLoopStats{"Relocalize", RELOCALIZE_PERIOD_MS};
+
+
+/**
+ * @brief Distance along a ray to the nearest wall it points at.
+ */
+double WallDistance(double x, double y, double angle) {
+    double dx = std::sin(ez::util::to_rad(angle));
+    double dy = std::cos(ez::util::to_rad(angle));
+    double distance = INFINITY;
+    if (dx > 1e-9) distance = std::min(distance, (FIELD_HALF_WIDTH - x) / dx);
+    if (dx < -1e-9) distance = std::min(distance, (-FIELD_HALF_WIDTH - x) / dx);
+    if (dy > 1e-9) distance = std::min(distance, (FIELD_HALF_WIDTH - y) / dy);
+    if (dy < -1e-9) distance = std::min(distance, (-FIELD_HALF_WIDTH - y) / dy);
+    return std::max(0.0, distance);
+}
+
+
+/** @brief Seeds the random draws the same way every boot, so runs replay. */
+ParticleFilter::ParticleFilter() : rng(1) { Reset({0, 0, 0}, 0, 0); }
+
+
+/**
+ * @brief Places every particle at the pose plus Gaussian placement error.
+ */
+void ParticleFilter::Reset(ez::pose fieldPose, double spread, double headingSpread) {
+    for (Particle& particle : particles) {
+        particle.x = fieldPose.x + spread * gaussian(rng);
+        particle.y = fieldPose.y + spread * gaussian(rng);
+        particle.theta = ez::util::to_rad(fieldPose.theta + headingSpread * gaussian(rng));
+        particle.weight = 1.0 / PARTICLE_COUNT;
+    }
+}
+
+
+/**
+ * @brief Moves each particle along its own heading by noisy copies of the travel.
+ */
+void ParticleFilter::Predict(double forward, double sideways, double turn) {
+    double turnRad = ez::util::to_rad(turn);
+    double travelSigma = PARTICLE_TRAVEL_NOISE * std::hypot(forward, sideways) + PARTICLE_TRAVEL_FLOOR;
+    double turnSigma = PARTICLE_TURN_NOISE * std::fabs(turnRad) + PARTICLE_TURN_FLOOR;
+
+    for (Particle& particle : particles) {
+        double f = forward + travelSigma * gaussian(rng);
+        double s = sideways + travelSigma * gaussian(rng);
+        double t = turnRad + turnSigma * gaussian(rng);
+        double mid = particle.theta + t / 2.0;
+        particle.x += f * std::sin(mid) + s * std::cos(mid);
+        particle.y += f * std::cos(mid) - s * std::sin(mid);
+        particle.theta += t;
+    }
+}
+
+
+/**
+ * @brief Multiplies each particle's weight by how likely it makes each reading.
+ *
+ * A reading is kept only if some particle expects it within DISTANCE_GATE
+ * standard deviations, so a sensor looking at a goal instead of a wall is ignored.
+ */
+bool ParticleFilter::Correct(const WallReading* readings, int count) {
+    bool used = false;
+
+    for (int r = 0; r < count; r++) {
+        const WallReading& reading = readings[r];
+
+        bool explained = false;
+        for (int i = 0; i < PARTICLE_COUNT; i++) {
+            const Particle& particle = particles[i];
+            double s = std::sin(particle.theta), c = std::cos(particle.theta);
+            double sensorX = particle.x + reading.forward * s + reading.right * c;
+            double sensorY = particle.y + reading.forward * c - reading.right * s;
+            expected[i] = WallDistance(sensorX, sensorY, ez::util::to_deg(particle.theta) + reading.facing);
+            double sigma = DISTANCE_NOISE * expected[i] + DISTANCE_NOISE_FLOOR;
+            if (expected[i] <= DISTANCE_MAX_RANGE && std::fabs(reading.distance - expected[i]) < DISTANCE_GATE * sigma) explained = true;
+        }
+        if (!explained) continue;
+
+        double total = 0;
+        for (int i = 0; i < PARTICLE_COUNT; i++) {
+            double likelihood = (1.0 - DISTANCE_HIT_WEIGHT) / DISTANCE_MAX_RANGE;
+            if (expected[i] <= DISTANCE_MAX_RANGE) {
+                double sigma = DISTANCE_NOISE * expected[i] + DISTANCE_NOISE_FLOOR;
+                double z = (reading.distance - expected[i]) / sigma;
+                likelihood += DISTANCE_HIT_WEIGHT * std::exp(-0.5 * z * z) / (sigma * std::sqrt(2 * M_PI));
+            }
+            particles[i].weight *= likelihood;
+            total += particles[i].weight;
+        }
+        for (Particle& particle : particles)
+            particle.weight /= total;
+        used = true;
+    }
+
+    if (!used) return false;
+
+    // Resample once the effective number of particles drops below half
+    double sumSquares = 0;
+    for (const Particle& particle : particles)
+        sumSquares += particle.weight * particle.weight;
+    if (1.0 / sumSquares < PARTICLE_COUNT / 2.0) Resample();
+    return true;
+}
+
+
+/**
+ * @brief Systematic resampling: one random start, then evenly spaced picks along the cumulative weight.
+ */
+void ParticleFilter::Resample() {
+    double step = 1.0 / PARTICLE_COUNT;
+    double pick = uniform(rng) * step;
+    double cumulative = particles[0].weight;
+    int source = 0;
+    for (int i = 0; i < PARTICLE_COUNT; i++) {
+        while (pick > cumulative && source < PARTICLE_COUNT - 1)
+            cumulative += particles[++source].weight;
+        resampled[i] = particles[source];
+        resampled[i].weight = step;
+        pick += step;
+    }
+    for (int i = 0; i < PARTICLE_COUNT; i++)
+        particles[i] = resampled[i];
+}
+
+
+/** @brief Weighted mean of the particles. */
+ez::pose ParticleFilter::Estimate() const {
+    double x = 0, y = 0, theta = 0;
+    for (const Particle& particle : particles) {
+        x += particle.weight * particle.x;
+        y += particle.weight * particle.y;
+        theta += particle.weight * particle.theta;
+    }
+    return {x, y, ez::util::to_deg(theta)};
+}
+
+
+/** @brief Weighted root mean square distance of the particles from their mean. */
+double ParticleFilter::Spread() const {
+    ez::pose mean = Estimate();
+    double variance = 0;
+    for (const Particle& particle : particles) {
+        double dx = particle.x - mean.x, dy = particle.y - mean.y;
+        variance += particle.weight * (dx * dx + dy * dy);
+    }
+    return std::sqrt(variance);
+}
+
+
+/** @brief Field pose of an odom pose. */
+ez::pose OdomToField(ez::pose odom) {
+    double t = ez::util::to_rad(odomOrigin.theta);
+    return {odomOrigin.x + odom.x * std::cos(t) + odom.y * std::sin(t),
+            odomOrigin.y - odom.x * std::sin(t) + odom.y * std::cos(t),
+            odomOrigin.theta + odom.theta};
+}
+
+
+/** @brief Odom pose of a field pose. */
+ez::pose FieldToOdom(ez::pose field) {
+    double t = ez::util::to_rad(odomOrigin.theta);
+    double x = field.x - odomOrigin.x, y = field.y - odomOrigin.y;
+    return {x * std::cos(t) - y * std::sin(t), x * std::sin(t) + y * std::cos(t), field.theta - odomOrigin.theta};
+}
+
+
+/**
+ * @brief Places the particles where odometry says the robot is on the field and starts correcting.
+ */
+void RelocalizeStart(ez::pose fieldStart) {
+    relocalizeMutex.take();
+    odomOrigin = fieldStart;
+    lastOdom = fusedOdom.odom_pose_get();
+    particleFilter.Reset(OdomToField(lastOdom), START_SPREAD, START_HEADING_SPREAD);
+    lastCorrection = pros::millis();
+    relocalizing = true;
+    relocalizeMutex.give();
+}
+
+
+/** @brief Stops correcting odometry. */
+void RelocalizeStop() {
+    relocalizeMutex.take();
+    relocalizing = false;
+    relocalizeMutex.give();
+}
+
+
+/** @brief Current particle estimate in field coordinates. */
+ez::pose RelocalizeFieldPose() {
+    relocalizeMutex.take();
+    ez::pose pose = particleFilter.Estimate();
+    relocalizeMutex.give();
+    return pose;
+}
+
+
+/**
+ * @brief Reads the distance sensors that see something with confidence.
+ *
+ * @return Readings written to `readings`
+ */
+int ReadWalls(WallReading* readings) {
+    int count = 0;
+    for (int i = 0; i < DISTANCE_MOUNT_COUNT; i++) {
+        const DistanceMount& mount = DISTANCE_MOUNTS[i];
+        std::int32_t millimeters = mount.sensor->get();
+        if (millimeters <= 0 || millimeters / 25.4 > DISTANCE_MAX_RANGE) continue;
+        if (millimeters > DISTANCE_CONFIDENT_MM && mount.sensor->get_confidence() < DISTANCE_MIN_CONFIDENCE) continue;
+        readings[count++] = {mount.right, mount.forward, mount.facing, millimeters / 25.4};
+    }
+    return count;
+}
+
+
+/**
+ * @brief One relocalizer update.
+ *
+ * Runs right after the pose estimator in the same slot. Corrections go into the
+ * estimator, and lastOdom is taken after them, so the particles never see the
+ * correction as travel.
+ */
+void RelocalizeTick() {
+    relocalizeMutex.take();
+    if (!relocalizing) {
+        relocalizeMutex.give();
+        return;
+    }
+
+    // Odometry travel since the last tick, in the robot's frame at the start of it
+    ez::pose odom = fusedOdom.odom_pose_get();
+    double dx = odom.x - lastOdom.x, dy = odom.y - lastOdom.y;
+    double t = ez::util::to_rad(lastOdom.theta);
+    if (std::hypot(dx, dy) < RELOCALIZE_MAX_STEP)
+        particleFilter.Predict(dx * std::sin(t) + dy * std::cos(t), dx * std::cos(t) - dy * std::sin(t), odom.theta - lastOdom.theta);
+    lastOdom = odom;
+
+    // Distance sensors lag the pose, so skip them while spinning fast
+    if (std::fabs(PoseHistoryLatest().angularVelocity) > RELOCALIZE_MAX_TURN_RATE) {
+        relocalizeMutex.give();
+        return;
+    }
+
+    WallReading readings[DISTANCE_MOUNT_COUNT];
+    int count = ReadWalls(readings);
+    bool used = count > 0 && particleFilter.Correct(readings, count);
+
+    std::uint32_t now = pros::millis();
+    double spread = particleFilter.Spread();
+    if (used && spread < RELOCALIZE_MAX_SPREAD && now - lastCorrection >= (std::uint32_t)RELOCALIZE_CORRECTION_MS) {
+        ez::pose corrected = FieldToOdom(particleFilter.Estimate());
+        fusedOdom.CorrectPosition(corrected.x, corrected.y, spread * spread + CORRECTION_VARIANCE_FLOOR);
+        lastOdom = fusedOdom.odom_pose_get();
+        lastCorrection = now;
+    }
+    relocalizeMutex.give();
+}
@@ -0,0 +1,122 @@
+/**
+ * @file relocalizer.hpp
+ * @brief Particle filter that pulls odometry back onto the field using distance sensors and the walls.
+ *
+ * Odometry drifts over a long skills run. The relocalizer keeps a fixed set of
+ * guesses of the robot's field pose, moves each one by the odometry travel plus
+ * some noise, and weights it by how well the distance sensors agree with the
+ * walls it would be looking at. Once the guesses agree with each other, their
+ * average corrects the pose estimator like any other position measurement.
+ *
+ * Field poses are inches from the field center, heading in degrees clockwise
+ * from +y, EZ's convention. An auton turns the relocalizer on with
+ * RelocalizeStart() and the field pose its odom (0, 0, 0) sits at.
+ *
+ * HOST ONLY until the side distance sensors are mounted and the mounts in
+ * DISTANCE_MOUNTS are measured: the robot build doesn't compile it or schedule
+ * its tick, and relocalize_check adds the tick itself. Landing it on the robot
+ * means moving this file and relocalizer.cpp back to Subsystem-Files, the side
+ * sensors into subsystems.cpp, and the tick into initialize()'s schedule right
+ * after odometry. It corrects the pose estimator, which the trajectory follower
+ * drives on, not EZ's own odometry, so EZ's odom motions don't see its
+ * corrections.
+ */
+
+#pragma once
+
+#include <random>
+
+#include "EZ-Template/api.hpp"
+#include "Subsystem-Files/loop_stats.hpp"
+
+/// Distance sensors facing the side walls, only in the host build for now. The back one is in subsystems.cpp.
+extern pros::Distance leftDistance;
+extern pros::Distance rightDistance;
+
+/// Where a distance sensor sits on the robot.
+struct DistanceMount {
+    pros::Distance* sensor;
+    double right;    // inches right of the tracking center
+    double forward;  // inches ahead of the tracking center
+    double facing;   // degrees clockwise from straight ahead
+};
+
+extern const DistanceMount DISTANCE_MOUNTS[];
+extern const int DISTANCE_MOUNT_COUNT;
+
+/// Inches from the field center to the inside of each wall.
+extern const double FIELD_HALF_WIDTH;
+
+/// One distance sensor reading and where the sensor sits.
+struct WallReading {
+    double right;     // mount, as in DistanceMount
+    double forward;
+    double facing;
+    double distance;  // inches
+};
+
+/// Inches along a ray from (x, y) heading `angle` degrees to the first wall.
+double WallDistance(double x, double y, double angle);
+
+/// Fixed-size particle filter over the robot's field pose. No devices, so it runs the same on a host.
+class ParticleFilter {
+  public:
+    /// Particles the filter keeps, sized so one update fits well inside a 10 ms tick.
+    static const int PARTICLE_COUNT = 200;
+
+    ParticleFilter();
+
+    /// Scatters the particles around a known field pose.
+    void Reset(ez::pose fieldPose, double spread, double headingSpread);
+
+    /// Moves every particle by robot-frame travel, inches and degrees, with motion noise.
+    void Predict(double forward, double sideways, double turn);
+
+    /**
+     * @brief Weights every particle by the readings and resamples once too few carry the weight.
+     *
+     * @return false if no particle could explain the readings, which are then ignored
+     */
+    bool Correct(const WallReading* readings, int count);
+
+    /// Weighted average pose of the particles.
+    ez::pose Estimate() const;
+
+    /// Standard deviation of the particles' position, inches.
+    double Spread() const;
+
+  private:
+    struct Particle {
+        double x, y;
+        double theta;   // radians
+        double weight;
+    };
+
+    /// Draws a new set in proportion to weight with one random offset, then evens the weights.
+    void Resample();
+
+    Particle particles[PARTICLE_COUNT];
+    Particle resampled[PARTICLE_COUNT];
+    double expected[PARTICLE_COUNT];  // each particle's wall distance for the reading being weighed
+    std::minstd_rand rng;
+    std::normal_distribution<double> gaussian{0.0, 1.0};
+    std::uniform_real_distribution<double> uniform{0.0, 1.0};
+};
+
+/// Turns on relocalization, with odom (0, 0, 0) at `fieldStart`. Call right after setting the odom pose.
+void RelocalizeStart(ez::pose fieldStart);
+
+/// Turns off relocalization.
+void RelocalizeStop();
+
+/// Where the relocalizer thinks the robot is on the field.
+ez::pose RelocalizeFieldPose();
+
+/// Moves the particles by the odometry, weights them by the distance sensors, and corrects odometry, called by the scheduler.
+void RelocalizeTick();
+
+/// Rate the relocalizer runs at.
+extern const int RELOCALIZE_PERIOD_MS;
+
+/// Timing of the relocalizer.
+extern LoopStats relocalizeLoopStats;
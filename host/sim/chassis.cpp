@@ -0,0 +1,123 @@
+/**
+ * @file chassis.cpp
+ * @brief First-order differential-drive plant with encoder, IMU, and tracking wheel feedback.
+ */
+
+#include "sim/chassis.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "sim/world.hpp"
+
+namespace sim {
+
+namespace {
+
+const double GRAVITY = 386.09;   // in/s^2
+const double STALL_CURRENT = 2500;   // mA
+
+double Sign(int port) { return port < 0 ? -1.0 : 1.0; }
+
+double Rad(double degrees) { return degrees * M_PI / 180.0; }
+
+struct SideCommand {
+    double drive = 0;   // -1..1 averaged over the side, already in robot-forward terms
+    double tau = 0;
+};
+
+SideCommand SideCommandGet(const std::vector<int>& ports, const ChassisConfig& config) {
+    SideCommand command;
+    bool stopped = true;
+    bool braking = false;
+    for (int port : ports) {
+        const MotorState& motor = Port(port).motor;
+        command.drive += Sign(port) * MotorDrive(motor) * motor.strength;
+        if (motor.mode != MotorMode::VOLTAGE || motor.voltage != 0) stopped = false;
+        if (motor.brake != 0) braking = true;
+    }
+    if (!ports.empty()) command.drive /= ports.size();
+
+    command.tau = config.timeConstant;
+    if (stopped) command.tau = braking ? config.brakeTimeConstant : config.coastTimeConstant;
+    return command;
+}
+
+void SideWrite(const std::vector<int>& ports, const ChassisConfig& config, double velocity, double drive, double dt) {
+    // Side speed in in/s back to output shaft RPM through the external gearing
+    double wheelRpm = velocity / (M_PI * config.wheelDiameter) * 60.0;
+    double maxSpeed = config.wheelRpm / 60.0 * M_PI * config.wheelDiameter;
+    for (int port : ports) {
+        MotorState& motor = Port(port).motor;
+        motor.velocity = Sign(port) * wheelRpm * motor.freeSpeed / config.wheelRpm;
+        motor.position += motor.velocity / 60.0 * 360.0 * dt;
+        motor.current = std::min<double>(motor.currentLimit, STALL_CURRENT * std::fabs(drive - velocity / maxSpeed));
+    }
+}
+
+}  // namespace
+
+Chassis::Chassis(ChassisConfig config) : config_(std::move(config)) {
+    for (int port : config_.leftPorts) Port(port).motor.plantDriven = true;
+    for (int port : config_.rightPorts) Port(port).motor.plantDriven = true;
+    PlantAdd([this](double dt) { Step(dt); });
+}
+
+void Chassis::PoseSet(ChassisPose pose) { pose_ = pose; }
+
+ChassisPose Chassis::Pose() const { return pose_; }
+
+double Chassis::LeftVelocity() const { return leftVelocity_; }
+
+double Chassis::RightVelocity() const { return rightVelocity_; }
+
+ChassisConfig& Chassis::Config() { return config_; }
+
+const ChassisConfig& Chassis::Config() const { return config_; }
+
+void Chassis::Step(double dt) {
+    double maxSpeed = config_.wheelRpm / 60.0 * M_PI * config_.wheelDiameter;
+
+    // Each side chases the speed its voltage asks for
+    SideCommand left = SideCommandGet(config_.leftPorts, config_);
+    SideCommand right = SideCommandGet(config_.rightPorts, config_);
+    double lastVelocity = (leftVelocity_ * (1.0 - config_.leftSlip) + rightVelocity_ * (1.0 - config_.rightSlip)) / 2.0;
+    leftVelocity_ += (left.drive * maxSpeed - leftVelocity_) * std::min(1.0, dt / left.tau);
+    rightVelocity_ += (right.drive * maxSpeed - rightVelocity_) * std::min(1.0, dt / right.tau);
+    SideWrite(config_.leftPorts, config_, leftVelocity_, left.drive, dt);
+    SideWrite(config_.rightPorts, config_, rightVelocity_, right.drive, dt);
+
+    // The encoders see the wheels spin, the robot only moves as far as the floor lets it
+    double leftGround = leftVelocity_ * (1.0 - config_.leftSlip);
+    double rightGround = rightVelocity_ * (1.0 - config_.rightSlip);
+
+    // Unicycle integration about the midpoint heading, clockwise positive
+    double velocity = (leftGround + rightGround) / 2.0;
+    double omega = (leftGround - rightGround) / config_.trackWidth;
+    double midTheta = Rad(pose_.theta) + omega * dt / 2.0;
+    pose_.x += velocity * std::sin(midTheta) * dt;
+    pose_.y += velocity * std::cos(midTheta) * dt;
+    pose_.theta += omega * dt * 180.0 / M_PI;
+
+    // The IMU integrates each way at its own scale
+    double counterScale = config_.imuScaleCounterClockwise > 0 ? config_.imuScaleCounterClockwise : config_.imuScale;
+    double turned = pose_.theta - imuTheta_;
+    imuYaw_ = std::isfinite(imuYaw_) ? imuYaw_ + turned * (turned < 0 ? counterScale : config_.imuScale) : pose_.theta * config_.imuScale;
+    imuTheta_ = pose_.theta;
+    ImuState& imu = Port(config_.imuPort).imu;
+    imu.yaw = imuYaw_;
+    imu.gyroZ = omega * 180.0 / M_PI * (omega < 0 ? counterScale : config_.imuScale);
+    imu.accelY = (velocity - lastVelocity) / dt / GRAVITY;
+    imu.accelX = velocity * omega / GRAVITY;
+
+    // Tracking wheels see the center's motion along their axis plus their offset swinging around it
+    for (const TrackerConfig& tracker : config_.trackers) {
+        RotationState& rotation = Port(tracker.port).rotation;
+        double inchesPerSecond = (tracker.vertical ? velocity : 0.0) + tracker.distanceToCenter * omega;
+        double centidegreesPerSecond = inchesPerSecond / (M_PI * tracker.diameter) * 36000.0;
+        rotation.velocity = (rotation.reversed ? -1.0 : 1.0) * centidegreesPerSecond;
+        rotation.position += rotation.velocity * dt;
+    }
+}
+
+}  // namespace sim
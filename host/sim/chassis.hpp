@@ -0,0 +1,83 @@
+/**
+ * @file chassis.hpp
+ * @brief Differential-drive plant that closes the loop between the drive motors and the chassis sensors.
+ *
+ * The plant claims the drive motors from the built-in motor model and integrates the
+ * robot's true pose from what the motors are commanded. Each virtual millisecond it
+ * writes the resulting motor encoders, IMU rotation, and tracking wheel rotation
+ * sensors back into the world, so EZ's odometry and exit conditions see the robot
+ * move exactly as they would on the field.
+ *
+ * Poses use EZ's convention: inches, theta in degrees clockwise from +y.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+namespace sim {
+
+/// A tracking wheel on a rotation sensor.
+struct TrackerConfig {
+    int port = 0;                    // rotation sensor port
+    double diameter = 2.0;           // in
+    double distanceToCenter = 0.0;   // in, reading gains distanceToCenter * dtheta (rad) when the robot turns
+    bool vertical = true;            // true when parallel to the drive wheels
+};
+
+/// Everything the plant needs to know about the robot.
+struct ChassisConfig {
+    std::vector<int> leftPorts;
+    std::vector<int> rightPorts;
+    int imuPort = 0;
+    double wheelDiameter = 3.25;   // in
+    double wheelRpm = 459;         // wheel RPM at full voltage
+    double trackWidth = 12.0;      // in, center to center of the drive wheels
+    double timeConstant = 0.12;    // s, loaded spin-up of one side of the drive
+    double coastTimeConstant = 0.6;  // s, spin-down of a coasting side
+    double brakeTimeConstant = 0.05; // s, spin-down of a braking side
+    double leftSlip = 0;           // fraction of the left wheels' travel lost to the floor
+    double rightSlip = 0;          // same for the right side
+    double imuScale = 1.0;         // degrees the IMU reports per true degree, off by a bit on a real gyro
+    double imuScaleCounterClockwise = 0;  // same turning counterclockwise, 0 for imuScale both ways
+    std::vector<TrackerConfig> trackers;
+};
+
+/// True robot pose in inches and degrees.
+struct ChassisPose {
+    double x = 0;
+    double y = 0;
+    double theta = 0;
+};
+
+class Chassis {
+  public:
+    /// Claims the drive motors and registers the plant with the world.
+    explicit Chassis(ChassisConfig config);
+
+    /// Teleports the robot without touching any sensor, like placing it on the field.
+    void PoseSet(ChassisPose pose);
+
+    ChassisPose Pose() const;
+
+    /// Side speeds in inches per second.
+    double LeftVelocity() const;
+    double RightVelocity() const;
+
+    /// The plant reads its config every step, so changes apply right away.
+    ChassisConfig& Config();
+    const ChassisConfig& Config() const;
+
+  private:
+    void Step(double dt);
+
+    ChassisConfig config_;
+    ChassisPose pose_;
+    double leftVelocity_ = 0;
+    double rightVelocity_ = 0;
+    double imuYaw_ = NAN;          // degrees the IMU has reported, NAN before the first step
+    double imuTheta_ = 0;          // pose heading at the last step, so a PoseSet() turn reaches the IMU too
+};
+
+}  // namespace sim
@@ -0,0 +1,70 @@
+/**
+ * @file field.cpp
+ * @brief Field walls seen by the robot's distance sensors.
+ */
+
+#include "sim/field.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "sim/world.hpp"
+
+namespace sim {
+
+namespace {
+
+const std::int32_t NO_OBJECT = 9999;   // mm, what the sensor reads with nothing in range
+
+double Rad(double degrees) { return degrees * M_PI / 180.0; }
+
+// Range from (x, y) along heading `angle` to the inside of the square
+double RangeToWall(double x, double y, double angle, double halfWidth) {
+    double dx = std::sin(Rad(angle)), dy = std::cos(Rad(angle));
+    double range = INFINITY;
+    if (dx > 1e-9) range = std::min(range, (halfWidth - x) / dx);
+    if (dx < -1e-9) range = std::min(range, (-halfWidth - x) / dx);
+    if (dy > 1e-9) range = std::min(range, (halfWidth - y) / dy);
+    if (dy < -1e-9) range = std::min(range, (-halfWidth - y) / dy);
+    return range;
+}
+
+}  // namespace
+
+Field::Field(const Chassis& chassis, FieldConfig config) : chassis_(chassis), config_(std::move(config)) {
+    PlantAdd([this](double) { Step(); });
+}
+
+ChassisPose Field::Pose() const {
+    ChassisPose local = chassis_.Pose();
+    double t = Rad(config_.start.theta);
+    return {config_.start.x + local.x * std::cos(t) + local.y * std::sin(t),
+            config_.start.y - local.x * std::sin(t) + local.y * std::cos(t),
+            config_.start.theta + local.theta};
+}
+
+FieldConfig& Field::Config() { return config_; }
+
+void Field::Step() {
+    ChassisPose pose = Pose();
+    double s = std::sin(Rad(pose.theta)), c = std::cos(Rad(pose.theta));
+    std::normal_distribution<double> noise(0.0, 1.0);
+
+    for (const DistanceSensorConfig& sensor : config_.sensors) {
+        double x = pose.x + sensor.forward * s + sensor.right * c;
+        double y = pose.y + sensor.forward * c - sensor.right * s;
+        double range = RangeToWall(x, y, pose.theta + sensor.facing, config_.halfWidth);
+
+        DistanceState& state = Port(sensor.port).distance;
+        if (!(range >= 0 && range <= config_.maxRange)) {
+            state.distance = NO_OBJECT;
+            state.confidence = 0;
+            continue;
+        }
+        range *= 1.0 + config_.noise * noise(rng_);
+        state.distance = static_cast<std::int32_t>(std::lround(std::max(0.0, range) * 25.4));
+        state.confidence = 63;
+    }
+}
+
+}  // namespace sim
@@ -0,0 +1,57 @@
+/**
+ * @file field.hpp
+ * @brief Field walls seen by the robot's distance sensors.
+ *
+ * Places the chassis plant on a square field and writes what each distance sensor
+ * would read every virtual millisecond: the range to the perimeter along the
+ * sensor's beam, with optional Gaussian noise, or 9999 mm when the wall is out of
+ * range. The wall model is kept separate from the robot's own, so the relocalizer
+ * is checked against readings it didn't compute itself.
+ */
+
+#pragma once
+
+#include <random>
+#include <vector>
+
+#include "sim/chassis.hpp"
+
+namespace sim {
+
+/// A distance sensor on the robot.
+struct DistanceSensorConfig {
+    int port = 0;
+    double right = 0;     // in right of the tracking center
+    double forward = 0;   // in ahead of the tracking center
+    double facing = 0;    // deg clockwise from straight ahead
+};
+
+/// The field and the sensors looking at it.
+struct FieldConfig {
+    ChassisPose start;              // field pose of the plant's (0, 0, 0), inches from the field center
+    double halfWidth = 70.2;        // in, field center to the inside of a wall
+    double maxRange = 78.7;         // in, 2000 mm
+    double noise = 0.0;             // fraction of the range, standard deviation
+    std::vector<DistanceSensorConfig> sensors;
+};
+
+class Field {
+  public:
+    /// Registers the plant with the world, after the chassis so it sees this step's pose.
+    Field(const Chassis& chassis, FieldConfig config);
+
+    /// Field pose of the robot.
+    ChassisPose Pose() const;
+
+    /// The plant reads its config every step, so changes apply right away.
+    FieldConfig& Config();
+
+  private:
+    void Step();
+
+    const Chassis& chassis_;
+    FieldConfig config_;
+    std::mt19937 rng_{1};
+};
+
+}  // namespace sim
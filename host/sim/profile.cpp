@@ -0,0 +1,99 @@
+/**
+ * @file profile.cpp
+ * @brief Segment recorder for one task's run.
+ */
+
+#include "sim/profile.hpp"
+
+#include <cstdarg>
+#include <cstdio>
+
+#include "sim/scheduler.hpp"
+
+namespace sim {
+
+namespace {
+
+struct Profiler {
+    bool running = false;
+    std::string taskName;
+    Task* task = nullptr;   // resolved the first time the task opens a scope
+    int depth = 0;
+    int lastMotion = -1;
+    int open = -1;          // index of the segment the outermost open scope owns
+    std::vector<ProfileSegment> segments;
+};
+
+Profiler& P() {
+    static Profiler profiler;
+    return profiler;
+}
+
+bool OnProfiledTask() {
+    Profiler& p = P();
+    if (!p.running) return false;
+    Task* current = TaskCurrent();
+    if (current == nullptr) return false;
+    if (p.task == nullptr && TaskName(current) == p.taskName) p.task = current;
+    return current == p.task;
+}
+
+}  // namespace
+
+void ProfileStart(const char* taskName) {
+    Profiler& p = P();
+    p = Profiler();
+    p.running = true;
+    p.taskName = taskName;
+}
+
+std::vector<ProfileSegment> ProfileStop() {
+    Profiler& p = P();
+    p.running = false;
+
+    // A routine cut off mid-segment (e.g. by the period ending) closes at the current time
+    if (p.open >= 0) p.segments[p.open].endMs = Now();
+    return std::move(p.segments);
+}
+
+void ProfileExitSet(const std::string& exit) {
+    Profiler& p = P();
+    if (!OnProfiledTask() || p.open < 0) return;
+    p.segments[p.open].exit = exit;
+}
+
+ProfileScope::ProfileScope(ProfileKind kind, const char* format, ...) {
+    if (!OnProfiledTask()) return;
+    Profiler& p = P();
+    nested_ = true;
+    if (p.depth++ > 0) return;
+    recorded_ = true;
+
+    char label[96];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(label, sizeof(label), format, args);
+    va_end(args);
+
+    ProfileSegment segment;
+    segment.kind = kind;
+    segment.label = label;
+    segment.startMs = Now();
+    segment.endMs = segment.startMs;
+    p.open = static_cast<int>(p.segments.size());
+    if (kind == ProfileKind::MOTION) p.lastMotion = p.open;
+    if (kind == ProfileKind::WAIT) segment.motion = p.lastMotion;
+    p.segments.push_back(segment);
+}
+
+ProfileScope::~ProfileScope() {
+    if (!nested_) return;
+    Profiler& p = P();
+    p.depth--;
+    if (recorded_ && p.running && p.open >= 0) {
+        p.segments[p.open].endMs = Now();
+        p.open = -1;
+    }
+}
+
+}  // namespace sim
@@ -0,0 +1,61 @@
+/**
+ * @file profile.hpp
+ * @brief Segment recorder that breaks one task's run into motions, waits, sleeps, and subsystem calls.
+ *
+ * The host stand-ins open a ProfileScope around every call worth timing (motion
+ * setters, pid_wait*, pros::delay, and the wrapped subsystem calls). While a profile
+ * is running, only scopes opened by the profiled task at the outermost level are
+ * recorded, so a pros::delay inside pid_wait counts toward the wait rather than as
+ * a fixed sleep of its own. When nothing is being profiled a scope costs one branch.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sim {
+
+/// What a recorded segment was spent on.
+enum class ProfileKind {
+    MOTION,      // a pid_*_set call, zero length, marks where a motion starts
+    WAIT,        // pid_wait*, attributed to the last motion
+    SLEEP,       // pros::delay and friends called straight from the routine
+    SUBSYSTEM    // a blocking or state-changing subsystem call
+};
+
+/// One top-level call made by the profiled task.
+struct ProfileSegment {
+    ProfileKind kind = ProfileKind::SLEEP;
+    std::string label;
+    std::string exit;            // how it ended, e.g. SMALL_EXIT, empty when it doesn't apply
+    std::uint32_t startMs = 0;
+    std::uint32_t endMs = 0;
+    int motion = -1;             // index of the MOTION segment a WAIT belongs to
+};
+
+/// Starts recording calls made from the task with this name (e.g. "autonomous").
+void ProfileStart(const char* taskName);
+
+/// Stops recording and returns everything recorded since ProfileStart.
+std::vector<ProfileSegment> ProfileStop();
+
+/// Records how the segment currently open on the profiled task ended.
+void ProfileExitSet(const std::string& exit);
+
+/// Opens a segment for the lifetime of the scope. The label is printf-style and only formatted when recorded.
+class ProfileScope {
+  public:
+    ProfileScope(ProfileKind kind, const char* format, ...) __attribute__((format(printf, 3, 4)));
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+  private:
+    bool nested_ = false;     // opened by the profiled task, counts toward the depth
+    bool recorded_ = false;   // outermost scope, owns a segment
+};
+
+}  // namespace sim
@@ -0,0 +1,286 @@
+/**
+ * @file scheduler.cpp
+ * @brief Cooperative ucontext scheduler driving the host build under a virtual clock.
+ *
+ * Tasks are never preempted, so a task body that spins without delaying will hang
+ * the simulation. Every loop in src/ (and in EZ-Template) delays each iteration,
+ * which is also what the V5 scheduler expects of them.
+ */
+
+#include "sim/scheduler.hpp"
+
+#include <ucontext.h>
+
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "sim/world.hpp"
+
+namespace sim {
+
+namespace {
+const std::size_t TASK_STACK_SIZE = 512 * 1024;                         // host stacks are cheap, keep EZ's printing safe
+const std::uint64_t WAKE_NEVER = std::numeric_limits<std::uint64_t>::max();  // blocked with no timeout
+}  // namespace
+
+struct Task {
+    void (*function)(void*) = nullptr;
+    void* parameters = nullptr;
+    std::uint32_t prio = 0;
+    std::string name;
+
+    TaskState state = TaskState::READY;
+    bool waitingNotify = false;
+    std::uint64_t wakeTime = 0;
+    std::uint64_t order = 0;
+    std::uint32_t notifyValue = 0;
+
+    bool started = false;
+    ucontext_t context{};
+    std::unique_ptr<char[]> stack;
+};
+
+struct Mutex {
+    const void* owner = nullptr;
+};
+
+namespace {
+
+struct Kernel {
+    std::uint32_t nowMs = 0;
+    std::uint64_t orderCounter = 0;
+    std::vector<std::unique_ptr<Task>> tasks;
+    Task* current = nullptr;
+    ucontext_t mainContext{};
+};
+
+Kernel& K() {
+    static Kernel kernel;
+    return kernel;
+}
+
+// Identity used for mutex ownership when the host main() holds a lock
+const void* Owner() {
+    return K().current ? static_cast<const void*>(K().current) : static_cast<const void*>(&K());
+}
+
+void Trampoline() {
+    Task* task = K().current;
+    task->function(task->parameters);
+    // returning from the task function deletes the task, uc_link resumes the kernel
+    task->state = TaskState::DELETED;
+}
+
+// Parks the running task and returns control to the kernel loop in RunUntil
+void SwitchOut() {
+    Task* task = K().current;
+    swapcontext(&task->context, &K().mainContext);
+}
+
+void SwitchIn(Task* task) {
+    Kernel& k = K();
+    if (!task->started) {
+        task->started = true;
+        task->stack.reset(new char[TASK_STACK_SIZE]);
+        getcontext(&task->context);
+        task->context.uc_stack.ss_sp = task->stack.get();
+        task->context.uc_stack.ss_size = TASK_STACK_SIZE;
+        task->context.uc_link = &k.mainContext;
+        makecontext(&task->context, Trampoline, 0);
+    }
+
+    task->state = TaskState::RUNNING;
+    k.current = task;
+    swapcontext(&k.mainContext, &task->context);
+    k.current = nullptr;
+
+    // A task that returned or deleted itself can release its stack now that we're off it
+    if (task->state == TaskState::DELETED) task->stack.reset();
+}
+
+bool Runnable(const Task* task) {
+    return task->state == TaskState::READY || task->state == TaskState::BLOCKED;
+}
+
+// Earliest wake time first, then higher priority, then whoever has waited longest
+Task* NextTask() {
+    Task* next = nullptr;
+    for (auto& task : K().tasks) {
+        if (!Runnable(task.get()) || task->wakeTime == WAKE_NEVER) continue;
+        if (!next || task->wakeTime < next->wakeTime ||
+            (task->wakeTime == next->wakeTime && task->prio > next->prio) ||
+            (task->wakeTime == next->wakeTime && task->prio == next->prio && task->order < next->order))
+            next = task.get();
+    }
+    return next;
+}
+
+void AdvanceTo(std::uint64_t timeMs) {
+    Kernel& k = K();
+    while (k.nowMs < timeMs) {
+        k.nowMs++;
+        WorldStep(0.001);
+    }
+}
+
+void Sleep(Task* task, std::uint64_t wakeTime, TaskState state) {
+    task->wakeTime = wakeTime;
+    task->state = state;
+    task->order = ++K().orderCounter;
+    SwitchOut();
+}
+
+}  // namespace
+
+std::uint32_t Now() { return K().nowMs; }
+
+std::uint64_t NowMicros() { return static_cast<std::uint64_t>(K().nowMs) * 1000; }
+
+Task* TaskCreate(void (*function)(void*), void* parameters, std::uint32_t prio, const char* name) {
+    Kernel& k = K();
+    auto task = std::make_unique<Task>();
+    task->function = function;
+    task->parameters = parameters;
+    task->prio = prio;
+    task->name = name ? name : "";
+    task->wakeTime = k.nowMs;
+    task->order = ++k.orderCounter;
+    k.tasks.push_back(std::move(task));
+    return k.tasks.back().get();
+}
+
+Task* TaskCurrent() { return K().current; }
+
+void TaskDelay(std::uint32_t ms) {
+    Task* task = K().current;
+    if (!task) {
+        RunUntil(K().nowMs + ms);
+        return;
+    }
+    Sleep(task, static_cast<std::uint64_t>(K().nowMs) + ms, TaskState::READY);
+}
+
+void TaskDelayUntil(std::uint32_t* prevTime, std::uint32_t delta) {
+    std::uint32_t wake = *prevTime + delta;
+    *prevTime = wake;
+    if (wake > K().nowMs) TaskDelay(wake - K().nowMs);
+    else TaskDelay(0);
+}
+
+void TaskSuspend(Task* task) {
+    if (!task || task->state == TaskState::DELETED) return;
+    task->state = TaskState::SUSPENDED;
+    if (task == K().current) SwitchOut();
+}
+
+void TaskResume(Task* task) {
+    // Like FreeRTOS, resuming a task that is only delayed does nothing
+    if (!task || task->state != TaskState::SUSPENDED) return;
+    task->state = TaskState::READY;
+    task->wakeTime = K().nowMs;
+    task->order = ++K().orderCounter;
+}
+
+void TaskDelete(Task* task) {
+    if (!task || task->state == TaskState::DELETED) return;
+    task->state = TaskState::DELETED;
+    if (task == K().current) SwitchOut();
+}
+
+TaskState TaskStateGet(Task* task) {
+    if (task->state == TaskState::READY && task->wakeTime > K().nowMs) return TaskState::BLOCKED;
+    return task->state;
+}
+
+std::uint32_t TaskPriorityGet(Task* task) { return task->prio; }
+
+void TaskPrioritySet(Task* task, std::uint32_t prio) { task->prio = prio; }
+
+const std::string& TaskName(Task* task) { return task->name; }
+
+std::uint32_t TaskCount() {
+    std::uint32_t count = 0;
+    for (auto& task : K().tasks)
+        if (task->state != TaskState::DELETED) count++;
+    return count;
+}
+
+Task* TaskByName(const char* name) {
+    for (auto& task : K().tasks)
+        if (task->state != TaskState::DELETED && task->name == name) return task.get();
+    return nullptr;
+}
+
+std::uint32_t TaskNotify(Task* task) {
+    if (!task) return 0;
+    task->notifyValue++;
+    if (task->waitingNotify && task->state == TaskState::BLOCKED) {
+        task->state = TaskState::READY;
+        task->wakeTime = K().nowMs;
+    }
+    return 1;
+}
+
+std::uint32_t TaskNotifyTake(bool clearOnExit, std::uint32_t timeout) {
+    Task* task = K().current;
+    if (!task) return 0;
+
+    if (task->notifyValue == 0 && timeout > 0) {
+        task->waitingNotify = true;
+        Sleep(task, timeout == std::numeric_limits<std::uint32_t>::max() ? WAKE_NEVER : K().nowMs + timeout, TaskState::BLOCKED);
+        task->waitingNotify = false;
+    }
+
+    std::uint32_t value = task->notifyValue;
+    if (value > 0) task->notifyValue = clearOnExit ? 0 : value - 1;
+    return value;
+}
+
+bool TaskNotifyClear(Task* task) {
+    bool pending = task && task->notifyValue > 0;
+    if (task) task->notifyValue = 0;
+    return pending;
+}
+
+void TaskJoin(Task* task) {
+    while (task && task->state != TaskState::DELETED)
+        TaskDelay(1);
+}
+
+Mutex* MutexCreate() { return new Mutex(); }
+
+bool MutexTake(Mutex* mutex, std::uint32_t timeout) {
+    std::uint32_t start = K().nowMs;
+    while (mutex->owner && mutex->owner != Owner()) {
+        if (K().nowMs - start >= timeout) return false;
+        TaskDelay(1);
+    }
+    mutex->owner = Owner();
+    return true;
+}
+
+bool MutexGive(Mutex* mutex) {
+    if (mutex->owner != Owner()) return false;
+    mutex->owner = nullptr;
+    return true;
+}
+
+void MutexDelete(Mutex* mutex) { delete mutex; }
+
+void RunUntil(std::uint32_t untilMs) {
+    if (K().current) return;
+
+    while (true) {
+        Task* next = NextTask();
+        if (!next || next->wakeTime > untilMs) {
+            AdvanceTo(untilMs);
+            return;
+        }
+        AdvanceTo(next->wakeTime);
+        SwitchIn(next);
+    }
+}
+
+}  // namespace sim
@@ -0,0 +1,83 @@
+/**
+ * @file scheduler.hpp
+ * @brief Deterministic virtual-time scheduler backing the host pros::Task stand-in.
+ *
+ * Every pros::Task created by the robot code becomes a cooperative coroutine with
+ * its own stack. Tasks only give up the CPU inside pros::delay / notify_take / mutex
+ * waits, so a run is fully deterministic: the scheduler always resumes the task with
+ * the earliest wake time (ties broken by priority, then round-robin order) and jumps
+ * the virtual clock straight to it, stepping the device world once per millisecond.
+ *
+ * Code that is not inside a task (the host tool's main()) drives the scheduler
+ * implicitly: a pros::delay from main() runs every task up to the wake time.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace sim {
+
+/// Opaque handle for a simulated RTOS task.
+struct Task;
+
+/// Task lifecycle, mirrors pros::task_state_e_t.
+enum class TaskState { RUNNING, READY, BLOCKED, SUSPENDED, DELETED };
+
+/// Current virtual time in milliseconds since boot.
+std::uint32_t Now();
+
+/// Current virtual time in microseconds since boot.
+std::uint64_t NowMicros();
+
+/// Creates a task. It first runs the next time the scheduler is driven.
+Task* TaskCreate(void (*function)(void*), void* parameters, std::uint32_t prio, const char* name);
+
+/// Returns the running task, or nullptr on the host main context.
+Task* TaskCurrent();
+
+/// Sleeps the caller; from main() this runs every task until the wake time.
+void TaskDelay(std::uint32_t ms);
+
+/// Sleeps until *prevTime + delta and advances *prevTime, like task_delay_until.
+void TaskDelayUntil(std::uint32_t* prevTime, std::uint32_t delta);
+
+void TaskSuspend(Task* task);
+void TaskResume(Task* task);
+void TaskDelete(Task* task);
+TaskState TaskStateGet(Task* task);
+std::uint32_t TaskPriorityGet(Task* task);
+void TaskPrioritySet(Task* task, std::uint32_t prio);
+const std::string& TaskName(Task* task);
+std::uint32_t TaskCount();
+Task* TaskByName(const char* name);
+
+/// Increments the task's notification value and wakes it if it is blocked on it.
+std::uint32_t TaskNotify(Task* task);
+
+/// Waits for a notification, returning the value before it was taken (0 on timeout).
+std::uint32_t TaskNotifyTake(bool clearOnExit, std::uint32_t timeout);
+
+/// Clears a pending notification, returning true if one was pending.
+bool TaskNotifyClear(Task* task);
+
+/// Blocks until the task is deleted or returns from its function.
+void TaskJoin(Task* task);
+
+/// Lock backing pros::Mutex, owned by one task at a time.
+struct Mutex;
+Mutex* MutexCreate();
+bool MutexTake(Mutex* mutex, std::uint32_t timeout);
+bool MutexGive(Mutex* mutex);
+void MutexDelete(Mutex* mutex);
+
+/**
+ * @brief Runs every task until the virtual clock reaches `untilMs`.
+ *
+ * Equivalent to TaskDelay(untilMs - Now()) from main(). Returns early if called
+ * from inside a task (tasks cannot drive the scheduler).
+ */
+void RunUntil(std::uint32_t untilMs);
+
+}  // namespace sim
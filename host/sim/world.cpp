@@ -0,0 +1,108 @@
+/**
+ * @file world.cpp
+ * @brief Device state storage and the built-in first-order motor model.
+ */
+
+#include "sim/world.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace sim {
+
+namespace {
+
+// Motor model constants
+const double MOTOR_TIME_CONSTANT = 0.05;   // s, spin-up with no load
+const double COAST_TIME_CONSTANT = 0.25;   // s, spin-down when coasting
+const double BRAKE_TIME_CONSTANT = 0.02;   // s, spin-down when braking/holding
+const double STALL_CURRENT = 2500;         // mA
+const double POSITION_GAIN = 4.0;          // RPM per degree of error for move_absolute
+const double NOMINAL_BATTERY = 12800;      // mV the free speeds were measured at
+
+struct World {
+    std::array<SmartPort, SMART_PORT_COUNT + 1> ports;
+    std::map<std::pair<int, int>, AdiPort> adi;
+    std::array<ControllerState, 2> controllers;
+    std::array<std::string, 8> lcd;
+    CompetitionState competition;
+    BatteryState battery;
+    std::vector<std::function<void(double)>> plants;
+};
+
+World& W() {
+    static World world;
+    return world;
+}
+
+void MotorStep(MotorState& motor, double dt) {
+    double freeSpeed = motor.freeSpeed * motor.strength;
+    double drive = MotorDrive(motor);
+    double target = drive * freeSpeed;
+
+    double tau = MOTOR_TIME_CONSTANT;
+    if (motor.mode == MotorMode::VOLTAGE && motor.voltage == 0)
+        tau = motor.brake == 0 ? COAST_TIME_CONSTANT : BRAKE_TIME_CONSTANT;
+
+    motor.velocity += (target - motor.velocity) * std::min(1.0, dt / tau);
+    motor.position += motor.velocity / 60.0 * 360.0 * dt;
+    motor.current = std::min<double>(motor.currentLimit, STALL_CURRENT * std::fabs(drive - motor.velocity / freeSpeed));
+}
+
+}  // namespace
+
+SmartPort& Port(int port) {
+    port = std::abs(port);
+    return W().ports[std::clamp(port, 0, SMART_PORT_COUNT)];
+}
+
+AdiPort& Adi(int smartPort, int adiPort) { return W().adi[{smartPort, adiPort}]; }
+
+ControllerState& Controller(int id) { return W().controllers[id == 0 ? 0 : 1]; }
+
+CompetitionState& Competition() { return W().competition; }
+
+BatteryState& Battery() { return W().battery; }
+
+std::array<std::string, 8>& Lcd() { return W().lcd; }
+
+void PlantAdd(std::function<void(double dt)> step) { W().plants.push_back(std::move(step)); }
+
+void PlantClear() { W().plants.clear(); }
+
+double MotorDrive(const MotorState& motor) {
+    double drive = 0;
+    double freeSpeed = motor.freeSpeed * motor.strength;
+    switch (motor.mode) {
+        case MotorMode::VOLTAGE:
+            drive = motor.voltage / 12000.0;
+            if (motor.voltageLimit > 0) drive = std::clamp(drive, -motor.voltageLimit / 12000.0, motor.voltageLimit / 12000.0);
+            break;
+        case MotorMode::VELOCITY:
+            // the motor's internal velocity loop, feedforward plus a little feedback
+            drive = (motor.targetVelocity + 0.5 * (motor.targetVelocity - motor.velocity)) / freeSpeed;
+            break;
+        case MotorMode::ABSOLUTE: {
+            double limit = std::fabs(motor.targetVelocity);
+            double desired = std::clamp(POSITION_GAIN * (motor.targetPosition - motor.position), -limit, limit);
+            drive = (desired + 0.5 * (desired - motor.velocity)) / freeSpeed;
+            break;
+        }
+    }
+    drive *= std::min(1.0, W().battery.voltage / NOMINAL_BATTERY);
+    return std::clamp(drive, -1.0, 1.0);
+}
+
+void WorldStep(double dt) {
+    World& world = W();
+    for (auto& port : world.ports)
+        if (!port.motor.plantDriven) MotorStep(port.motor, dt);
+
+    for (auto& plant : world.plants)
+        plant(dt);
+}
+
+}  // namespace sim
@@ -0,0 +1,159 @@
+/**
+ * @file world.hpp
+ * @brief Simulated V5 device state shared by the host PROS stand-in and plant models.
+ *
+ * Every smart port carries the state for each device kind the robot might plug into
+ * it, so the stand-in classes simply read and write the slot matching their type.
+ * Motors integrate a first-order voltage-to-speed model each virtual millisecond
+ * unless a plant (e.g. the chassis model) has claimed them and writes their
+ * position and velocity itself. Sensor readings are either written by plants or
+ * poked directly by a host tool.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace sim {
+
+/// Number of smart ports plus the internal ADI port (22).
+const int SMART_PORT_COUNT = 22;
+
+/// How a motor was last commanded, mirrors the V5 motor's control modes.
+enum class MotorMode { VOLTAGE, VELOCITY, ABSOLUTE };
+
+/// Physical motor state, always in output-shaft degrees and RPM (before port reversal).
+struct MotorState {
+    MotorMode mode = MotorMode::VOLTAGE;
+    double voltage = 0;          // commanded mV, -12000..12000
+    double targetVelocity = 0;   // commanded RPM for VELOCITY/ABSOLUTE
+    double targetPosition = 0;   // commanded degrees for ABSOLUTE
+    double position = 0;         // degrees
+    double velocity = 0;         // RPM
+    double zero = 0;             // degrees subtracted from position when reading
+    double current = 0;          // mA
+    double freeSpeed = 200;      // RPM for the installed cartridge
+    double countsPerRev = 900;   // encoder counts for the installed cartridge
+    int gearset = 1;             // pros::MotorGears as int
+    int units = 0;               // pros::MotorUnits as int
+    int brake = 0;               // pros::MotorBrake as int
+    int currentLimit = 2500;     // mA
+    int voltageLimit = 0;        // mV, 0 = unlimited
+    double strength = 1.0;       // multiplier on free speed, for worn or weak motors
+    bool plantDriven = false;    // true when a plant owns position/velocity
+};
+
+/// Rotation sensor state in centidegrees.
+struct RotationState {
+    double position = 0;   // physical centidegrees written by a plant
+    double offset = 0;     // subtracted from the physical position when reading
+    double velocity = 0;   // centidegrees per second
+    bool reversed = false;
+    std::uint32_t dataRate = 10;
+};
+
+/// Inertial sensor state; `yaw` is the true clockwise rotation in degrees.
+struct ImuState {
+    double yaw = 0;
+    double rotationOffset = 0;
+    double headingOffset = 0;
+    double pitch = 0, roll = 0;
+    double accelX = 0, accelY = 0, accelZ = 1;   // g
+    double gyroZ = 0;                            // deg/s
+    bool calibrating = false;
+};
+
+/// Optical sensor state.
+struct OpticalState {
+    double hue = 0;
+    double saturation = 0;
+    double brightness = 0;
+    std::int32_t proximity = 0;
+    double integrationTime = 100;
+    std::int32_t ledPwm = 0;
+};
+
+/// Distance sensor state.
+struct DistanceState {
+    std::int32_t distance = 0;     // mm
+    std::int32_t confidence = 63;
+    std::int32_t objectSize = 0;
+    double objectVelocity = 0;
+};
+
+/// Everything that could be plugged into one smart port.
+struct SmartPort {
+    MotorState motor;
+    RotationState rotation;
+    ImuState imu;
+    OpticalState optical;
+    DistanceState distance;
+};
+
+/// One three-wire port, on the brain (smart port 22) or on an expander.
+struct AdiPort {
+    std::int32_t value = 0;
+    std::int32_t config = 0;
+    std::int32_t offset = 0;     // subtracted from value when reading an encoder
+    bool lastPressed = false;    // value at the last DigitalIn::get_new_press
+};
+
+/// A V5 controller's inputs and its last printed text.
+struct ControllerState {
+    std::array<std::int32_t, 4> analog{};
+    std::array<bool, 18> digital{};
+    std::array<bool, 18> lastRead{};   // button state at the last get_digital_new_press
+    std::array<std::string, 3> lines;
+    std::string lastRumble;
+    bool connected = true;
+};
+
+/// Field control state reported through pros::competition.
+struct CompetitionState {
+    bool autonomous = false;
+    bool disabled = false;
+    bool connected = false;
+};
+
+/// Brain battery state.
+struct BatteryState {
+    double voltage = 12800;   // mV
+    double capacity = 100;    // percent
+};
+
+/// Returns the state for a smart port, port sign is ignored.
+SmartPort& Port(int port);
+
+/// Returns the state for an ADI port (1-8) on the given smart port (22 = brain).
+AdiPort& Adi(int smartPort, int adiPort);
+
+/// Returns the controller state (0 = master, 1 = partner).
+ControllerState& Controller(int id);
+
+CompetitionState& Competition();
+BatteryState& Battery();
+
+/// Last text printed to each LLEMU line.
+std::array<std::string, 8>& Lcd();
+
+/**
+ * @brief Registers a plant stepped once per virtual millisecond.
+ *
+ * Plants run after the built-in motor model, so they may override the state of any
+ * motor they have marked plantDriven and write whatever sensors they model.
+ */
+void PlantAdd(std::function<void(double dt)> step);
+
+/// Removes every registered plant.
+void PlantClear();
+
+/// Advances motors and plants by dt seconds, called by the scheduler.
+void WorldStep(double dt);
+
+/// Motor voltage fraction (-1..1) after battery sag, used by plants driving their own motors.
+double MotorDrive(const MotorState& motor);
+
+}  // namespace sim
@@ -0,0 +1,211 @@
+/**
+ * @file spline.cpp
+ * @brief Host stand-in for squiggles::SplineGenerator: quintic splines with a time-optimal velocity profile.
+ *
+ * Same steps as okapilib's squiggles: each pair of waypoints gets an x and a y
+ * quintic over a whole number of seconds, the shortest duration whose
+ * acceleration and jerk stay inside the constraints, then the curve is given the
+ * fastest velocity profile the physical model allows, forward and backward
+ * passes over its arc length, and sampled every dt. Waypoints without a velocity
+ * are passed through at speed rather than stopped at, so a path with several
+ * waypoints is profiled as one. Numbers differ from the real library by a little;
+ * shapes and timing are close enough to tune against.
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include "spline.hpp"
+
+namespace squiggles {
+
+SplineGenerator::SplineGenerator(Constraints iconstraints, std::shared_ptr<PhysicalModel> imodel, double idt)
+    : constraints(iconstraints), model(imodel), dt(idt) {}
+
+std::vector<ProfilePoint> SplineGenerator::generate(std::vector<Pose> iwaypoints, bool fast) {
+    std::vector<ControlVector> vectors(iwaypoints.begin(), iwaypoints.end());
+    return _generate(vectors.begin(), vectors.end(), fast);
+}
+
+std::vector<ProfilePoint> SplineGenerator::generate(std::initializer_list<Pose> iwaypoints, bool fast) {
+    return generate(std::vector<Pose>(iwaypoints), fast);
+}
+
+std::vector<ProfilePoint> SplineGenerator::generate(std::vector<ControlVector> iwaypoints) {
+    return _generate(iwaypoints.begin(), iwaypoints.end(), false);
+}
+
+std::vector<ProfilePoint> SplineGenerator::generate(std::initializer_list<ControlVector> iwaypoints) {
+    return generate(std::vector<ControlVector>(iwaypoints));
+}
+
+template <class Iter>
+std::vector<ProfilePoint> SplineGenerator::_generate(Iter start, Iter end, bool fast) {
+    if (end - start < 2) return {};
+
+    std::vector<GeneratedPoint> raw;
+    for (Iter i = start; i + 1 != end; ++i) {
+        std::vector<GeneratedPoint> segment = gen_raw_path(*i, *(i + 1), fast);
+        raw.insert(raw.end(), segment.begin() + (raw.empty() ? 0 : 1), segment.end());
+    }
+
+    double start_vel = std::isnan(start->vel) ? 0.0 : start->vel;
+    double end_vel = std::isnan((end - 1)->vel) ? 0.0 : (end - 1)->vel;
+    return parameterize(*start, *(end - 1), raw, start_vel, end_vel, 0.0);
+}
+
+std::vector<SplineGenerator::GeneratedPoint> SplineGenerator::gen_raw_path(ControlVector& start, ControlVector& end, bool fast) {
+    return gradient_descent(start, end, fast);
+}
+
+QuinticPolynomial SplineGenerator::get_x_spline(const ControlVector start, const ControlVector end, const double duration) {
+    return QuinticPolynomial(start.pose.x, start.vel * std::cos(start.pose.yaw), start.accel * std::cos(start.pose.yaw), end.pose.x,
+                             end.vel * std::cos(end.pose.yaw), end.accel * std::cos(end.pose.yaw), duration);
+}
+
+QuinticPolynomial SplineGenerator::get_y_spline(const ControlVector start, const ControlVector end, const double duration) {
+    return QuinticPolynomial(start.pose.y, start.vel * std::sin(start.pose.yaw), start.accel * std::sin(start.pose.yaw), end.pose.y,
+                             end.vel * std::sin(end.pose.yaw), end.accel * std::sin(end.pose.yaw), duration);
+}
+
+std::vector<SplineGenerator::GeneratedVector> SplineGenerator::gen_single_raw_path(ControlVector start, ControlVector end, int duration,
+                                                                                   double start_vel, double end_vel) {
+    start.vel = start_vel;
+    end.vel = end_vel;
+    QuinticPolynomial x = get_x_spline(start, end, duration);
+    QuinticPolynomial y = get_y_spline(start, end, duration);
+
+    std::vector<GeneratedVector> path;
+    int steps = std::max(1, (int)std::ceil(duration / dt));
+    for (int i = 0; i <= steps; i++) {
+        double t = (double)duration * i / steps;
+        double dx = x.calc_first_derivative(t), dy = y.calc_first_derivative(t);
+        double ddx = x.calc_second_derivative(t), ddy = y.calc_second_derivative(t);
+        double dddx = x.calc_third_derivative(t), dddy = y.calc_third_derivative(t);
+        double vel = std::hypot(dx, dy);
+        double curvature = vel > K_EPSILON ? (dx * ddy - dy * ddx) / (vel * vel * vel) : 0.0;
+        double accel = vel > K_EPSILON ? (dx * ddx + dy * ddy) / vel : std::hypot(ddx, ddy);
+        Pose pose(x.calc_point(t), y.calc_point(t), vel > K_EPSILON ? std::atan2(dy, dx) : start.pose.yaw);
+        path.emplace_back(GeneratedPoint(pose, curvature), vel, accel, std::hypot(dddx, dddy));
+    }
+    return path;
+}
+
+std::vector<SplineGenerator::GeneratedPoint> SplineGenerator::gradient_descent(ControlVector& start, ControlVector& end, bool fast) {
+    double start_vel = std::isnan(start.vel) || start.vel == 0 ? K_DEFAULT_VEL : start.vel;
+    double end_vel = std::isnan(end.vel) || end.vel == 0 ? K_DEFAULT_VEL : end.vel;
+
+    // The shortest duration inside the acceleration and jerk limits, or the smoothest of them unless fast
+    std::vector<GeneratedVector> best;
+    double bestCost = std::numeric_limits<double>::max();
+    for (int duration = T_MIN; duration <= T_MAX; duration++) {
+        std::vector<GeneratedVector> path = gen_single_raw_path(start, end, duration, start_vel, end_vel);
+        double cost = 0;
+        bool fits = true;
+        for (std::size_t i = 1; i < path.size(); i++) {
+            const GeneratedVector& point = path[i];
+            if (std::fabs(point.accel) > constraints.max_accel || point.jerk > constraints.max_jerk ||
+                std::fabs(point.point.curvature) > constraints.max_curvature)
+                fits = false;
+            double ds = point.point.pose.dist(path[i - 1].point.pose);
+            cost += point.point.curvature * point.point.curvature * ds;
+        }
+        if (!fits && duration < T_MAX) continue;
+        if (cost < bestCost) {
+            bestCost = cost;
+            best = path;
+        }
+        if (fast && fits) break;
+    }
+
+    std::vector<GeneratedPoint> points;
+    for (const GeneratedVector& vector : best) points.push_back(vector.point);
+    return points;
+}
+
+std::vector<ProfilePoint> SplineGenerator::parameterize(const ControlVector start, const ControlVector end,
+                                                        const std::vector<GeneratedPoint>& raw_path, const double preferred_start_vel,
+                                                        const double preferred_end_vel, const double start_time) {
+    if (raw_path.empty()) return {};
+
+    // Limits at every point of the curve, arc length from the start
+    std::vector<ConstrainedState> states;
+    double distance = 0;
+    for (std::size_t i = 0; i < raw_path.size(); i++) {
+        if (i > 0) {
+            double ds = raw_path[i].pose.dist(raw_path[i - 1].pose);
+            if (ds < K_EPSILON) continue;
+            distance += ds;
+        }
+        Constraints limits = model->constraints(raw_path[i].pose, raw_path[i].curvature, constraints.max_vel);
+        states.emplace_back(raw_path[i].pose, raw_path[i].curvature, distance, std::min(constraints.max_vel, limits.max_vel),
+                            std::max(constraints.min_accel, limits.min_accel), std::min(constraints.max_accel, limits.max_accel));
+    }
+    states.front().max_vel = std::min(states.front().max_vel, preferred_start_vel);
+    states.back().max_vel = std::min(states.back().max_vel, preferred_end_vel);
+
+    for (std::size_t i = 1; i < states.size(); i++) forward_pass(&states[i - 1], &states[i]);
+    for (std::size_t i = states.size() - 1; i > 0; i--) backward_pass(&states[i - 1], &states[i]);
+
+    // Time at each state, then resampled every dt
+    std::vector<ProfilePoint> timed = integrate_constrained_states(states);
+    std::vector<ProfilePoint> output;
+    std::size_t segment = 0;
+    double endTime = timed.back().time;
+    for (double t = 0; t < endTime + dt; t += dt) {
+        double time = std::min(t, endTime);
+        while (segment + 2 < timed.size() && timed[segment + 1].time < time) segment++;
+        const ProfilePoint& from = timed[segment];
+        const ProfilePoint& to = timed[std::min(segment + 1, timed.size() - 1)];
+        double span = to.time - from.time;
+        double i = span > K_EPSILON ? std::clamp((time - from.time) / span, 0.0, 1.0) : 1.0;
+
+        // Constant acceleration across the segment: speed is linear in time, distance quadratic
+        double vel = from.vector.vel + (to.vector.vel - from.vector.vel) * i;
+        double travelled = (from.vector.vel + vel) / 2.0 * i;
+        double whole = (from.vector.vel + to.vector.vel) / 2.0;
+        double along = whole > K_EPSILON ? travelled / whole : i;
+        Pose pose(from.vector.pose.x + (to.vector.pose.x - from.vector.pose.x) * along,
+                  from.vector.pose.y + (to.vector.pose.y - from.vector.pose.y) * along,
+                  from.vector.pose.yaw + std::remainder(to.vector.pose.yaw - from.vector.pose.yaw, 2.0 * M_PI) * along);
+        double curvature = from.curvature + (to.curvature - from.curvature) * along;
+        double accel = span > K_EPSILON ? (to.vector.vel - from.vector.vel) / span : 0.0;
+        output.emplace_back(ControlVector(pose, vel, accel), model->linear_to_wheel_vels(vel, curvature), curvature, start_time + time);
+        if (time >= endTime) break;
+    }
+    (void)start;
+    (void)end;
+    return output;
+}
+
+std::vector<ProfilePoint> SplineGenerator::integrate_constrained_states(std::vector<ConstrainedState> constrainedStates) {
+    std::vector<ProfilePoint> points;
+    double time = 0;
+    for (std::size_t i = 0; i < constrainedStates.size(); i++) {
+        const ConstrainedState& state = constrainedStates[i];
+        if (i > 0) {
+            const ConstrainedState& last = constrainedStates[i - 1];
+            double ds = state.distance - last.distance;
+            double speed = (last.max_vel + state.max_vel) / 2.0;
+            time += speed > K_EPSILON ? ds / speed : std::sqrt(2.0 * ds / std::max(state.max_accel, K_EPSILON));
+        }
+        points.emplace_back(ControlVector(state.pose, state.max_vel), std::vector<double>{}, state.curvature, time);
+    }
+    return points;
+}
+
+void SplineGenerator::forward_pass(ConstrainedState* predecessor, ConstrainedState* successor) {
+    double ds = successor->distance - predecessor->distance;
+    successor->max_vel = std::min(successor->max_vel, vf(predecessor->max_vel, predecessor->max_accel, ds));
+}
+
+void SplineGenerator::backward_pass(ConstrainedState* predecessor, ConstrainedState* successor) {
+    double ds = successor->distance - predecessor->distance;
+    predecessor->max_vel = std::min(predecessor->max_vel, vf(successor->max_vel, -successor->min_accel, ds));
+}
+
+double SplineGenerator::vf(double vi, double a, double ds) { return std::sqrt(std::max(0.0, vi * vi + 2.0 * a * ds)); }
+
+double SplineGenerator::ai(double vf, double vi, double s) { return s > K_EPSILON ? (vf * vf - vi * vi) / (2.0 * s) : 0.0; }
+
+}  // namespace squiggles
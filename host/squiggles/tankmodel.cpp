@@ -0,0 +1,37 @@
+/**
+ * @file tankmodel.cpp
+ * @brief Host stand-in for squiggles::TankModel: the outer wheel of a turn sets the speed limit.
+ */
+
+#include <limits>
+
+#include "physicalmodel/tankmodel.hpp"
+
+namespace squiggles {
+
+TankModel::TankModel(double itrack_width, Constraints ilinear_constraints)
+    : track_width(itrack_width), linear_constraints(ilinear_constraints) {}
+
+Constraints TankModel::constraints(const Pose pose, double curvature, double vel) {
+    auto [min_accel, max_accel] = accel_constraint(pose, curvature, vel);
+    return Constraints(vel_constraint(pose, curvature, vel), max_accel, linear_constraints.max_jerk, linear_constraints.max_curvature, min_accel);
+}
+
+std::vector<double> TankModel::linear_to_wheel_vels(double lin_vel, double curvature) {
+    return {lin_vel * (2.0 - curvature * track_width) / 2.0, lin_vel * (2.0 + curvature * track_width) / 2.0};
+}
+
+std::string TankModel::to_string() const {
+    return "TankModel {track_width: " + std::to_string(track_width) + ", linear_constraints: " + linear_constraints.to_string() + "}";
+}
+
+double TankModel::vel_constraint([[maybe_unused]] const Pose pose, double curvature, [[maybe_unused]] double vel) {
+    return linear_constraints.max_vel / (1.0 + std::fabs(curvature) * track_width / 2.0);
+}
+
+std::tuple<double, double> TankModel::accel_constraint([[maybe_unused]] const Pose pose, double curvature, [[maybe_unused]] double vel) const {
+    double scale = 1.0 + std::fabs(curvature) * track_width / 2.0;
+    return {linear_constraints.min_accel / scale, linear_constraints.max_accel / scale};
+}
+
+}  // namespace squiggles
@@ -0,0 +1,90 @@
+/**
+ * @file actions_check.cpp
+ * @brief Checks what a 0 and a NO_TIMEOUT duration or timeout do to each action start and wait.
+ *
+ * Usage: actions_check
+ *
+ * Every start and every wait reads its time limit the same way: 0 is no time at
+ * all and NO_TIMEOUT is no limit. Each case runs inside an auton on the booted
+ * robot, so the scheduler advances the actions as it does on the field, and the
+ * report lists each case with how long it took in match time. Exits 1 if any
+ * case fails.
+ */
+
+#include <cstdio>
+#include <vector>
+
+#include "harness/harness.hpp"
+#include "main.h"
+#include "subsystems.hpp"
+
+namespace {
+
+const int TICK_SLACK_MS = 2 * SCHEDULER_SLOT_MS;   // an action ends within a couple of scheduler slots
+const int WAIT_MS = 100;
+
+struct Case {
+    const char* name;
+    bool passed;
+    std::uint32_t ms;
+};
+
+std::vector<Case> cases;
+
+void Check(const char* name, bool passed, std::uint32_t start) { cases.push_back({name, passed, pros::millis() - start}); }
+
+bool Never() { return false; }
+
+void Checks() {
+    std::uint32_t start = pros::millis();
+    ActionHandle watch = Watch(Never, 0);
+    ActionExit exit = watch.Wait(TICK_SLACK_MS * 4);
+    Check("Watch(0) ends on the next tick", exit == ActionExit::TIME_UP && pros::millis() - start <= TICK_SLACK_MS, start);
+
+    start = pros::millis();
+    ActionHandle timed = RunFor(nullptr, {}, {}, 0);
+    exit = timed.Wait(TICK_SLACK_MS * 4);
+    Check("RunFor(0) ends on the next tick", exit == ActionExit::TIME_UP && pros::millis() - start <= TICK_SLACK_MS, start);
+
+    ActionHandle forever = Watch(Never, NO_TIMEOUT);
+    start = pros::millis();
+    exit = forever.Wait(0);
+    Check("Wait(0) returns at once", exit == ActionExit::RUNNING && pros::millis() == start, start);
+
+    start = pros::millis();
+    bool all = WaitAll({forever}, 0);
+    Check("WaitAll(0) returns at once", !all && pros::millis() == start, start);
+
+    start = pros::millis();
+    int any = WaitAny({forever}, 0);
+    Check("WaitAny(0) returns at once", any == -1 && pros::millis() == start, start);
+
+    start = pros::millis();
+    exit = forever.Wait(WAIT_MS);
+    Check("Watch(NO_TIMEOUT) outlasts a timed wait", exit == ActionExit::RUNNING && pros::millis() - start >= (std::uint32_t)WAIT_MS, start);
+
+    start = pros::millis();
+    forever.Cancel();
+    exit = forever.Wait();
+    Check("Wait(NO_TIMEOUT) returns once cancelled", exit == ActionExit::CANCELLED && pros::millis() == start, start);
+}
+
+}  // namespace
+
+int main() {
+    harness::Boot();
+
+    harness::Options options;
+    options.limitMs = 5000;
+    options.routine = Checks;
+    harness::RunAutonInProcess(options);
+
+    int failed = 0;
+    printf("Action time limits\n");
+    for (const Case& result : cases) {
+        printf("  %-42s %4u ms  %s\n", result.name, result.ms, result.passed ? "ok" : "FAILED");
+        failed += !result.passed;
+    }
+    if (cases.empty()) printf("  the checks never ran\n");
+    return failed > 0 || cases.empty() ? 1 : 0;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file auton_montecarlo.cpp
+ * @brief Runs one auton thousands of times on a randomized robot and reports the spread.
+ *
+ * Usage: auton_montecarlo [page] [limit_ms] [runs] [jobs] [seed]
+ *
+ * Every run places the robot slightly off its start pose and draws its own wheel
+ * slip, per-motor strength, and battery voltage. Runs are spread over every core
+ * (or `jobs` workers). The report gives p50/p95/p99 completion time and how far the
+ * robot ended from where an unperturbed run ends, which is what to watch when
+ * tightening pid_drive_exit_condition_set / pid_turn_exit_condition_set.
+ *
+ * Run i always draws from seed + i, so a bad run from the worst list can be
+ * replayed on its own with `auton_montecarlo <page> <limit> 1 1 <seed + i>`.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "harness/harness.hpp"
+#include "sim/world.hpp"
+
+namespace {
+
+// Spread of each randomized quantity
+const double START_XY_SIGMA = 0.5;         // in, placement error on each axis
+const double START_THETA_SIGMA = 1.0;      // deg, placement error in heading
+const double SLIP_MAX = 0.05;              // fraction, each side slips uniformly 0..SLIP_MAX
+const double STRENGTH_SIGMA = 0.04;        // fraction, per-motor free speed variation
+const double STRENGTH_MIN = 0.85;
+const double BATTERY_MIN = 11800;          // mV, end of a long practice
+const double BATTERY_MAX = 12900;          // mV, fresh off the charger
+const int WORST_SHOWN = 5;
+
+/// What a run drew, kept by the parent so the worst runs can be explained.
+struct Draw {
+    sim::ChassisPose start;
+    double leftSlip = 0, rightSlip = 0;
+    double battery = 0;
+};
+
+Draw DrawRun(unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> xy(0, START_XY_SIGMA), theta(0, START_THETA_SIGMA);
+    std::uniform_real_distribution<double> slip(0, SLIP_MAX), battery(BATTERY_MIN, BATTERY_MAX);
+    Draw draw;
+    draw.start = {xy(rng), xy(rng), theta(rng)};
+    draw.leftSlip = slip(rng);
+    draw.rightSlip = slip(rng);
+    draw.battery = battery(rng);
+    return draw;
+}
+
+// Runs in the forked child right before autonomous starts
+void ApplyDraw(const Draw& draw, unsigned seed) {
+    sim::Chassis& plant = harness::Plant();
+    plant.PoseSet(draw.start);
+    plant.Config().leftSlip = draw.leftSlip;
+    plant.Config().rightSlip = draw.rightSlip;
+    sim::Battery().voltage = draw.battery;
+
+    // Motor strengths come from their own stream so adding motors doesn't shift the other draws
+    std::mt19937 rng(seed ^ 0x9e3779b9u);
+    std::normal_distribution<double> strength(1.0, STRENGTH_SIGMA);
+    for (int port : plant.Config().leftPorts) sim::Port(port).motor.strength = std::max(STRENGTH_MIN, strength(rng));
+    for (int port : plant.Config().rightPorts) sim::Port(port).motor.strength = std::max(STRENGTH_MIN, strength(rng));
+}
+
+double Percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    std::size_t index = static_cast<std::size_t>(std::ceil(p / 100.0 * values.size()));
+    return values[std::clamp<std::size_t>(index, 1, values.size()) - 1];
+}
+
+void PrintSpread(const char* name, const char* unit, const std::vector<double>& values) {
+    if (values.empty()) {
+        printf("  %-20s no runs\n", name);
+        return;
+    }
+    printf("  %-20s p50 %8.2f  p95 %8.2f  p99 %8.2f  max %8.2f %s\n", name, Percentile(values, 50), Percentile(values, 95), Percentile(values, 99),
+           *std::max_element(values.begin(), values.end()), unit);
+}
+
+double AngleDifference(double a, double b) { return std::remainder(a - b, 360.0); }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int page = argc > 1 ? std::atoi(argv[1]) : 0;
+    std::uint32_t limitMs = argc > 2 ? std::atoi(argv[2]) : 15000;
+    int runs = argc > 3 ? std::atoi(argv[3]) : 1000;
+    int jobs = argc > 4 ? std::atoi(argv[4]) : static_cast<int>(std::thread::hardware_concurrency());
+    unsigned seed = argc > 5 ? std::strtoul(argv[5], nullptr, 10) : 1;
+
+    harness::Boot();
+    if (page < 0 || page >= harness::AutonCount()) {
+        printf("No auton on page %d (%d pages)\n", page, harness::AutonCount());
+        return 1;
+    }
+
+    // The unperturbed run is where the routine is meant to end up
+    harness::Options nominalOptions;
+    nominalOptions.page = page;
+    nominalOptions.limitMs = limitMs;
+    harness::Result nominal = harness::RunAuton(nominalOptions);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<harness::Result> results = harness::RunAutons(runs, jobs, [&](int run) {
+        harness::Options options;
+        options.page = page;
+        options.limitMs = limitMs;
+        unsigned runSeed = seed + run;
+        Draw draw = DrawRun(runSeed);
+        options.setup = [draw, runSeed] { ApplyDraw(draw, runSeed); };
+        return options;
+    });
+    double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> finishedTimes, poseErrors, headingErrors, odomErrors;
+    int finished = 0;
+    for (const auto& result : results) {
+        double poseError = std::hypot(result.pose.x - nominal.pose.x, result.pose.y - nominal.pose.y);
+        poseErrors.push_back(poseError);
+        headingErrors.push_back(std::fabs(AngleDifference(result.pose.theta, nominal.pose.theta)));
+        odomErrors.push_back(result.odomError);
+        if (result.finished) {
+            finished++;
+            finishedTimes.push_back(result.timeMs);
+        }
+    }
+
+    printf("%s, %d runs on %d workers in %.0f ms (%.0f runs/s)\n", harness::AutonName(page), runs, jobs, wallMs, runs * 1000.0 / wallMs);
+    printf("  Nominal: %s in %u ms, ends at (%.2f, %.2f, %.2f)\n", nominal.finished ? "finished" : "timed out", nominal.timeMs, nominal.pose.x,
+           nominal.pose.y, nominal.pose.theta);
+    printf("  Finished %d of %d before the %u ms limit\n\n", finished, runs, limitMs);
+
+    PrintSpread("Completion time", "ms", finishedTimes);
+    PrintSpread("End position error", "in", poseErrors);
+    PrintSpread("End heading error", "deg", headingErrors);
+    PrintSpread("Odometry drift", "in", odomErrors);
+
+    // Worst runs by how far from the nominal end they finished
+    std::vector<int> order(results.size());
+    for (std::size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return poseErrors[a] > poseErrors[b]; });
+    printf("\nWorst runs\n");
+    for (int i = 0; i < WORST_SHOWN && i < static_cast<int>(order.size()); i++) {
+        int run = order[i];
+        Draw draw = DrawRun(seed + run);
+        printf("  seed %-8u %6.2f in  %5u ms  start (%+.2f, %+.2f, %+.2f)  slip L %.3f R %.3f  battery %.0f mV\n", seed + run, poseErrors[run],
+               results[run].timeMs, draw.start.x, draw.start.y, draw.start.theta, draw.leftSlip, draw.rightSlip, draw.battery);
+    }
+    return 0;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file auton_profile.cpp
+ * @brief Breaks an auton run into segments and ranks where the time goes.
+ *
+ * Usage: auton_profile [page] [limit_ms]
+ *
+ * Runs one auton against the chassis plant while recording every motion and the
+ * pid_wait* calls that follow it, every pros::delay, and every subsystem call made
+ * from the autonomous task. Prints the timeline, a breakdown by segment kind and
+ * exit condition, and the segments ranked by how long they held the routine up.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "harness/harness.hpp"
+#include "sim/profile.hpp"
+#include "sim/scheduler.hpp"
+
+namespace {
+
+const char* KindName(sim::ProfileKind kind) {
+    switch (kind) {
+        case sim::ProfileKind::MOTION: return "motion";
+        case sim::ProfileKind::WAIT: return "wait";
+        case sim::ProfileKind::SLEEP: return "sleep";
+        case sim::ProfileKind::SUBSYSTEM: return "subsystem";
+    }
+    return "?";
+}
+
+std::uint32_t Length(const sim::ProfileSegment& segment) { return segment.endMs - segment.startMs; }
+
+/// A line in the ranked list: a motion with all of its waits, or a single sleep or subsystem call.
+struct Entry {
+    std::uint32_t ms = 0;
+    std::uint32_t startMs = 0;
+    const char* kind = "";
+    std::string label;
+    std::string exit;
+};
+
+void PrintTimeline(const std::vector<sim::ProfileSegment>& segments) {
+    printf("\nTimeline\n");
+    printf("  %7s %6s  %-9s  %-36s %s\n", "start", "ms", "kind", "segment", "exit");
+    for (const auto& segment : segments) {
+        // Waits are indented under the motion they belong to
+        std::string label = segment.kind == sim::ProfileKind::WAIT ? "  " + segment.label : segment.label;
+        printf("  %7u %6u  %-9s  %-36s %s\n", segment.startMs, Length(segment), KindName(segment.kind), label.c_str(), segment.exit.c_str());
+    }
+}
+
+void PrintBreakdown(const std::vector<sim::ProfileSegment>& segments, std::uint32_t totalMs) {
+    std::map<sim::ProfileKind, std::uint32_t> byKind;
+    std::map<std::string, std::pair<int, std::uint32_t>> byExit;
+    std::uint32_t tracked = 0;
+    for (const auto& segment : segments) {
+        byKind[segment.kind] += Length(segment);
+        tracked += Length(segment);
+        if (segment.kind == sim::ProfileKind::WAIT && !segment.exit.empty()) {
+            byExit[segment.exit].first++;
+            byExit[segment.exit].second += Length(segment);
+        }
+    }
+
+    auto line = [&](const char* name, std::uint32_t ms) {
+        printf("  %-16s %6u ms  %5.1f%%\n", name, ms, totalMs == 0 ? 0.0 : 100.0 * ms / totalMs);
+    };
+    printf("\nWhere the time went\n");
+    line("Motions", byKind[sim::ProfileKind::WAIT]);
+    line("Fixed sleeps", byKind[sim::ProfileKind::SLEEP]);
+    line("Subsystem calls", byKind[sim::ProfileKind::SUBSYSTEM]);
+    line("Untracked", totalMs > tracked ? totalMs - tracked : 0);
+
+    printf("\nMotion waits by exit condition\n");
+    for (const auto& [exit, stats] : byExit)
+        printf("  %-28s %3d waits %6u ms\n", exit.c_str(), stats.first, stats.second);
+}
+
+void PrintRanked(const std::vector<sim::ProfileSegment>& segments, int count) {
+    std::vector<Entry> entries;
+    std::map<int, std::size_t> motionEntry;
+    for (std::size_t i = 0; i < segments.size(); i++) {
+        const auto& segment = segments[i];
+        if (segment.kind == sim::ProfileKind::MOTION) {
+            motionEntry[i] = entries.size();
+            entries.push_back({0, segment.startMs, "motion", segment.label, ""});
+        } else if (segment.kind == sim::ProfileKind::WAIT && motionEntry.count(segment.motion)) {
+            // A motion costs the routine whatever it spends waiting on it, the last wait decides how it ended
+            Entry& entry = entries[motionEntry[segment.motion]];
+            entry.ms += Length(segment);
+            entry.exit = segment.exit;
+        } else {
+            entries.push_back({Length(segment), segment.startMs, KindName(segment.kind), segment.label, segment.exit});
+        }
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.ms > b.ms; });
+    printf("\nCritical path, longest first\n");
+    for (int i = 0; i < count && i < static_cast<int>(entries.size()); i++) {
+        const Entry& entry = entries[i];
+        printf("  %2d. %6u ms  %-9s  %-36s @ %6u  %s\n", i + 1, entry.ms, entry.kind, entry.label.c_str(), entry.startMs, entry.exit.c_str());
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    harness::Options options;
+    options.page = argc > 1 ? std::atoi(argv[1]) : 2;
+    options.limitMs = argc > 2 ? std::atoi(argv[2]) : 60000;
+    std::uint32_t start = 0;
+    options.setup = [&start] {
+        start = sim::Now();
+        sim::ProfileStart("autonomous");
+    };
+
+    harness::Boot();
+    if (options.page < 0 || options.page >= harness::AutonCount()) {
+        printf("No auton on page %d (%d pages)\n", options.page, harness::AutonCount());
+        return 1;
+    }
+
+    harness::Result result = harness::RunAutonInProcess(options);
+    std::vector<sim::ProfileSegment> segments = sim::ProfileStop();
+
+    // Segment times are since boot, report them from the start of the routine
+    for (auto& segment : segments) {
+        segment.startMs -= start;
+        segment.endMs -= start;
+    }
+
+    printf("%s\n", harness::AutonName(options.page));
+    printf("  %s in %u ms of match time\n", result.finished ? "Finished" : "Timed out", result.timeMs);
+
+    PrintTimeline(segments);
+    PrintBreakdown(segments, result.timeMs);
+    PrintRanked(segments, 15);
+    return 0;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file auton_runner.cpp
+ * @brief Runs autonomous routines on the host against the chassis plant.
+ *
+ * Usage: auton_runner [page] [limit_ms] [runs]
+ *
+ * `page` is the auton selector page (0 = Blue Match Auton, 1 = Red Match Auton,
+ * 2 = Skills, ...) and `limit_ms` caps the routine like the field does (15000 for
+ * a match, 60000 for skills). With `runs` > 1 the routine is repeated from the same
+ * booted state and the run rate is reported; a single run prints the robot's output.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "harness/harness.hpp"
+
+int main(int argc, char** argv) {
+    harness::Options options;
+    options.page = argc > 1 ? std::atoi(argv[1]) : 0;
+    options.limitMs = argc > 2 ? std::atoi(argv[2]) : 15000;
+    int runs = argc > 3 ? std::atoi(argv[3]) : 1;
+    options.quiet = runs > 1;
+
+    harness::Boot();
+    if (options.page < 0 || options.page >= harness::AutonCount()) {
+        printf("No auton on page %d (%d pages)\n", options.page, harness::AutonCount());
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    harness::Result result;
+    for (int i = 0; i < runs; i++)
+        result = harness::RunAuton(options);
+    double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    printf("\n%s\n", harness::AutonName(options.page));
+    printf("  %s in %u ms of match time\n", result.finished ? "Finished" : "Timed out", result.timeMs);
+    printf("  End pose:  (%.2f, %.2f, %.2f)\n", result.pose.x, result.pose.y, result.pose.theta);
+    printf("  Odom pose: (%.2f, %.2f, %.2f), %.2f in off\n", result.odomPose.x, result.odomPose.y, result.odomPose.theta, result.odomError);
+    printf("  %d run%s in %.1f ms wall (%.1f runs/s)\n", runs, runs == 1 ? "" : "s", wall_ms, runs * 1000.0 / wall_ms);
+    return result.finished ? 0 : 2;
+}
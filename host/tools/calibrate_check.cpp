@@ -0,0 +1,107 @@
+/**
+ * @file calibrate_check.cpp
+ * @brief Runs the tracker calibration on a robot built off from the code and checks the fit finds it.
+ *
+ * Usage: calibrate_check [wheel_error] [offset_error] [imu_error] [horizontal_wheel_error] [imu_counterclockwise_error]
+ *
+ * The simulated vertical tracking wheel is made `wheel_error` bigger than the
+ * robot code thinks (default 0.03, 3%) and the horizontal one
+ * `horizontal_wheel_error` (default -0.02), each tracker's offset is moved by
+ * `offset_error` inches (default 0.5), and the IMU reads `imu_error` more degrees
+ * per degree turning clockwise (default 0.01) and `imu_counterclockwise_error`
+ * more turning counterclockwise (default 0.02). The horizontal offset's truth is at the wheel's set
+ * diameter, the only way the maneuver can see it. The robot starts with its back
+ * flush against the field wall, and a plant stands in for the wall: backing past
+ * where the robot started squares it up to the nearest 90 degrees and stops it.
+ * The report compares each fitted value with the truth.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "harness/harness.hpp"
+#include "main.h"
+#include "sim/world.hpp"
+#include "subsystems.hpp"
+
+namespace {
+
+const double BACK_GAP = 0.3;   // in from the back distance sensor to the wall at the start, well under its range
+
+int CalibrationPage() {
+    for (int page = 0; page < harness::AutonCount(); page++)
+        if (std::strncmp(harness::AutonName(page), "Measure Offsets", 15) == 0) return page;
+    return -1;
+}
+
+void Report(const char* label, double truth, double fit) {
+    printf("  %-20s truth %8.4f  fit %8.4f  error %+.4f\n", label, truth, fit, fit - truth);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    double wheelError = argc > 1 ? std::atof(argv[1]) : 0.03;
+    double offsetError = argc > 2 ? std::atof(argv[2]) : 0.5;
+    double imuError = argc > 3 ? std::atof(argv[3]) : 0.01;
+    double horizontalWheelError = argc > 4 ? std::atof(argv[4]) : -0.02;
+    double imuCounterError = argc > 5 ? std::atof(argv[5]) : 0.02;
+
+    harness::Boot();
+    int page = CalibrationPage();
+    if (page < 0) {
+        printf("No Measure Offsets page\n");
+        return 1;
+    }
+
+    double verticalTruth = 0, horizontalTruth = 0, scaleTruth = 0;
+
+    harness::Options options;
+    options.page = page;
+    options.limitMs = 60000;
+    options.setup = [&] {
+        sim::ChassisConfig& config = harness::Plant().Config();
+        config.imuScale = 1.0 + imuError;
+        config.imuScaleCounterClockwise = 1.0 + imuCounterError;
+        for (sim::TrackerConfig& tracker : config.trackers) {
+            double scale = 1.0 + (tracker.vertical ? wheelError : horizontalWheelError);
+            tracker.diameter *= scale;
+            tracker.distanceToCenter += offsetError;
+            if (tracker.vertical) {
+                verticalTruth = tracker.distanceToCenter;
+                scaleTruth = scale;
+            } else {
+                horizontalTruth = tracker.distanceToCenter / scale;
+            }
+        }
+
+        // Back against the wall, the back sensor mount is 7 in behind the center
+        harness::FieldPlant().Config().start = {0, -harness::FieldPlant().Config().halfWidth + 7.0 + BACK_GAP, 0};
+
+        // The wall along the robot's start: nothing gets behind it, and pushing into it squares the robot
+        sim::PlantAdd([](double) {
+            sim::ChassisPose pose = harness::Plant().Pose();
+            if (pose.y >= 0) return;
+            pose.y = 0;
+            pose.theta = 90.0 * std::round(pose.theta / 90.0);
+            harness::Plant().PoseSet(pose);
+        });
+    };
+
+    harness::Result result = harness::RunAutonInProcess(options);
+    TrackerCalibration fit = LastTrackerCalibration();
+
+    printf("\nCalibration, wheels %+.1f%% and %+.1f%%, offsets %+.2f in, IMU %+.1f%% and %+.1f%%, %s in %u ms, %d samples\n",
+           wheelError * 100, horizontalWheelError * 100, offsetError, imuError * 100, imuCounterError * 100, result.finished ? "finished" : "timed out", result.timeMs, fit.samples);
+    Report("vertical offset", verticalTruth, fit.verticalOffset);
+    Report("horizontal offset", horizontalTruth, fit.horizontalOffset);
+    Report("vertical scale", scaleTruth, fit.verticalScale);
+    Report("IMU clockwise", 1.0 / (1.0 + imuError), fit.imuScalerClockwise);
+    Report("IMU counterclockwise", 1.0 / (1.0 + imuCounterError), fit.imuScalerCounterClockwise);
+    Report("IMU scaler", (1.0 / (1.0 + imuError) + 1.0 / (1.0 + imuCounterError)) / 2.0, fit.imuScaler);
+    Report("track width", harness::Plant().Config().trackWidth, fit.trackWidth);
+    printf("  residuals            vertical %.4f in, horizontal %.4f in\n", fit.verticalResidual, fit.horizontalResidual);
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file clamp_check.cpp
+ * @brief Backs into a goal at several speeds and reports where the clamp grips relative to contact.
+ *
+ * Usage: clamp_check [goal_distance] [close_ms]
+ *
+ * A goal sits `goal_distance` inches behind the robot (default 27). A plant plays
+ * the clamp optical: green, with proximity reaching GOAL_PROXIMITY at contact and
+ * falling 30 per inch further out, refreshed every 15 ms like the sensor's
+ * integration time. The clamp grips `close_ms` (default 80) after the solenoid
+ * fires. The sim has no goal to push, so the robot keeps driving through contact;
+ * a negative grip point is how far past contact it would have shoved the goal.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "harness/harness.hpp"
+#include "main.h"
+#include "sim/world.hpp"
+#include "subsystems.hpp"
+
+namespace {
+
+const double PROXIMITY_AT_CONTACT = 180;   // GOAL_PROXIMITY, the clamp optical's reading with the goal in the clamp
+const double PROXIMITY_PER_INCH = 30;
+const int OPTICAL_REFRESH_MS = 15;
+const int CLAMP_ADI_PORT = 3;              // 'C'
+
+double goalDistance = 27;
+int closeMs = 80;
+
+/// One approach: returns the grip point in inches past contact, negative when late, NAN if it never fired.
+double Approach(int speed, bool lead) {
+    harness::Options options;
+    options.limitMs = 5000;
+    options.setup = [] {
+        auto travel = std::make_shared<std::vector<double>>();   // inches backed up, per virtual ms
+        auto fired = std::make_shared<int>(-1);
+        sim::PlantAdd([travel, fired](double) {
+            double backed = -harness::Plant().Pose().y;
+            travel->push_back(backed);
+            int now = (int)travel->size() - 1;
+
+            sim::SmartPort& optical = sim::Port(clampOptical.get_port());
+            if (now % OPTICAL_REFRESH_MS == 0) {
+                optical.optical.hue = 80;
+                optical.optical.proximity = (int)std::clamp(PROXIMITY_AT_CONTACT - PROXIMITY_PER_INCH * (goalDistance - backed), 0.0, 255.0);
+            }
+
+            if (*fired < 0 && sim::Adi(22, CLAMP_ADI_PORT).value) *fired = now;
+            if (*fired >= 0 && now == *fired + closeMs) harness::ScoreAdd(goalDistance - backed);
+        });
+    };
+    options.routine = [speed, lead] {
+        OpenClamp();
+        pros::delay(50);
+        ActionHandle grab = ClampOnGoal(3000, lead);
+        chassis.pid_drive_set(-(goalDistance + 11) * okapi::inch, speed, true);
+        grab.Wait(3000);
+        chassis.pid_wait();
+    };
+
+    harness::Result result = harness::RunAuton(options);
+    return result.score == 0 ? NAN : result.score;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    goalDistance = argc > 1 ? std::atof(argv[1]) : goalDistance;
+    closeMs = argc > 2 ? std::atoi(argv[2]) : closeMs;
+
+    harness::Boot();
+    printf("Grip point relative to contact, goal %.1f in back, clamp closes in %d ms (negative = past contact)\n", goalDistance, closeMs);
+    printf("  speed    no lead     lead\n");
+    for (int speed : {30, 60, 90, 110, 127})
+        printf("  %5d  %+8.2f  %+8.2f\n", speed, Approach(speed, false), Approach(speed, true));
+    return 0;
+}
@@ -0,0 +1,255 @@
+/**
+ * @file control_bench.cpp
+ * @brief Microbenchmarks for the math that runs inside the 10 ms control loops.
+ *
+ * Usage: control_bench [--save <file>] [--compare <file>] [--filter <text>]
+ *
+ * Reports ns/op and heap allocations/op for the PID, slew, and angle helpers,
+ * the pure pursuit path preprocessing, the sensor snapshot, and the ring and goal
+ * color checks.
+ * Times are for the host CPU, so compare them against a baseline taken on the
+ * same machine: --save writes one, --compare flags anything more than
+ * REGRESSION_LIMIT slower or allocating more than the baseline and exits 1.
+ *
+ * Drive::inject_points and Drive::smooth_path are private, so they're measured
+ * through pid_odom_injected_pp_set and pid_odom_smooth_pp_set. The cost of only
+ * smoothing is the difference between the two lines.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "main.h"
+#include "sim/world.hpp"
+#include "subsystems.hpp"
+
+// Every heap allocation in this binary goes through here so each benchmark can count its own
+namespace {
+std::size_t allocations = 0;
+
+// Out of line, so GCC doesn't see the free() behind an inlined delete and call it a mismatch for new
+[[gnu::noinline]] void Release(void* memory) noexcept { std::free(memory); }
+}
+
+void* operator new(std::size_t size) {
+    allocations++;
+    if (void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* memory) noexcept { Release(memory); }
+void operator delete[](void* memory) noexcept { Release(memory); }
+void operator delete(void* memory, std::size_t) noexcept { Release(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { Release(memory); }
+
+namespace {
+
+const double TARGET_SECONDS = 0.05;     // length of one timed batch
+const int REPEATS = 5;                   // batches per benchmark, the fastest is reported
+const double REGRESSION_LIMIT = 0.20;   // fraction slower than the baseline that fails --compare
+const int INPUTS = 1024;                 // varied inputs cycled through, so nothing folds to a constant
+
+// Keeps the compiler from dropping a result it can prove is unused
+template <class T>
+void Keep(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct Measurement {
+    std::string name;
+    double nsPerOp = 0;
+    double allocsPerOp = 0;
+};
+
+std::vector<Measurement> measurements;
+const char* filter = nullptr;
+
+/// Times one batch of `iterations` calls, returning seconds and counting allocations into `allocated`.
+template <class Op>
+double Batch(Op& op, long iterations, std::size_t& allocated) {
+    std::size_t allocationsBefore = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; i++) op(static_cast<int>(i));
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    allocated = allocations - allocationsBefore;
+    return seconds;
+}
+
+/// Sizes a batch to take TARGET_SECONDS, then reports the fastest of REPEATS batches.
+template <class Op>
+void Bench(const char* name, Op op) {
+    if (filter && !std::strstr(name, filter)) return;
+
+    // Warm up caches and any lazy state first
+    for (int i = 0; i < 1000; i++) op(i);
+
+    long iterations = 1000;
+    std::size_t allocated = 0;
+    double seconds = Batch(op, iterations, allocated);
+    while (seconds < TARGET_SECONDS) {
+        iterations = seconds <= 0 ? iterations * 10 : static_cast<long>(iterations * std::min(10.0, 1.2 * TARGET_SECONDS / seconds));
+        seconds = Batch(op, iterations, allocated);
+    }
+
+    // The fastest batch is the one least disturbed by the rest of the machine
+    for (int repeat = 1; repeat < REPEATS; repeat++) seconds = std::min(seconds, Batch(op, iterations, allocated));
+
+    Measurement measurement{name, seconds * 1e9 / iterations, static_cast<double>(allocated) / iterations};
+    printf("  %-44s %10.1f ns/op %8.2f allocs/op\n", name, measurement.nsPerOp, measurement.allocsPerOp);
+    measurements.push_back(measurement);
+}
+
+std::vector<double> Inputs(double low, double high, unsigned seed) {
+    std::vector<double> values(INPUTS);
+    std::srand(seed);
+    for (double& value : values) value = low + (high - low) * std::rand() / RAND_MAX;
+    return values;
+}
+
+void BenchPid() {
+    printf("PID\n");
+    std::vector<double> sensor = Inputs(-48, 48, 1);
+    ez::PID pid(19.4, 0.0, 109.0, 0, "Drive");
+    pid.target_set(24);
+    pid.exit_condition_set(90, 1, 250, 3, 500, 500);
+
+    Bench("PID::compute", [&](int i) { Keep(pid.compute(sensor[i % INPUTS])); });
+    Bench("PID::compute_error", [&](int i) { Keep(pid.compute_error(24 - sensor[i % INPUTS], sensor[i % INPUTS])); });
+    Bench("PID::exit_condition()", [&](int i) {
+        pid.compute(sensor[i % INPUTS]);
+        Keep(pid.exit_condition());
+    });
+    Bench("PID::exit_condition(Motor)", [&](int i) {
+        pid.compute(sensor[i % INPUTS]);
+        Keep(pid.exit_condition(chassis.left_motors[0]));
+    });
+    Bench("PID::exit_condition(vector<Motor>)", [&](int i) {
+        pid.compute(sensor[i % INPUTS]);
+        Keep(pid.exit_condition({chassis.left_motors[0], chassis.right_motors[0]}));
+    });
+}
+
+void BenchSlew() {
+    printf("slew\n");
+    // Stay inside the ramp so every call takes the slewing branch
+    std::vector<double> sensor = Inputs(0, 2.9, 2);
+    ez::slew slew(3, 70);
+    slew.initialize(true, 127, 24, 0);
+    Bench("slew::iterate", [&](int i) { Keep(slew.iterate(sensor[i % INPUTS])); });
+}
+
+void BenchUtil() {
+    printf("util\n");
+    std::vector<double> target = Inputs(-720, 720, 3), current = Inputs(-720, 720, 4);
+    std::vector<double> x = Inputs(-72, 72, 5), y = Inputs(-72, 72, 6);
+
+    Bench("util::turn_shortest", [&](int i) { Keep(ez::util::turn_shortest(target[i % INPUTS], current[i % INPUTS])); });
+    Bench("util::turn_longest", [&](int i) { Keep(ez::util::turn_longest(target[i % INPUTS], current[i % INPUTS])); });
+    Bench("util::wrap_angle", [&](int i) { Keep(ez::util::wrap_angle(target[i % INPUTS])); });
+    Bench("util::absolute_angle_to_point", [&](int i) {
+        ez::pose to{x[i % INPUTS], y[i % INPUTS]};
+        ez::pose from{y[(i + 1) % INPUTS], x[(i + 1) % INPUTS], current[i % INPUTS]};
+        Keep(ez::util::absolute_angle_to_point(to, from));
+    });
+}
+
+void BenchPaths() {
+    printf("Pure pursuit paths\n");
+    chassis.pid_print_toggle(false);
+    // The same kind of path the pure pursuit examples in autons.cpp run
+    std::vector<ez::odom> path = {
+        {{0, 24}, ez::FWD, 110},
+        {{24, 24}, ez::FWD, 110},
+        {{24, 48}, ez::FWD, 110},
+        {{0, 72}, ez::FWD, 110},
+    };
+    Bench("Drive::pid_odom_pp_set (4 points)", [&](int) { chassis.pid_odom_pp_set(path); });
+    Bench("Drive::pid_odom_injected_pp_set", [&](int) { chassis.pid_odom_injected_pp_set(path); });
+    Bench("Drive::pid_odom_smooth_pp_set", [&](int) { chassis.pid_odom_smooth_pp_set(path); });
+    chassis.drive_mode_set(ez::DISABLE);
+}
+
+void BenchSensors() {
+    printf("Sensors and color checks\n");
+    std::vector<double> hue = Inputs(0, 360, 7);
+    Bench("RingColorCheck", [&](int i) { Keep(RingColorCheck(i & 1 ? AllianceMode::RED : AllianceMode::BLUE, hue[i % INPUTS])); });
+
+    // A green goal sitting in the clamp, so both checks pass
+    sim::Port(clampOptical.get_port()).optical.proximity = 255;
+    sim::Port(clampOptical.get_port()).optical.hue = 80;
+    Bench("SensorsTick", [&](int) { SensorsTick(); });
+    Bench("IsGoalClamped", [&](int) { Keep(IsGoalClamped()); });
+}
+
+std::map<std::string, Measurement> Load(const char* path) {
+    std::map<std::string, Measurement> baseline;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::stringstream fields(line);
+        Measurement measurement;
+        std::string ns, allocs;
+        if (std::getline(fields, measurement.name, ',') && std::getline(fields, ns, ',') && std::getline(fields, allocs, ',')) {
+            measurement.nsPerOp = std::atof(ns.c_str());
+            measurement.allocsPerOp = std::atof(allocs.c_str());
+            baseline[measurement.name] = measurement;
+        }
+    }
+    return baseline;
+}
+
+bool Compare(const char* path) {
+    std::map<std::string, Measurement> baseline = Load(path);
+    bool regressed = false;
+    printf("\nAgainst %s\n", path);
+    for (const auto& measurement : measurements) {
+        auto it = baseline.find(measurement.name);
+        if (it == baseline.end()) {
+            printf("  %-44s new\n", measurement.name.c_str());
+            continue;
+        }
+        double change = measurement.nsPerOp / it->second.nsPerOp - 1.0;
+        bool slower = change > REGRESSION_LIMIT;
+        bool allocates = measurement.allocsPerOp > it->second.allocsPerOp + 0.01;
+        regressed |= slower || allocates;
+        printf("  %-44s %+7.1f%% %s%s\n", measurement.name.c_str(), change * 100.0, slower ? " SLOWER" : "", allocates ? " MORE ALLOCS" : "");
+    }
+    return !regressed;
+}
+
+void Save(const char* path) {
+    std::ofstream file(path);
+    for (const auto& measurement : measurements) file << measurement.name << ',' << measurement.nsPerOp << ',' << measurement.allocsPerOp << '\n';
+    printf("\nSaved baseline to %s\n", path);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const char* save = nullptr;
+    const char* compare = nullptr;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--save") == 0) save = argv[i + 1];
+        else if (std::strcmp(argv[i], "--compare") == 0) compare = argv[i + 1];
+        else if (std::strcmp(argv[i], "--filter") == 0) filter = argv[i + 1];
+    }
+
+    BenchPid();
+    BenchSlew();
+    BenchUtil();
+    BenchPaths();
+    BenchSensors();
+
+    if (save) Save(save);
+    if (compare && !Compare(compare)) return 1;
+    return 0;
+}
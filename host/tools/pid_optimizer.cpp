@@ -0,0 +1,400 @@
+/**
+ * @file pid_optimizer.cpp
+ * @brief Searches the PID tuner's constants offline against the chassis plant.
+ *
+ * Usage: pid_optimizer [full] [generations] [jobs] [seed]
+ *
+ * Walks the same list the on-robot tuner pages through, `pid_tuner_pids`, or
+ * `pid_tuner_full_pids` when the first argument is `full`. For each entry it runs a
+ * short set of test motions for that motion type and scores them by settle time
+ * plus overshoot and final error (and drift off the target heading for the heading
+ * constants). kP and kD are searched with CMA-ES in log space, starting from what
+ * default_constants() sets today and staying within SEARCH_RANGE of it; kI and
+ * start I are left alone. Every candidate is run in its own forked copy of the
+ * booted robot, spread over `jobs` workers.
+ *
+ * Entries are tuned in list order and each winner is kept for the entries after it,
+ * so odom angular is tuned on top of the tuned drive constants. The result prints
+ * as lines to paste into default_constants().
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "harness/harness.hpp"
+#include "main.h"
+#include "sim/world.hpp"
+#include "subsystems.hpp"
+
+namespace {
+
+// Speeds the test motions run at, the same as autons.cpp
+const int DRIVE_SPEED = 110;
+const int TURN_SPEED = 100;
+const int SWING_SPEED = 110;
+
+// Cost weights, in ms of settle time
+const double DRIVE_WEIGHT = 150;       // per inch of overshoot or final error
+const double ANGLE_WEIGHT = 40;        // per degree of overshoot or final error
+const double HEADING_WEIGHT = 200;     // per degree-second off the heading target
+const double UNFINISHED_COST = 1e6;    // the test ran out of time, the gains are unusable
+
+const std::uint32_t TEST_LIMIT_MS = 30000;
+const double INITIAL_STEP = 0.3;       // CMA-ES step size in log space, about +-35%
+const int POPULATION = 10;
+const double SEARCH_RANGE = 4;         // gains stay within this factor of where they started, the plant is only so faithful
+
+// Tracks the true robot each simulated millisecond while a test motion runs
+struct Probe {
+    std::function<double()> progress;    // toward the target, in the motion's units
+    std::function<double()> deviation;   // off where the robot should point, optional
+    double peak = 0;
+    double deviationIntegral = 0;
+};
+Probe probe;
+
+void ProbeStep(double dt) {
+    if (!probe.progress) return;
+    probe.peak = std::max(probe.peak, probe.progress());
+    if (probe.deviation) probe.deviationIntegral += std::fabs(probe.deviation()) * dt;
+}
+
+// Waits out the motion started after the probe was set and scores it
+void Settle(double target, double weight) {
+    std::uint32_t start = pros::millis();
+    chassis.pid_wait();
+    double settle = pros::millis() - start;
+    double overshoot = std::max(0.0, probe.peak - target);
+    double error = std::fabs(probe.progress() - target);
+    harness::ScoreAdd(settle + weight * (overshoot + error) + HEADING_WEIGHT * probe.deviationIntegral);
+    probe = Probe();
+}
+
+// Distance travelled along a direction (degrees, EZ convention) from a start pose
+double Along(const sim::ChassisPose& from, double theta) {
+    sim::ChassisPose now = harness::Plant().Pose();
+    double angle = ez::util::to_rad(theta);
+    return (now.x - from.x) * std::sin(angle) + (now.y - from.y) * std::cos(angle);
+}
+
+void DriveTest(double distance) {
+    sim::ChassisPose start = harness::Plant().Pose();
+    double sign = ez::util::sgn(distance);
+    probe.progress = [=] { return sign * Along(start, start.theta); };
+    chassis.pid_drive_set(distance, DRIVE_SPEED);
+    Settle(std::fabs(distance), DRIVE_WEIGHT);
+}
+
+// Drives straight after knocking the IMU off the heading target, scoring how fast heading pulls it back
+void HeadingTest(double distance, double offset) {
+    chassis.drive_angle_set(chassis.drive_imu_get() + offset);
+    chassis.headingPID.target_set(chassis.drive_imu_get() - offset);
+    sim::ChassisPose start = harness::Plant().Pose();
+    double sign = ez::util::sgn(distance);
+    probe.progress = [=] { return sign * Along(start, start.theta); };
+    probe.deviation = [] { return chassis.drive_imu_get() - chassis.headingPID.target_get(); };
+    chassis.pid_drive_set(distance, DRIVE_SPEED);
+    Settle(std::fabs(distance), DRIVE_WEIGHT);
+}
+
+void TurnTest(double degrees) {
+    double start = harness::Plant().Pose().theta;
+    double sign = ez::util::sgn(degrees);
+    probe.progress = [=] { return sign * (harness::Plant().Pose().theta - start); };
+    chassis.pid_turn_relative_set(degrees, TURN_SPEED);
+    Settle(std::fabs(degrees), ANGLE_WEIGHT);
+}
+
+void SwingTest(ez::e_swing type, double degrees) {
+    double start = harness::Plant().Pose().theta;
+    double sign = ez::util::sgn(degrees);
+    probe.progress = [=] { return sign * (harness::Plant().Pose().theta - start); };
+    chassis.pid_swing_relative_set(type, degrees, SWING_SPEED);
+    Settle(std::fabs(degrees), ANGLE_WEIGHT);
+}
+
+// Odom motion to a point (and heading, for boomerang), progress measured along the straight line there
+void OdomTest(ez::pose target, ez::drive_directions direction) {
+    sim::ChassisPose start = harness::Plant().Pose();
+    ez::pose from = chassis.odom_pose_get();
+    double distance = ez::util::distance_to_point(target, from);
+    double line = ez::util::absolute_angle_to_point(target, from);
+    probe.progress = [=] { return Along(start, start.theta + line - from.theta); };
+    chassis.pid_odom_set({target, direction, DRIVE_SPEED});
+    Settle(distance, DRIVE_WEIGHT);
+}
+
+/// The test motions for one tuner entry, picked by its name.
+std::function<void()> TestsFor(const std::string& name) {
+    bool forward = name.find("Backward") == std::string::npos;
+    bool backward = name.find("Forward") == std::string::npos;
+
+    if (name.find("Heading") != std::string::npos)
+        return [] {
+            HeadingTest(48, 5);
+            HeadingTest(-48, -5);
+        };
+    if (name.find("Boomerang") != std::string::npos)
+        return [] {
+            OdomTest({12, 30, 45}, ez::FWD);
+            OdomTest({0, 0, 0}, ez::REV);
+        };
+    if (name.find("Odom") != std::string::npos)
+        return [] {
+            OdomTest({12, 30}, ez::FWD);
+            OdomTest({0, 0}, ez::REV);
+            OdomTest({-24, 12}, ez::FWD);
+        };
+    if (name.find("Drive") != std::string::npos)
+        return [forward, backward] {
+            for (double distance : {6.0, 24.0, 48.0}) {
+                if (forward) DriveTest(distance);
+                if (backward) DriveTest(-distance);
+            }
+        };
+    if (name.find("Turn") != std::string::npos)
+        return [] {
+            for (double degrees : {45.0, -90.0, 180.0, -135.0}) TurnTest(degrees);
+        };
+    if (name.find("Swing") != std::string::npos)
+        return [forward, backward] {
+            // A left swing turning right drives forward, a right swing turning left does too
+            if (forward) SwingTest(ez::LEFT_SWING, 60), SwingTest(ez::RIGHT_SWING, -60);
+            if (backward) SwingTest(ez::LEFT_SWING, -60), SwingTest(ez::RIGHT_SWING, 60);
+        };
+    return nullptr;
+}
+
+/// The default_constants() setter each tuner entry corresponds to.
+const char* SetterFor(const std::string& name) {
+    struct Setter {
+        const char* name;
+        const char* setter;
+    };
+    static const Setter setters[] = {
+        {"Drive PID Constants", "pid_drive_constants_set"},
+        {"Drive Forward PID Constants", "pid_drive_constants_forward_set"},
+        {"Drive Backward PID Constants", "pid_drive_constants_backward_set"},
+        {"Odom Angular PID Constants", "pid_odom_angular_constants_set"},
+        {"Boomerang Angular PID Constants", "pid_odom_boomerang_constants_set"},
+        {"Heading PID Constants", "pid_heading_constants_set"},
+        {"Turn PID Constants", "pid_turn_constants_set"},
+        {"Swing PID Constants", "pid_swing_constants_set"},
+        {"Swing Forward PID Constants", "pid_swing_constants_forward_set"},
+        {"Swing Backward PID Constants", "pid_swing_constants_backward_set"},
+    };
+    for (const auto& setter : setters)
+        if (name == setter.name) return setter.setter;
+    return "?";
+}
+
+// Writes constants through the tuner's pointers. The simple tuner's shared fwd/rev sets are then pushed
+// to the forward and backward PIDs motions actually use, like pid_tuner_iterate() does
+void Apply(std::vector<Drive::const_and_name>& pids, const std::vector<ez::PID::Constants>& constants, bool full) {
+    for (std::size_t i = 0; i < pids.size(); i++) *pids[i].consts = constants[i];
+    if (full) return;
+    ez::PID::Constants drive = chassis.pid_drive_constants_get();
+    chassis.pid_drive_constants_set(drive.kp, drive.ki, drive.kd, drive.start_i);
+    ez::PID::Constants swing = chassis.pid_swing_constants_get();
+    chassis.pid_swing_constants_set(swing.kp, swing.ki, swing.kd, swing.start_i);
+}
+
+/**
+ * @brief Minimal (mu/mu_w, lambda) CMA-ES.
+ *
+ * The covariance is carried as its Cholesky factor A (C = A A^T), and the step-size
+ * path is built from the unit samples z, which is equivalent to using C^-1/2.
+ */
+class CmaEs {
+  public:
+    CmaEs(std::vector<double> mean, double sigma, int lambda, unsigned seed)
+        : n_(mean.size()), lambda_(lambda), mu_(lambda / 2), mean_(std::move(mean)), sigma_(sigma), rng_(seed) {
+        for (int i = 0; i < mu_; i++) weights_.push_back(std::log(mu_ + 0.5) - std::log(i + 1.0));
+        double sum = 0, squares = 0;
+        for (double w : weights_) sum += w;
+        for (double& w : weights_) w /= sum, squares += w * w;
+        muEff_ = 1.0 / squares;
+
+        double n = n_;
+        cSigma_ = (muEff_ + 2) / (n + muEff_ + 5);
+        dSigma_ = 1 + 2 * std::max(0.0, std::sqrt((muEff_ - 1) / (n + 1)) - 1) + cSigma_;
+        cC_ = (4 + muEff_ / n) / (n + 4 + 2 * muEff_ / n);
+        c1_ = 2 / ((n + 1.3) * (n + 1.3) + muEff_);
+        cMu_ = std::min(1 - c1_, 2 * (muEff_ - 2 + 1 / muEff_) / ((n + 2) * (n + 2) + muEff_));
+        chiN_ = std::sqrt(n) * (1 - 1 / (4 * n) + 1 / (21 * n * n));
+
+        pSigma_.assign(n_, 0);
+        pC_.assign(n_, 0);
+        c_.assign(n_ * n_, 0);
+        a_.assign(n_ * n_, 0);
+        for (int i = 0; i < n_; i++) c_[i * n_ + i] = a_[i * n_ + i] = 1;
+    }
+
+    /// Draws this generation's candidates.
+    std::vector<std::vector<double>> Ask() {
+        std::normal_distribution<double> normal;
+        z_.assign(lambda_, std::vector<double>(n_));
+        std::vector<std::vector<double>> x(lambda_, mean_);
+        for (int k = 0; k < lambda_; k++) {
+            for (double& value : z_[k]) value = normal(rng_);
+            for (int i = 0; i < n_; i++)
+                for (int j = 0; j <= i; j++) x[k][i] += sigma_ * a_[i * n_ + j] * z_[k][j];
+        }
+        return x;
+    }
+
+    /// Moves the distribution toward the best candidates of the generation Ask() drew.
+    void Tell(const std::vector<std::vector<double>>& x, const std::vector<double>& cost) {
+        std::vector<int> order(lambda_);
+        for (int k = 0; k < lambda_; k++) order[k] = k;
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return cost[a] < cost[b]; });
+        generation_++;
+
+        std::vector<double> old = mean_, zMean(n_, 0);
+        std::fill(mean_.begin(), mean_.end(), 0);
+        for (int i = 0; i < mu_; i++)
+            for (int d = 0; d < n_; d++) {
+                mean_[d] += weights_[i] * x[order[i]][d];
+                zMean[d] += weights_[i] * z_[order[i]][d];
+            }
+
+        double norm = 0;
+        for (int d = 0; d < n_; d++) {
+            pSigma_[d] = (1 - cSigma_) * pSigma_[d] + std::sqrt(cSigma_ * (2 - cSigma_) * muEff_) * zMean[d];
+            norm += pSigma_[d] * pSigma_[d];
+        }
+        norm = std::sqrt(norm);
+        bool hSigma = norm / std::sqrt(1 - std::pow(1 - cSigma_, 2.0 * generation_)) < (1.4 + 2.0 / (n_ + 1)) * chiN_;
+
+        for (int d = 0; d < n_; d++)
+            pC_[d] = (1 - cC_) * pC_[d] + (hSigma ? std::sqrt(cC_ * (2 - cC_) * muEff_) * (mean_[d] - old[d]) / sigma_ : 0);
+
+        for (int i = 0; i < n_; i++)
+            for (int j = 0; j < n_; j++) {
+                double rankMu = 0;
+                for (int k = 0; k < mu_; k++)
+                    rankMu += weights_[k] * (x[order[k]][i] - old[i]) * (x[order[k]][j] - old[j]) / (sigma_ * sigma_);
+                double& c = c_[i * n_ + j];
+                c = (1 - c1_ - cMu_) * c + c1_ * (pC_[i] * pC_[j] + (hSigma ? 0 : cC_ * (2 - cC_) * c)) + cMu_ * rankMu;
+            }
+
+        sigma_ *= std::exp(cSigma_ / dSigma_ * (norm / chiN_ - 1));
+        Cholesky();
+    }
+
+    const std::vector<double>& Mean() const { return mean_; }
+
+  private:
+    void Cholesky() {
+        std::fill(a_.begin(), a_.end(), 0);
+        for (int i = 0; i < n_; i++)
+            for (int j = 0; j <= i; j++) {
+                double sum = c_[i * n_ + j];
+                for (int k = 0; k < j; k++) sum -= a_[i * n_ + k] * a_[j * n_ + k];
+                a_[i * n_ + j] = i == j ? std::sqrt(std::max(sum, 1e-12)) : sum / a_[j * n_ + j];
+            }
+    }
+
+    int n_, lambda_, mu_, generation_ = 0;
+    std::vector<double> mean_, weights_, pSigma_, pC_, c_, a_;
+    std::vector<std::vector<double>> z_;
+    double sigma_, muEff_, cSigma_, dSigma_, cC_, c1_, cMu_, chiN_;
+    std::mt19937 rng_;
+};
+
+// Candidate in log space <-> constants, keeping kI and start I
+ez::PID::Constants FromLog(ez::PID::Constants base, const std::vector<double>& x, const std::vector<double>& center) {
+    double range = std::log(SEARCH_RANGE);
+    base.kp = std::exp(std::clamp(x[0], center[0] - range, center[0] + range));
+    base.kd = std::exp(std::clamp(x[1], center[1] - range, center[1] + range));
+    return base;
+}
+
+std::vector<double> ToLog(const ez::PID::Constants& constants) {
+    // A zero gain has no log, start it small instead
+    return {std::log(std::max(constants.kp, 0.01)), std::log(std::max(constants.kd, 0.01))};
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bool full = argc > 1 && std::strcmp(argv[1], "full") == 0;
+    int generations = argc > 2 ? std::atoi(argv[2]) : 25;
+    int jobs = argc > 3 ? std::atoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency());
+    unsigned seed = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 1;
+
+    harness::Boot();
+    sim::PlantAdd(ProbeStep);
+
+    std::vector<Drive::const_and_name>& pids = full ? chassis.pid_tuner_full_pids : chassis.pid_tuner_pids;
+    std::vector<ez::PID::Constants> best;
+    for (auto& pid : pids) best.push_back(*pid.consts);
+    std::vector<ez::PID::Constants> original = best;
+    std::vector<double> before(pids.size(), 0), after(pids.size(), 0);
+
+    auto started = std::chrono::steady_clock::now();
+    for (std::size_t index = 0; index < pids.size(); index++) {
+        std::function<void()> tests = TestsFor(pids[index].name);
+        if (!tests) continue;
+
+        // Scores a batch of candidates for this entry on top of everything tuned so far
+        auto evaluate = [&](const std::vector<ez::PID::Constants>& candidates) {
+            std::vector<harness::Result> results = harness::RunAutons(candidates.size(), jobs, [&](int run) {
+                harness::Options options;
+                options.limitMs = TEST_LIMIT_MS;
+                options.routine = tests;
+                std::vector<ez::PID::Constants> constants = best;
+                constants[index] = candidates[run];
+                options.setup = [&pids, constants, full] { Apply(pids, constants, full); };
+                return options;
+            });
+            std::vector<double> costs;
+            for (const auto& result : results) costs.push_back(result.finished ? result.score : UNFINISHED_COST + result.score);
+            return costs;
+        };
+
+        before[index] = evaluate({best[index]})[0];
+        after[index] = before[index];
+        printf("%-32s  start cost %8.0f", pids[index].name.c_str(), before[index]);
+        fflush(stdout);
+
+        std::vector<double> center = ToLog(best[index]);
+        CmaEs search(center, INITIAL_STEP, POPULATION, seed + index);
+        for (int generation = 0; generation < generations; generation++) {
+            std::vector<std::vector<double>> samples = search.Ask();
+            std::vector<ez::PID::Constants> candidates;
+            for (const auto& sample : samples) candidates.push_back(FromLog(best[index], sample, center));
+            std::vector<double> costs = evaluate(candidates);
+            search.Tell(samples, costs);
+
+            for (std::size_t k = 0; k < costs.size(); k++)
+                if (costs[k] < after[index]) {
+                    after[index] = costs[k];
+                    best[index] = candidates[k];
+                }
+        }
+        printf("  ->  %8.0f\n", after[index]);
+    }
+    double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+    printf("\n// Searched in %.1f s on %d workers. Paste into default_constants():\n", wallMs / 1000.0, jobs);
+    printf("  // P, I, D, and Start I\n");
+    for (std::size_t i = 0; i < pids.size(); i++) {
+        const ez::PID::Constants& c = best[i];
+        const ez::PID::Constants& o = original[i];
+        char line[128];
+        if (c.start_i != 0) snprintf(line, sizeof(line), "chassis.%s(%.2f, %.2f, %.2f, %.2f);", SetterFor(pids[i].name), c.kp, c.ki, c.kd, c.start_i);
+        else snprintf(line, sizeof(line), "chassis.%s(%.2f, %.2f, %.2f);", SetterFor(pids[i].name), c.kp, c.ki, c.kd);
+        printf("  %-62s // was %.2f, %.2f, %.2f  cost %.0f -> %.0f\n", line, o.kp, o.ki, o.kd, before[i], after[i]);
+    }
+    return 0;
+}
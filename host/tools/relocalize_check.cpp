@@ -0,0 +1,108 @@
+/**
+ * @file relocalize_check.cpp
+ * @brief Runs an auton with drifting odometry, with and without wall relocalization.
+ *
+ * Usage: relocalize_check [page] [limit_ms] [tracker_error] [noise] [start_x] [start_y] [start_theta]
+ *
+ * The tracking wheels are made `tracker_error` bigger than the robot code thinks
+ * (default 0.03, 3%), so odometry drifts the way a worn or mis-measured wheel makes
+ * it drift. The robot starts at (start_x, start_y, start_theta) on the simulated
+ * field, inches from the center, and the distance sensors read the walls from
+ * there with `noise` (a fraction of the range) added. The auton runs twice from the
+ * same state, once as is and once after RelocalizeStart(), and the report compares
+ * how far the pose estimator, which the relocalizer corrects, ended from the truth. The run also records the worst error at
+ * any moment, since a late pickup misses on the error at that moment.
+ *
+ * The relocalizer is host-only for now, so its tick is added to the schedule
+ * here, after the robot's own.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "harness/harness.hpp"
+#include "main.h"
+#include "relocalizer/relocalizer.hpp"
+#include "sim/world.hpp"
+#include "subsystems.hpp"
+
+namespace {
+
+const int SAMPLE_MS = 10;   // how often the worst error is checked
+
+struct Check {
+    harness::Result result;
+    double worstError = 0;
+};
+
+// Worst odometry error of the run, written by a plant and read back through the score
+double worstError = 0;
+
+Check Run(int page, int limitMs, double trackerError, double noise, sim::ChassisPose start, bool relocalize) {
+    harness::Options options;
+    options.page = page;
+    options.limitMs = limitMs;
+    options.setup = [=] {
+        for (sim::TrackerConfig& tracker : harness::Plant().Config().trackers)
+            tracker.diameter *= 1.0 + trackerError;
+        harness::FieldPlant().Config().start = start;
+        harness::FieldPlant().Config().noise = noise;
+
+        worstError = 0;
+        sim::PlantAdd([](double) {
+            static int ms = 0;
+            if (++ms % SAMPLE_MS != 0) return;
+            sim::ChassisPose truth = harness::Plant().Pose();
+            ez::pose odom = fusedOdom.odom_pose_get();
+            double error = std::hypot(truth.x - odom.x, truth.y - odom.y);
+            worstError = std::max(worstError, error);
+        });
+    };
+    std::function<void()> auton = ez::as::auton_selector.Autons[page].auton_call;
+    options.routine = [=] {
+        if (relocalize) RelocalizeStart({start.x, start.y, start.theta});
+        auton();
+        harness::ScoreAdd(worstError);
+    };
+
+    Check check;
+    check.result = harness::RunAuton(options);
+    check.worstError = check.result.score;
+    return check;
+}
+
+void Report(const char* label, const Check& check) {
+    printf("  %-14s end %6.2f in off, worst %6.2f in, %s in %u ms\n", label, check.result.fusedError, check.worstError,
+           check.result.finished ? "finished" : "timed out", check.result.timeMs);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int page = argc > 1 ? std::atoi(argv[1]) : 2;
+    int limitMs = argc > 2 ? std::atoi(argv[2]) : 60000;
+    double trackerError = argc > 3 ? std::atof(argv[3]) : 0.03;
+    double noise = argc > 4 ? std::atof(argv[4]) : 0.01;
+    sim::ChassisPose start;
+    start.x = argc > 5 ? std::atof(argv[5]) : 0;
+    start.y = argc > 6 ? std::atof(argv[6]) : 0;
+    start.theta = argc > 7 ? std::atof(argv[7]) : 0;
+
+    harness::Boot();
+    SchedulerAdd("Relocalize", RELOCALIZE_PERIOD_MS, 5, RelocalizeTick, &relocalizeLoopStats);
+    if (page < 0 || page >= harness::AutonCount()) {
+        printf("No auton on page %d (%d pages)\n", page, harness::AutonCount());
+        return 1;
+    }
+
+    Check drifting = Run(page, limitMs, trackerError, noise, start, false);
+    Check relocalized = Run(page, limitMs, trackerError, noise, start, true);
+
+    printf("\n%s, trackers %+.1f%%, sensor noise %.1f%%, start (%.1f, %.1f, %.1f)\n", harness::AutonName(page), trackerError * 100,
+           noise * 100, start.x, start.y, start.theta);
+    Report("odometry only", drifting);
+    Report("relocalized", relocalized);
+    return 0;
+}
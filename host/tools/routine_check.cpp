@@ -0,0 +1,117 @@
+/**
+ * @file routine_check.cpp
+ * @brief Checks that routines never outlive their run: a killed auton's and an overflowing one's.
+ *
+ * Usage: routine_check
+ *
+ * The first case is an auton killed at the end of the period while its routines
+ * are parked, one of them on an action that never ends. The frames and the
+ * action outlive the auton task until disabled() and opcontrol() clean up, and
+ * the check runs that cleanup and confirms everything is freed and cancelled.
+ * The second case spawns more routines than the table holds and checks that the
+ * run stops at once, frees every routine, and leaves the tables ready for the
+ * next run. Exits 1 if any case fails.
+ */
+
+#include <cstdio>
+#include <vector>
+
+#include "harness/harness.hpp"
+#include "main.h"
+#include "subsystems.hpp"
+
+namespace {
+
+const int KILL_MS = 200;            // auton period for the killed run, well before anything it waits on
+const int TOO_MANY_ROUTINES = 16;   // more spawns than the root table holds
+const int FOREVER_MS = 60000;
+
+struct Case {
+    const char* name;
+    bool passed;
+};
+
+std::vector<Case> cases;
+
+void Check(const char* name, bool passed) { cases.push_back({name, passed}); }
+
+/// Counts its construction and destruction, so a check can tell a freed coroutine frame from a leaked one.
+struct Frame {
+    Frame() { framesMade++; }
+    ~Frame() { framesFreed++; }
+    static int framesMade;
+    static int framesFreed;
+};
+int Frame::framesMade = 0;
+int Frame::framesFreed = 0;
+
+bool Never() { return false; }
+
+ActionHandle stuckAction;
+
+Routine SleepForever() {
+    Frame frame;
+    co_await Sleep(FOREVER_MS);
+}
+
+Routine Stuck() {
+    Frame frame;
+    Spawn(SleepForever());
+    stuckAction = Watch(Never, NO_TIMEOUT);
+    co_await stuckAction;
+}
+
+Routine Overflow() {
+    Frame frame;
+    for (int i = 0; i < TOO_MANY_ROUTINES; i++)
+        Spawn(SleepForever());
+    co_await Sleep(FOREVER_MS);
+}
+
+Routine Short() { co_await Sleep(50); }
+
+}  // namespace
+
+int main() {
+    harness::Boot();
+
+    harness::Options options;
+    options.limitMs = KILL_MS;
+    options.routine = [] { RunRoutine(Stuck()); };
+    harness::RunAutonInProcess(options);
+    Check("killed auton leaves its frames parked", Frame::framesMade == 2 && Frame::framesFreed == 0);
+    Check("and its action running", stuckAction.Exit() == ActionExit::RUNNING);
+
+    // What disabled() and opcontrol() do once the field has killed autonomous
+    ClearRoutines();
+    CancelActions();
+    Check("clearing frees the root and spawned frames", Frame::framesFreed == 2);
+    Check("and cancels the action", stuckAction.Exit() == ActionExit::CANCELLED);
+
+    Frame::framesMade = 0;
+    Frame::framesFreed = 0;
+    std::uint32_t overflowMs = 0;
+    bool shortFinished = false;
+    options.limitMs = 5000;
+    options.routine = [&] {
+        std::uint32_t start = pros::millis();
+        RunRoutine(Overflow());
+        overflowMs = pros::millis() - start;
+
+        start = pros::millis();
+        RunRoutine(Short());
+        shortFinished = pros::millis() - start < (std::uint32_t)FOREVER_MS;
+    };
+    harness::Result result = harness::RunAutonInProcess(options);
+    Check("full routine table stops the run at once", result.finished && overflowMs <= (std::uint32_t)ez::util::DELAY_TIME);
+    Check("and frees every routine that started", Frame::framesMade > 1 && Frame::framesFreed == Frame::framesMade);
+    Check("the next run starts clean", shortFinished);
+
+    int failed = 0;
+    printf("Routine cleanup\n");
+    for (const Case& check : cases) {
+        printf("  %-46s %s\n", check.name, check.passed ? "ok" : "FAILED");
+        failed += !check.passed;
+    }
+    return failed > 0 ? 1 : 0;
+}
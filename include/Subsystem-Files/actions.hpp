@@ -0,0 +1,97 @@
+/**
+ * @file actions.hpp
+ * @brief Background timed actions: run for a time, run until a condition, and pulse patterns.
+ *
+ * An action starts its subsystem right away in the caller's task, then the
+ * scheduler's ActionsTick() switches and stops it on time, so an auton can
+ * start an intake pulse and keep driving. Every start returns an ActionHandle
+ * that can be polled, waited on, or cancelled. Watch() gives the same handle
+ * for a sensor event that drives nothing, and WaitAll()/WaitAny() wait on
+ * several handles at once.
+ *
+ * Every duration and timeout here means the same thing: 0 is no time at all,
+ * so an action ends on the next tick and a wait only checks once, and
+ * NO_TIMEOUT, or any negative, is no limit.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+
+/// A duration or timeout with no limit.
+const int NO_TIMEOUT = -1;
+
+/// How an action ended, or RUNNING while it hasn't.
+enum class ActionExit { RUNNING, TIME_UP, CONDITION_MET, CANCELLED };
+
+/// State shared between an action's handle and the engine running it.
+struct TimedAction;
+
+/// Handle to a background action. Copies refer to the same action, and stay valid after it ends.
+class ActionHandle {
+  public:
+    ActionHandle() = default;
+    explicit ActionHandle(std::shared_ptr<TimedAction> action) : action(std::move(action)) {}
+
+    /// How the action ended, RUNNING if it hasn't. An empty handle, or an action refused because
+    /// every slot was taken, reads as CANCELLED.
+    ActionExit Exit() const;
+
+    /// True once the action has ended for any reason.
+    bool Done() const { return Exit() != ActionExit::RUNNING; }
+
+    /// Blocks the calling task until the action ends or timeoutMs passes, returning Exit().
+    ActionExit Wait(int timeoutMs = NO_TIMEOUT) const;
+
+    /// Stops the action now, calling its stop function if it was still running.
+    void Cancel() const;
+
+  private:
+    std::shared_ptr<TimedAction> action;
+};
+
+/**
+ * @brief Runs `start`, then `stop` after durationMs.
+ *
+ * @param owner Subsystem the action drives. Starting an action cancels any other with the same owner,
+ *              nullptr for an action that never cancels or is cancelled by another
+ */
+ActionHandle RunFor(const char* owner, std::function<void()> start, std::function<void()> stop, int durationMs);
+
+/**
+ * @brief Runs `start`, then `stop` once `condition` returns true or timeoutMs passes.
+ *
+ * `condition` is checked every scheduler slot on the scheduler task, right after the sensor snapshot.
+ */
+ActionHandle RunUntil(const char* owner, std::function<void()> start, std::function<void()> stop, std::function<bool()> condition,
+                      int timeoutMs);
+
+/**
+ * @brief Alternates `on` for onMs and `off` for offMs until durationMs has passed, then runs `off`.
+ */
+ActionHandle Pulse(const char* owner, std::function<void()> on, std::function<void()> off, int onMs, int offMs, int durationMs);
+
+/**
+ * @brief Ends once `condition` returns true or timeoutMs passes, without driving anything.
+ *
+ * Lets an auton wait on a sensor event alongside other handles.
+ */
+ActionHandle Watch(std::function<bool()> condition, int timeoutMs);
+
+/// Blocks until every handle has ended or timeoutMs passes. True if they all ended.
+bool WaitAll(std::initializer_list<ActionHandle> handles, int timeoutMs = NO_TIMEOUT);
+
+/// Blocks until any handle has ended or timeoutMs passes. Index of the first ended handle, -1 on timeout.
+int WaitAny(std::initializer_list<ActionHandle> handles, int timeoutMs = NO_TIMEOUT);
+
+/// Cancels every running action, so nothing an auton started outlives it.
+void CancelActions();
+
+/// Advances every running action, called by the scheduler every ACTIONS_PERIOD_MS.
+void ActionsTick();
+
+/// Rate actions are advanced at.
+extern const int ACTIONS_PERIOD_MS;
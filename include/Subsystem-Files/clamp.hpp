@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include "Subsystem-Files/actions.hpp"
+#include "Subsystem-Files/sensor_snapshot.hpp"
+
 /// Opens the clamp to release the held object.
 void OpenClamp();
 
@@ -19,3 +22,9 @@ void ClampController();
 
 /// Returns true if a goal is detected and secured in the clamp.
 bool IsGoalClamped();
+
+/// Returns true if a goal reads at or above a proximity in a snapshot.
+bool IsGoalWithin(const SensorSnapshot& sensors, int proximity);
+
+/// Closes the clamp from the control tick once a goal is in reach, leading by the clamp's close time if asked.
+ActionHandle ClampOnGoal(int timeoutMs, bool lead = true);
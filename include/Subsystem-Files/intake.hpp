@@ -9,6 +9,8 @@
 #pragma once
 
 #include "main.h"
+#include "Subsystem-Files/sensor_snapshot.hpp"
+#include "Subsystem-Files/actions.hpp"
 
 /// Alliance colors and control logic.
 enum class AllianceMode { BLUE, RED, OFF };
@@ -35,9 +37,20 @@ bool RingColorCheck(AllianceMode aMode, double hue);
 void SetAllianceMode(AllianceMode aMode);
 AllianceMode GetAllianceMode();
 bool IsIntakeRunning();
+bool IsIntakeRunning(const SensorSnapshot& sensors);
 void CycleAllianceMode();
+void DisplayAllianceMode();
 void PulseIntakeBlocking(int ms);
 
-// Task-level control
-void IntakeController();
-extern pros::Task IntakeTask;
+// Background intake actions, return right away so the auton can keep driving
+ActionHandle PulseIntake(int ms);
+ActionHandle RunIntakeFor(IntakeSpeed speed, int ms);
+ActionHandle RunIntakeUntil(IntakeSpeed speed, std::function<bool()> condition, int timeoutMs);
+
+// Ring events to wait on, alone or with WaitAll()/WaitAny()
+ActionHandle WaitForRing(AllianceMode color, int timeoutMs);
+ActionHandle WaitForIntakeStall(int timeoutMs);
+
+// Scheduled control
+void IntakeTick();
+extern const int INTAKE_PERIOD_MS;
@@ -8,8 +8,20 @@
 
 #pragma once
 
-/// Starts the lift control task and manages scoring logic.
-void LiftController();
+#include "Subsystem-Files/actions.hpp"
+#include "Subsystem-Files/motion_profile.hpp"
+
+/// How the lift reaches its targets.
+enum class LiftMode {
+    DIRECT,    // step the PID target straight to the preset
+    PROFILED,  // follow a trapezoidal profile to the preset, with velocity and gravity feedforward
+};
+
+/// Runs one pass of the lift controller and its scoring logic, called by the scheduler.
+void LiftTick();
+
+/// Lets LiftTick() start driving the lift, called when autonomous or driver control begins.
+void LiftStart();
 
 /// Blocks until the lift reaches the target position.
 void WaitLadyBrown(int position);
@@ -17,12 +29,32 @@ void WaitLadyBrown(int position);
 /// Sets the lift to move to a new target position asynchronously.
 void AsyncLadyBrown(int position);
 
+/// Longest LiftTo() waits for the lift to settle by default, in ms.
+extern const int LIFT_SETTLE_TIMEOUT;
+
+/// Sends the lift to a target without blocking, returning a handle that ends once it settles there.
+ActionHandle LiftTo(int position, int timeoutMs = LIFT_SETTLE_TIMEOUT);
+
+/// True once the lift has reached its goal and stopped there.
+bool IsLiftSettled();
+
+/// Selects how the lift reaches its targets.
+void SetLiftMode(LiftMode mode);
+
+/// Sends the lift toward a new target; LiftTick() plans the profile in PROFILED mode.
+void SetLiftTarget(int position);
+
+/// True once the profile's setpoint has reached the target.
+bool IsLiftProfileDone();
+
 // Shared lift state
 extern bool scoreMode;
-extern pros::Task LiftTask;
 extern ez::PID liftPID;
 
 // Position presets
 extern const int BASE_POSITION;
 extern const int PRIMED_POSITION;
 extern const int WALLSTAKE_POSITION;
+
+// Loop rate
+extern const int LIFT_PERIOD_MS;
@@ -0,0 +1,71 @@
+/**
+ * @file loop_stats.hpp
+ * @brief Period, body time, and jitter tracking for the periodic task loops.
+ *
+ * Each loop owns a LoopStats that its body is bracketed into with
+ * TickStart()/TickEnd(), which the scheduler does for every tick. The results
+ * show on a blank page of the brain screen and can be dumped to the terminal
+ * and SD card, so a blocking call inside a loop shows up as late ticks and
+ * overruns.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/// Number of histogram buckets, the last one catches everything past LOOP_BUCKET_EDGES_US.
+const int LOOP_BUCKETS = 10;
+
+/// Upper edge of each histogram bucket but the last, in microseconds.
+extern const std::uint32_t LOOP_BUCKET_EDGES_US[LOOP_BUCKETS - 1];
+
+/// Timing statistics for one periodic loop.
+struct LoopStats {
+    /// Registers the loop so it shows on the screen page and in dumps.
+    LoopStats(const char* name, int periodMs);
+
+    /// Call at the top of the loop body.
+    void TickStart();
+
+    /// Call right before the loop's delay.
+    void TickEnd();
+
+    /// Clears every counter, the next tick starts a fresh period.
+    void Reset();
+
+    const char* name;
+    int periodMs;                     // period the loop is meant to run at
+
+    std::uint32_t ticks = 0;
+    std::uint32_t overruns = 0;       // ticks late by a full period or more, so at least one tick was missed
+    std::uint64_t periodTotalUs = 0;  // for the mean period
+    std::uint32_t maxPeriodUs = 0;
+    std::uint32_t maxBodyUs = 0;
+    std::uint32_t maxJitterUs = 0;    // largest distance of a period from periodMs
+
+    std::uint32_t lateHistogram[LOOP_BUCKETS] = {};  // how far past periodMs each tick started
+    std::uint32_t bodyHistogram[LOOP_BUCKETS] = {};  // how long each body ran, blocking delays included
+
+    std::uint64_t tickStartUs = 0;
+    std::uint64_t lastStartUs = 0;
+};
+
+/// Shows one line per loop, starting at `line` of the brain screen, paging through them if they don't fit.
+void LoopStatsScreenPrint(int line);
+
+/// Prints every loop's statistics and histograms to the terminal, and appends them to the SD card if one is in.
+void LoopStatsDump();
+
+/// Clears the statistics of every loop.
+void LoopStatsReset();
+
+// Instrumented loops
+extern LoopStats sensorsLoopStats;
+extern LoopStats odometryLoopStats;
+extern LoopStats trajectoryLoopStats;
+extern LoopStats actionsLoopStats;
+extern LoopStats triggersLoopStats;
+extern LoopStats intakeLoopStats;
+extern LoopStats liftLoopStats;
+extern LoopStats screenLoopStats;
+extern LoopStats driveLoopStats;
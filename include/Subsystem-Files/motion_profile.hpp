@@ -0,0 +1,53 @@
+/**
+ * @file motion_profile.hpp
+ * @brief Trapezoidal motion profile for one axis.
+ *
+ * Plans position and velocity over time from a start position and velocity to
+ * a stop at the end position, never passing the velocity or acceleration limit.
+ * The plan is up to four constant-acceleration segments: stopping a move in the
+ * wrong direction, speeding up, cruising, and slowing down.
+ */
+
+#pragma once
+
+/// Where a profile says the axis should be at one instant.
+struct ProfileState {
+    double position = 0;
+    double velocity = 0;       // units per second
+    double acceleration = 0;   // units per second squared
+};
+
+/// A planned move between two positions, sampled by time since it started.
+class TrapezoidProfile {
+  public:
+    /**
+     * @brief Plans a move that ends stopped at `end`.
+     *
+     * @param start Position the move starts from
+     * @param startVelocity Velocity at the start, clamped to maxVelocity
+     * @param end Position to stop at
+     * @param maxVelocity Largest speed, units per second
+     * @param maxAcceleration Largest acceleration, units per second squared
+     */
+    void Plan(double start, double startVelocity, double end, double maxVelocity, double maxAcceleration);
+
+    /// State `t` seconds after the start. Before 0 is the start state, after Duration() is stopped at the end.
+    ProfileState Sample(double t) const;
+
+    /// Seconds from start to stopped at the end.
+    double Duration() const;
+
+  private:
+    static const int MAX_SEGMENTS = 4;
+
+    /// A stretch of constant acceleration.
+    struct Segment {
+        double duration;
+        double acceleration;
+    };
+
+    ProfileState startState;
+    double endPosition = 0;
+    Segment segments[MAX_SEGMENTS];
+    int segmentCount = 0;
+};
@@ -0,0 +1,96 @@
+/**
+ * @file pose_estimator.hpp
+ * @brief Extended Kalman filter odometry fusing the trackers, drive encoders, and IMU.
+ *
+ * EZ's tracking task builds the pose from the two tracking wheels and the IMU
+ * alone. The estimator also uses the six drive motor encoders and the IMU
+ * accelerometer, weighting every sensor by its own noise model:
+ *
+ * - Forward travel is the vertical tracker and the drive encoders, fused by
+ *   their variances. The accelerometer is not a measurement of its own, it only
+ *   raises the encoders' noise while the robot is speeding up or being hit. The
+ *   encoders are dropped when they disagree with the tracker by more than slip
+ *   allows.
+ * - Sideways travel is the horizontal tracker.
+ * - Heading is predicted from the difference of the drive sides and corrected
+ *   by the IMU, which keeps the pose going if the IMU drops out.
+ *
+ * The filter state is x, y and heading with a 3x3 covariance. Each update
+ * records the pose in the pose history.
+ *
+ * The estimate is its own pose source and is never written into the chassis.
+ * Writing the chassis pose while EZ's tracking task integrates into it would
+ * race it, and EZ's motions are compiled into the library, so they can't be
+ * pointed at another pose. Everything that steers the robot therefore runs on
+ * EZ's tracker odometry: the EZ odom motions, the distance triggers and the
+ * brain screen. Only these read the estimate:
+ *
+ * - the pose history, which logs it,
+ * - the trajectory follower's RAMSETE controller,
+ * - the relocalizer, which also corrects it, in the host build only for now.
+ *
+ * Reset the pose through the estimator, which resets both.
+ */
+
+#pragma once
+
+#include "EZ-Template/api.hpp"
+#include "Subsystem-Files/pose_history.hpp"
+
+/// Pose estimate from every drive sensor, with the same getters as ez::Drive's odometry.
+class PoseEstimator {
+  public:
+    /// Reads every sensor and advances the filter one step, called by the scheduler.
+    void Update();
+
+    /// Current estimate, heading in degrees like chassis.odom_pose_get().
+    ez::pose odom_pose_get();
+    double odom_x_get();
+    double odom_y_get();
+    double odom_theta_get();
+
+    /// Moves the estimate and the chassis to a known pose and trusts it exactly.
+    /// The sensors are re-read, so call this after resetting them.
+    void odom_xyt_set(double x, double y, double theta);
+    void odom_xyt_set(okapi::QLength x, okapi::QLength y, okapi::QAngle theta);
+
+    /// Kalman update from a measurement of x and y with the same variance on each, like a relocalization.
+    void CorrectPosition(double x, double y, double variance);
+
+    /// Updates since the last reset where the drive encoders were dropped for slipping.
+    int SlipCount();
+
+  private:
+    /// Remembers every sensor's reading so the next update works from deltas.
+    void ReadLast();
+
+    /// Scalar Kalman correction of the heading by the IMU.
+    void CorrectHeading(double imuHeading, double variance);
+
+    pros::Mutex mutex;
+    double state[3] = {0, 0, 0};  // x and y in inches, heading in radians clockwise from +y
+    double covariance[3][3] = {};
+
+    double lastVertical = 0;      // tracker readings, inches
+    double lastHorizontal = 0;
+    double lastLeft = 0;          // drive side encoders, inches
+    double lastRight = 0;
+    double lastImu = 0;           // radians
+    int slipCount = 0;
+    PoseSample lastSample;        // last update's pose, for the velocity
+    bool poseReset = false;       // the pose was set since the last update, so the history starts over
+};
+
+extern PoseEstimator fusedOdom;
+
+/// Effective track width, drive side difference per radian of turn in inches.
+extern const double DRIVE_TRACK_WIDTH;
+
+/// Average of one drive side's encoders in inches, INFINITY when none of them read.
+double DriveSideInches(std::vector<pros::Motor>& motors);
+
+/// Runs fusedOdom.Update(), called by the scheduler.
+void OdometryTick();
+
+/// Rate the estimator updates at.
+extern const int ODOMETRY_PERIOD_MS;
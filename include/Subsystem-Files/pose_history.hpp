@@ -0,0 +1,53 @@
+/**
+ * @file pose_history.hpp
+ * @brief Timestamped history of odometry poses, readable from any task without locking.
+ *
+ * The odometry update pushes one sample per ODOMETRY_PERIOD_MS into a fixed ring.
+ * Events seen between odometry updates, like a ring crossing intakeOptical in a
+ * sensor snapshot, look up where the robot was at that instant with PoseAt() and
+ * the snapshot's timeUs. Readers never block the odometry task: each slot has a
+ * sequence number the writer bumps around its write, and a reader that catches a
+ * write in progress just reads again.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/// Where the robot was and how it was moving at one instant.
+struct PoseSample {
+    std::uint64_t timeUs = 0;    // pros::micros() when odometry read the sensors
+    double x = 0;                // inches
+    double y = 0;
+    double theta = 0;            // degrees, not wrapped
+    double xVelocity = 0;        // inches per second, field frame
+    double yVelocity = 0;
+    double angularVelocity = 0;  // degrees per second
+};
+
+/// Adds the newest sample. Only the odometry task may call this.
+void PoseHistoryPush(const PoseSample& sample);
+
+/**
+ * @brief The pose at `timeUs`, interpolated between the samples either side of it.
+ *
+ * Times up to two odometry periods past the newest sample are extrapolated from
+ * its velocity, so an event from this slot's snapshot still gets a pose.
+ *
+ * @param timeUs pros::micros() time to look up
+ * @param sample Filled in when the time is covered
+ * @return false if the time is older than the history holds or too far past the newest sample
+ */
+bool PoseAt(std::uint64_t timeUs, PoseSample& sample);
+
+/// Newest sample, all zeros before the first one.
+PoseSample PoseHistoryLatest();
+
+/// Forgets every sample, e.g. when the pose is reset. Only the odometry task may call this.
+void PoseHistoryClear();
+
+/// Writes every held sample, oldest first, as CSV to the SD card if one is in.
+void PoseHistoryDump();
+
+/// Samples the history holds, a bit over 80 s at the odometry rate.
+extern const int POSE_HISTORY_SIZE;
@@ -0,0 +1,178 @@
+/**
+ * @file routine.hpp
+ * @brief Coroutine auton routines: many logical threads of control on one task.
+ *
+ * A Routine is a C++20 coroutine that co_awaits chassis motions, subsystem
+ * handles and sensor events instead of blocking on them. RunRoutine() runs a
+ * routine and everything it spawns on the calling task, checking what each
+ * parked routine waits on every ez::util::DELAY_TIME, the same rate pid_wait()
+ * checks its exit conditions. Concurrent behaviors are Spawn()ed routines, not
+ * pros::Tasks, so they cost a coroutine frame instead of a task stack.
+ *
+ * Nothing inside a routine may block: use co_await Sleep(ms) instead of
+ * pros::delay(ms), and co_await a motion instead of chassis.pid_wait().
+ */
+
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "EZ-Template/api.hpp"
+#include "Subsystem-Files/actions.hpp"
+
+/// Something a routine can wait on. Checked once per step until it returns true.
+class Event {
+  public:
+    explicit Event(std::function<bool()> ready) : ready(std::move(ready)) {}
+
+    /// Happens when the action ends, for any reason.
+    Event(ActionHandle action) : ready([action] { return action.Done(); }) {}
+
+    bool operator()() { return ready(); }
+
+  private:
+    std::function<bool()> ready;
+};
+
+/// Waits on several events at once. co_await gives the index of the first one that happened.
+struct AnyOf {
+    std::vector<Event> events;
+};
+
+/// Parks the coroutine until an event happens, then resumes it with `result()`.
+template <class Result>
+struct EventAwaiter {
+    Event event;
+    std::function<Result()> result;
+
+    bool await_ready() { return event(); }
+    void await_suspend(std::coroutine_handle<> routine);
+    Result await_resume() { return result(); }
+};
+
+/// Parks a routine until `event` happens, resumed from RoutinesStep().
+void ParkRoutine(std::coroutine_handle<> routine, Event event);
+
+template <class Result>
+void EventAwaiter<Result>::await_suspend(std::coroutine_handle<> routine) {
+    ParkRoutine(routine, std::move(event));
+}
+
+/// A coroutine auton routine. co_await one from another routine to run it to the end.
+class Routine {
+  public:
+    struct promise_type {
+        std::coroutine_handle<> continuation;  // routine that co_awaited this one, empty if it was spawned
+        std::shared_ptr<bool> done;            // set when a spawned routine finishes
+
+        Routine get_return_object() { return Routine(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        /// Hands control back to whoever co_awaited this routine, or frees a spawned one.
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> routine) noexcept;
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+
+        EventAwaiter<void> await_transform(Event event) { return {std::move(event), [] {}}; }
+        EventAwaiter<ActionExit> await_transform(ActionHandle action) { return {Event(action), [action] { return action.Exit(); }}; }
+        EventAwaiter<int> await_transform(AnyOf any);
+        Routine&& await_transform(Routine&& child) { return std::move(child); }
+    };
+
+    Routine(Routine&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+    Routine(const Routine&) = delete;
+    ~Routine() {
+        if (handle) handle.destroy();
+    }
+
+    // co_await runs the routine now and resumes the caller once it finishes
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+        handle.promise().continuation = caller;
+        return handle;
+    }
+    void await_resume() noexcept {}
+
+  private:
+    explicit Routine(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    std::coroutine_handle<promise_type> handle;
+
+    friend Event Spawn(Routine routine);
+};
+
+/// Starts a routine alongside the current one. The event happens when it finishes.
+Event Spawn(Routine routine);
+
+/// Runs a routine and everything it spawns on the calling task until it finishes.
+/// Spawned routines still running at the end are stopped.
+void RunRoutine(Routine routine);
+
+/// Resumes every parked routine whose event has happened. Called by RunRoutine() each step.
+void RoutinesStep();
+
+/// Frees every routine a run left behind, e.g. when autonomous was stopped mid-routine.
+/// Call once the task that ran them is gone, it doesn't stop their actions.
+void ClearRoutines();
+
+/// Happens once `condition` returns true.
+Event Until(std::function<bool()> condition);
+
+/// Happens `ms` after it is created.
+Event Sleep(int ms);
+
+/// Happens once every event has.
+Event WhenAll(std::vector<Event> events);
+
+/// co_await gives the index of the first event to happen.
+AnyOf WhenAny(std::vector<Event> events);
+
+// Variadic forms, since GCC can't keep a braced list alive across a co_await
+template <class... Events>
+Event WhenAll(Events... events) {
+    return WhenAll(std::vector<Event>{Event(std::move(events))...});
+}
+
+template <class... Events>
+AnyOf WhenAny(Events... events) {
+    return WhenAny(std::vector<Event>{Event(std::move(events))...});
+}
+
+/// A chassis motion started from a routine. co_await it to wait for it to settle.
+class DriveMotion {
+  public:
+    DriveMotion(double startLeft, double startRight) : startLeft(startLeft), startRight(startRight) {}
+
+    /// Happens once a drive motion has passed `distance` from where it started, or can't get there.
+    Event Until(okapi::QLength distance) const;
+
+    /// Happens once a turn or swing has passed `angle`, or can't get there.
+    Event Until(okapi::QAngle angle) const;
+
+    /// Happens once the motion settles, the non-blocking chassis.pid_wait().
+    operator Event() const;
+
+  private:
+    double startLeft;   // drive sensors when the motion started
+    double startRight;
+};
+
+/// Starts a drive motion, like chassis.pid_drive_set().
+DriveMotion DriveDistance(okapi::QLength distance, int speed, bool slew = false);
+
+/// Starts a turn motion, like chassis.pid_turn_set().
+DriveMotion TurnTo(okapi::QAngle angle, int speed);
+
+/// Happens once the current chassis motion settles. Pure pursuit is checked against
+/// whichever point it is heading to, so wait on those with chassis.pid_wait() outside a routine.
+Event DriveSettled();
@@ -0,0 +1,34 @@
+/**
+ * @file scheduler.hpp
+ * @brief Fixed-rate scheduler for the subsystem control loops.
+ *
+ * Subsystems register a tick function with a period and a phase instead of
+ * running their own `while(1){...; pros::delay(10);}` task. Every shared tick
+ * runs from one task woken with pros::Task::delay_until every SCHEDULER_SLOT_MS,
+ * so periods don't drift with body time and ticks in the same slot run in the
+ * order they were added. Missed slots are skipped rather than run back to back.
+ */
+
+#pragma once
+
+#include "Subsystem-Files/loop_stats.hpp"
+
+/// Length of one scheduler slot in ms. Every period and phase is a multiple of this.
+const int SCHEDULER_SLOT_MS = 5;
+
+/**
+ * @brief Adds a tick function to the schedule. Call before SchedulerStart().
+ *
+ * Ticks run on the shared scheduler task and must never block. A tick that
+ * doesn't fit the table is not run, and says so on the terminal.
+ *
+ * @param name Name to report the tick by
+ * @param periodMs How often the tick runs, a multiple of SCHEDULER_SLOT_MS
+ * @param phaseMs Offset into the period the tick runs at, a multiple of SCHEDULER_SLOT_MS
+ * @param tick Function to call every period
+ * @param stats Loop statistics the tick is timed into
+ */
+void SchedulerAdd(const char* name, int periodMs, int phaseMs, void (*tick)(), LoopStats* stats);
+
+/// Starts the scheduler task.
+void SchedulerStart();
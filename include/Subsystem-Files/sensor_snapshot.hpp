@@ -0,0 +1,42 @@
+/**
+ * @file sensor_snapshot.hpp
+ * @brief One read of every mechanism sensor per scheduler slot.
+ *
+ * SensorsTick() runs first in every slot and reads each smart-port device the
+ * subsystems decide on exactly once. Controllers take a copy with
+ * GetSensorSnapshot() instead of calling the devices, so every decision made
+ * from one snapshot sees the same, timestamped data.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/// Every mechanism sensor reading from one slot.
+struct SensorSnapshot {
+    std::uint32_t tick = 0;            // snapshots taken before this one
+    std::uint64_t timeUs = 0;          // pros::micros() when the reads started
+
+    // Intake
+    double intakeHue = 0;              // intakeOptical hue, 0-360
+    double intakeVelocity = 0;         // mainIntake actual velocity, rpm
+    double intakeTargetVelocity = 0;   // mainIntake commanded velocity, rpm
+    double intakePosition = 0;         // mainIntake encoder, degrees the hooks have been driven
+    std::int32_t intakeCurrent = 0;    // mainIntake current draw, mA
+
+    // Clamp
+    std::int32_t clampProximity = 0;   // clampOptical proximity, 0-255
+    double clampHue = 0;               // clampOptical hue, 0-360
+
+    // Lift
+    std::int32_t liftPosition = 0;     // liftRotation position, centidegrees
+};
+
+/// Reads every sensor into a new snapshot and publishes it, called by the scheduler.
+void SensorsTick();
+
+/// Returns a copy of the latest snapshot, safe to call from any task.
+SensorSnapshot GetSensorSnapshot();
+
+/// Rate the snapshot is refreshed at.
+extern const int SENSORS_PERIOD_MS;
@@ -0,0 +1,72 @@
+/**
+ * @file tracker_calibration.hpp
+ * @brief Calibrates the tracking wheels and IMU from one short maneuver with a least-squares fit.
+ *
+ * The robot starts with its back square against a wall and a few feet clear in
+ * front. Twice, it backs off the wall far enough for the back distance sensor to
+ * read, drives straight out, spins two full turns, drives back, and backs into
+ * the wall to square up again. Every sensor is logged each step the whole way, and
+ * one fit afterwards gives:
+ *
+ * - the IMU scaler, from the IMU's total against the whole turns the wall says
+ *   the robot made, fit for each spin direction and averaged,
+ * - each tracker's distance to center, from how much it reads per radian of turn,
+ * - the vertical tracking wheel's diameter scale, from the straight legs against
+ *   the back distance sensor. The horizontal wheel's can't be measured on a
+ *   drive that doesn't slide sideways and is left as set,
+ * - the drive's effective track width, from the drive sides' difference per
+ *   radian of the spins.
+ *
+ * The fit's RMS residual per tracker is how much that tracker's readings don't
+ * follow the robot's motion. A tracker that skips or isn't sprung onto the floor
+ * shows up there before it shows up as drift.
+ */
+
+#pragma once
+
+#include "Subsystem-Files/routine.hpp"
+
+/// What the maneuver was doing when a sample was logged.
+enum class CalibrationPhase { STILL, DRIVE, TURN, SQUARE };
+
+/// Every sensor the fit uses, at one instant.
+struct CalibrationSample {
+    CalibrationPhase phase = CalibrationPhase::STILL;
+    double vertical = 0;       // tracker readings, inches at the diameter set now
+    double horizontal = 0;
+    double left = 0;           // drive side encoders, inches
+    double right = 0;
+    double imu = 0;            // degrees, before the IMU scaler
+    double backDistance = 0;   // inches, NAN without a reading to trust
+};
+
+/// What the fit found.
+struct TrackerCalibration {
+    double verticalOffset = 0;      // inches, for distance_to_center_set()
+    double horizontalOffset = 0;    // at the horizontal tracker's set diameter
+    double verticalScale = 1;       // true travel per inch the vertical tracker reads now
+    double imuScaler = 1;           // for drive_imu_scaler_set(), the mean of the two directions
+    double imuScalerClockwise = 0;  // each direction's own, 0 without a spin that way to fit it to
+    double imuScalerCounterClockwise = 0;
+    double trackWidth = 0;          // inches, effective, for DRIVE_TRACK_WIDTH, 0 without a turn to fit it to
+    double verticalResidual = 0;    // RMS inches per sample
+    double horizontalResidual = 0;
+    int samples = 0;                // moving samples the offsets were fit to
+    bool scaleMeasured = false;     // verticalScale, false when the distance sensor never gave a straight leg to compare with
+    bool headingMeasured = false;   // false when the maneuver never ended a turn square against the wall
+};
+
+/**
+ * @brief Fits the offsets, wheel scale and IMU scaler to a logged maneuver. No devices, so it runs the same on a host.
+ *
+ * @param samples The log, oldest first
+ * @param count Samples in the log
+ * @param imuScaler The scaler the robot had while logging, to tell which whole turn the robot squared up at
+ */
+TrackerCalibration FitTrackerCalibration(const CalibrationSample* samples, int count, double imuScaler);
+
+/// Runs the maneuver, fits it, and sets the trackers and IMU scaler. Prints the fit and warns about a slipping tracker.
+Routine CalibrateTrackers();
+
+/// The last calibration, also shown on the brain screen.
+TrackerCalibration LastTrackerCalibration();
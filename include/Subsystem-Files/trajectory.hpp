@@ -0,0 +1,107 @@
+/**
+ * @file trajectory.hpp
+ * @brief Time-optimal quintic spline trajectories from squiggles, followed wheel by wheel.
+ *
+ * EZ's odom motions chase a point and slow down by PID as they get near it. A
+ * trajectory goes through waypoints that each have a heading. Squiggles fits
+ * quintic splines between them and works out the fastest speed along the curve
+ * that the drive's velocity, acceleration and jerk limits allow. The outer wheel
+ * sets the limit in a turn. That work runs once, in initialize().
+ *
+ * TrajectoryTick() plays a trajectory back on the clock, so the robot is where
+ * the plan says at each moment and a mechanism can be timed to it. Each side
+ * gets the voltage for its wheel speed and acceleration plus feedback, from one
+ * of two controllers:
+ *
+ * - WHEEL_FEEDBACK: the planned wheel speeds, with PD on how far each side is
+ *   behind or ahead of the plan. Follows the shape from wherever it starts.
+ * - RAMSETE: speeds from the pose error against the fused odometry, so drift
+ *   and bumps are steered out and the robot ends where the plan ends on the
+ *   field.
+ *
+ * EZ's Drive modes are compiled into the EZ-Template library. The follower
+ * therefore runs as its own scheduler tick and drives through
+ * chassis.drive_set(), which keeps EZ's PID out of the way until the next EZ
+ * motion.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "EZ-Template/api.hpp"
+#include "Subsystem-Files/routine.hpp"
+
+/// Every trajectory. Add one here and give it an entry in AUTON_TRAJECTORIES.
+enum class TrajectoryId {
+    SPLINE_EXAMPLE,
+    COUNT
+};
+
+/// How the follower turns the plan into wheel speeds.
+enum class TrajectoryController {
+    WHEEL_FEEDBACK,   // planned wheel speeds, corrected by each side's encoder travel
+    RAMSETE           // planned speed and turn rate, corrected by the odometry pose
+};
+
+/// A trajectory as the auton describes it.
+struct TrajectorySpec {
+    TrajectoryId id;
+    std::vector<ez::united_pose> waypoints;   // odom poses to drive through facing forward, the first is where the robot starts
+};
+
+/// Every trajectory the autons drive, defined next to the autons in autons.cpp.
+extern const TrajectorySpec AUTON_TRAJECTORIES[];
+extern const int AUTON_TRAJECTORY_COUNT;
+
+/// One instant of a generated trajectory.
+struct TrajectoryPoint {
+    double time = 0;              // s from the start
+    double x = 0, y = 0;          // odom inches
+    double theta = 0;             // degrees, EZ's convention, not wrapped
+    double velocity = 0;          // in/s along the path
+    double acceleration = 0;      // in/s^2
+    double curvature = 0;         // 1/in, positive turning clockwise
+    double leftVelocity = 0;      // in/s
+    double rightVelocity = 0;
+    double leftAcceleration = 0;  // in/s^2
+    double rightAcceleration = 0;
+    double leftDistance = 0;      // in each side has travelled since the start
+    double rightDistance = 0;
+};
+
+/// Generates every trajectory in AUTON_TRAJECTORIES. Call from initialize(), it takes a while.
+void TrajectoryBuild();
+
+/// A generated trajectory, empty if it wasn't built.
+const std::vector<TrajectoryPoint>& TrajectoryGet(TrajectoryId id);
+
+/// The trajectory's point at `time` seconds, interpolated, held at the ends.
+TrajectoryPoint TrajectorySample(const std::vector<TrajectoryPoint>& trajectory, double time);
+
+/// Starts following a trajectory from the robot's current pose, which should be its first waypoint.
+void TrajectoryStart(TrajectoryId id, TrajectoryController controller = TrajectoryController::WHEEL_FEEDBACK);
+
+/// True until the trajectory ends and the robot has settled on its end.
+bool TrajectoryRunning();
+
+/// Seconds into the trajectory being followed, 0 when none is.
+double TrajectoryElapsed();
+
+/// Stops following and stops the drive.
+void TrajectoryStop();
+
+/// Blocks until the trajectory ends, the chassis.pid_wait() for trajectories.
+void TrajectoryWait();
+
+/// Happens once the trajectory ends, to co_await from a routine.
+Event TrajectoryDone();
+
+/// Happens once the trajectory being followed is `seconds` in, or has ended.
+Event TrajectoryAt(double seconds);
+
+/// Commands the drive from the trajectory being followed, called by the scheduler.
+void TrajectoryTick();
+
+/// Rate the follower runs at.
+extern const int TRAJECTORY_PERIOD_MS;
@@ -0,0 +1,55 @@
+/**
+ * @file triggers.hpp
+ * @brief Registered "when this, do that" triggers checked every scheduler slot.
+ *
+ * A trigger pairs a condition with a response. TriggersTick() checks every
+ * registered condition once per slot, right after the sensor snapshot, and runs
+ * the response on the scheduler task the slot it turns true. That replaces auton
+ * code polling a sensor in its own loop, and reacts within one slot.
+ */
+
+#pragma once
+
+#include <functional>
+
+#include "EZ-Template/api.hpp"
+
+/// Whether a trigger stays registered after it fires.
+enum class TriggerMode {
+    ONCE,    // fire the first time the condition holds, then remove itself
+    REPEAT,  // fire every time the condition turns from false to true
+};
+
+/**
+ * @brief Registers a trigger.
+ *
+ * Responses run on the scheduler task with the trigger table locked, so they must
+ * be quick and must not add or remove triggers. Setting motors or pistons is fine.
+ *
+ * @param name Shown in the log when the table is full
+ * @return Id for TriggerRemove(), -1 if the table is full
+ */
+int TriggerAdd(const char* name, std::function<bool()> condition, std::function<void()> response, TriggerMode mode = TriggerMode::ONCE);
+
+/// Removes a trigger whether or not it has fired. Ids of removed triggers are ignored.
+void TriggerRemove(int id);
+
+/// Removes every trigger, e.g. at the start of a new auton.
+void TriggersClear();
+
+/// Checks every trigger and fires the ones whose condition holds, called by the scheduler.
+void TriggersTick();
+
+/// Rate triggers are checked at.
+extern const int TRIGGERS_PERIOD_MS;
+
+// Conditions for common triggers
+
+/// True once odometry has passed `target`, measured along the line from where the robot was when this was made.
+std::function<bool()> OdomPassed(ez::united_pose target);
+
+/// True while the clamp optical reads a proximity above `proximity`.
+std::function<bool()> ClampProximityAbove(int proximity);
+
+/// True while the intake draws more than `milliamps`.
+std::function<bool()> IntakeCurrentAbove(int milliamps);
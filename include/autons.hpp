@@ -89,6 +89,9 @@ void odom_boomerang_example();
 /// Combines boomerang and pure pursuit for complex paths.
 void odom_boomerang_injected_pure_pursuit_example();
 
+/// Follows a squiggles spline trajectory with RAMSETE, then drives back with odom.
+void odom_spline_example();
+
 /// Runs turn calibration to compute odometry tracker wheel offsets.
 void measure_offsets();
 
@@ -9,6 +9,16 @@
 #include "Subsystem-Files/intake.hpp"
 #include "Subsystem-Files/lift.hpp"
 #include "Subsystem-Files/comp_timer.hpp"
+#include "Subsystem-Files/loop_stats.hpp"
+#include "Subsystem-Files/scheduler.hpp"
+#include "Subsystem-Files/sensor_snapshot.hpp"
+#include "Subsystem-Files/actions.hpp"
+#include "Subsystem-Files/routine.hpp"
+#include "Subsystem-Files/triggers.hpp"
+#include "Subsystem-Files/pose_history.hpp"
+#include "Subsystem-Files/pose_estimator.hpp"
+#include "Subsystem-Files/tracker_calibration.hpp"
+#include "Subsystem-Files/trajectory.hpp"
 
 // EZ Constructors
 extern Drive chassis;
@@ -33,4 +43,5 @@ extern pros::adi::DigitalIn selectButton;
 extern pros::Rotation liftRotation;
 extern pros::Optical clampOptical;
 extern pros::Optical intakeOptical;
+extern pros::Distance backDistance;
 
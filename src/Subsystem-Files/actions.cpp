@@ -0,0 +1,229 @@
+/**
+ * @file actions.cpp
+ * @brief Background timed actions: run for a time, run until a condition, and pulse patterns.
+ *
+ * Running actions sit in a fixed table guarded by one mutex. Actions are
+ * created and cancelled from auton tasks and advanced from the scheduler task,
+ * so start/stop callbacks run with the mutex held and must not start or cancel
+ * actions themselves.
+ */
+
+#include "main.h"
+#include "subsystems.hpp"
+#include <cstring>
+
+const int ACTIONS_PERIOD_MS = SCHEDULER_SLOT_MS;  // advanced every slot so pulse edges land within 5 ms
+const int MAX_ACTIONS = 8;                        // actions that can run at once
+
+/// One background action. Owned jointly by the engine while running and by its handles.
+struct TimedAction {
+    const char* owner;
+    std::function<void()> on;
+    std::function<void()> off;
+    std::function<bool()> condition;  // empty unless started with RunUntil
+    int onMs = 0;                     // pulse on time, 0 holds `on` for the whole action
+    int offMs = 0;                    // pulse off time
+    std::uint32_t endTime = 0;        // when the action runs out of time
+    bool timed = true;                // false for NO_TIMEOUT, ends only on its condition or a cancel
+    std::uint32_t switchTime = 0;     // next pulse edge
+    bool isOn = true;
+    std::atomic<ActionExit> exit{ActionExit::RUNNING};
+};
+
+std::shared_ptr<TimedAction> runningActions[MAX_ACTIONS];
+pros::Mutex actionsMutex;
+
+// Timing of the action engine
+LoopStats actionsLoopStats{"Actions", ACTIONS_PERIOD_MS};
+
+
+/**
+ * @brief Ends an action: runs its stop function and records why. Call with actionsMutex held.
+ *
+ * @param slot Table slot of the running action
+ * @param exit Why it ended
+ */
+void EndAction(int slot, ActionExit exit) {
+    std::shared_ptr<TimedAction> action = std::move(runningActions[slot]);
+    if (action->off) action->off();
+    action->exit = exit;
+}
+
+
+/**
+ * @brief Starts an action in the caller's task and hands it to the engine.
+ *
+ * Cancels any running action with the same owner first, so two actions never fight over a subsystem.
+ * Actions without an owner are left alone.
+ * If every slot is taken the new action is refused and never started; its handle
+ * reads CANCELLED right away. Running actions are never evicted, since one of
+ * them may be another subsystem's or a Watch() a routine is waiting on.
+ */
+ActionHandle StartAction(std::shared_ptr<TimedAction> action, int durationMs) {
+    std::uint32_t now = pros::millis();
+    action->endTime = now + std::max(durationMs, 0);
+    action->timed = durationMs >= 0;
+    action->switchTime = now + action->onMs;
+
+    actionsMutex.take();
+    int slot = -1;
+    for (int i = 0; i < MAX_ACTIONS; i++) {
+        if (action->owner && runningActions[i] && runningActions[i]->owner && std::strcmp(runningActions[i]->owner, action->owner) == 0)
+            EndAction(i, ActionExit::CANCELLED);
+        if (!runningActions[i] && slot < 0)
+            slot = i;
+    }
+    if (slot < 0) {
+        actionsMutex.give();
+        printf("Action table full, %s action not started\n", action->owner ? action->owner : "an ownerless");
+        action->exit = ActionExit::CANCELLED;
+        return ActionHandle(std::move(action));
+    }
+
+    if (action->on) action->on();
+    runningActions[slot] = action;
+    actionsMutex.give();
+
+    return ActionHandle(std::move(action));
+}
+
+
+/** @brief Starts `start` now and `stop` after durationMs. */
+ActionHandle RunFor(const char* owner, std::function<void()> start, std::function<void()> stop, int durationMs) {
+    auto action = std::make_shared<TimedAction>();
+    action->owner = owner;
+    action->on = std::move(start);
+    action->off = std::move(stop);
+    return StartAction(std::move(action), durationMs);
+}
+
+
+/** @brief Starts `start` now and `stop` once `condition` holds or timeoutMs passes. */
+ActionHandle RunUntil(const char* owner, std::function<void()> start, std::function<void()> stop, std::function<bool()> condition,
+                      int timeoutMs) {
+    auto action = std::make_shared<TimedAction>();
+    action->owner = owner;
+    action->on = std::move(start);
+    action->off = std::move(stop);
+    action->condition = std::move(condition);
+    return StartAction(std::move(action), timeoutMs);
+}
+
+
+/** @brief Alternates `on` and `off` for durationMs, starting with `on`, and ends on `off`. */
+ActionHandle Pulse(const char* owner, std::function<void()> on, std::function<void()> off, int onMs, int offMs, int durationMs) {
+    auto action = std::make_shared<TimedAction>();
+    action->owner = owner;
+    action->on = std::move(on);
+    action->off = std::move(off);
+    action->onMs = std::max(1, onMs);
+    action->offMs = std::max(1, offMs);
+    return StartAction(std::move(action), durationMs);
+}
+
+
+/** @brief Starts an ownerless action that ends once `condition` holds or timeoutMs passes. */
+ActionHandle Watch(std::function<bool()> condition, int timeoutMs) {
+    auto action = std::make_shared<TimedAction>();
+    action->owner = nullptr;
+    action->condition = std::move(condition);
+    return StartAction(std::move(action), timeoutMs);
+}
+
+
+/**
+ * @brief Polls every handle each DELAY_TIME until they have all ended or the timeout passes.
+ */
+bool WaitAll(std::initializer_list<ActionHandle> handles, int timeoutMs) {
+    std::uint32_t start = pros::millis();
+    while (true) {
+        bool allDone = true;
+        for (const ActionHandle& handle : handles)
+            allDone = allDone && handle.Done();
+        if (allDone) return true;
+        if (timeoutMs >= 0 && pros::millis() - start >= (std::uint32_t)timeoutMs) return false;
+        pros::delay(ez::util::DELAY_TIME);
+    }
+}
+
+
+/**
+ * @brief Polls every handle each DELAY_TIME until one has ended or the timeout passes.
+ */
+int WaitAny(std::initializer_list<ActionHandle> handles, int timeoutMs) {
+    std::uint32_t start = pros::millis();
+    while (true) {
+        int index = 0;
+        for (const ActionHandle& handle : handles) {
+            if (handle.Done()) return index;
+            index++;
+        }
+        if (timeoutMs >= 0 && pros::millis() - start >= (std::uint32_t)timeoutMs) return -1;
+        pros::delay(ez::util::DELAY_TIME);
+    }
+}
+
+
+/**
+ * @brief Ends actions whose condition is met or time is up, and flips pulses at their edges.
+ */
+void ActionsTick() {
+    std::uint32_t now = pros::millis();
+
+    actionsMutex.take();
+    for (int i = 0; i < MAX_ACTIONS; i++) {
+        TimedAction* action = runningActions[i].get();
+        if (!action) continue;
+
+        if (action->condition && action->condition()) {
+            EndAction(i, ActionExit::CONDITION_MET);
+        } else if (action->timed && now >= action->endTime) {
+            EndAction(i, ActionExit::TIME_UP);
+        } else if (action->onMs > 0 && now >= action->switchTime) {
+            action->isOn = !action->isOn;
+            if (action->isOn && action->on) action->on();
+            if (!action->isOn && action->off) action->off();
+            action->switchTime += action->isOn ? action->onMs : action->offMs;
+        }
+    }
+    actionsMutex.give();
+}
+
+
+/** @brief How the action ended, RUNNING until it does. */
+ActionExit ActionHandle::Exit() const { return action ? action->exit.load() : ActionExit::CANCELLED; }
+
+
+/**
+ * @brief Polls the action every DELAY_TIME from the calling task until it ends or the timeout passes.
+ */
+ActionExit ActionHandle::Wait(int timeoutMs) const {
+    std::uint32_t start = pros::millis();
+    while (!Done() && (timeoutMs < 0 || pros::millis() - start < (std::uint32_t)timeoutMs))
+        pros::delay(ez::util::DELAY_TIME);
+    return Exit();
+}
+
+
+/** @brief Ends the action now if it is still in the table. */
+void ActionHandle::Cancel() const {
+    if (!action) return;
+
+    actionsMutex.take();
+    for (int i = 0; i < MAX_ACTIONS; i++) {
+        if (runningActions[i] == action)
+            EndAction(i, ActionExit::CANCELLED);
+    }
+    actionsMutex.give();
+}
+
+
+/** @brief Ends every action still in the table. */
+void CancelActions() {
+    actionsMutex.take();
+    for (int i = 0; i < MAX_ACTIONS; i++) {
+        if (runningActions[i])
+            EndAction(i, ActionExit::CANCELLED);
+    }
+    actionsMutex.give();
+}
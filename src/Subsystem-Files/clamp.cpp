@@ -8,9 +8,20 @@
 
 #include "main.h"
 #include "subsystems.hpp"
+#include <algorithm>
 
 const int GOAL_HUE_MIN = 62;  // hue lower bound
 const int GOAL_HUE_MAX = 94;  // hue upper bound
+const int GOAL_PROXIMITY = 180;  // proximity 0-255 with a goal in the clamp
+
+// Clamp trigger lead, so the clamp closes on the goal instead of one piston stroke past it
+// UNMEASURED: the close time and proximity slope are estimates, time the piston and log the
+// optical backing into a goal before the autons drop their creep and distance close (host/tools/clamp_check)
+const int CLAMP_CLOSE_TIME = 80;               // ms from firing the solenoid to the clamp gripping
+const int CLAMP_SENSE_LATENCY = 10;            // ms, average age of a reading: half the 15 ms optical integration plus the snapshot
+const double GOAL_PROXIMITY_PER_INCH = 30;     // proximity rise per inch over the last few inches of approach
+const int GOAL_MIN_PROXIMITY = 40;             // lowest threshold the lead may drop to, clear of the optical's noise up to about 15
+const double CLAMP_MAX_LEAD = (GOAL_PROXIMITY - GOAL_MIN_PROXIMITY) / GOAL_PROXIMITY_PER_INCH;   // in, 4.7
 
 /**
  * @brief Opens the ring clamp.
@@ -31,15 +42,25 @@ const int GOAL_HUE_MAX = 94;  // hue upper bound
 /**
  * @brief Checks if a valid ring is detected in the clamp.
  *
- * Uses proximity and hue thresholds to determine if a green goal object
- * is clamped close enough to be considered secured.
+ * Uses proximity and hue thresholds from the latest sensor snapshot to determine
+ * if a green goal object is clamped close enough to be considered secured.
  *
  * @return true if a green ring is present in close proximity.
  */
-bool IsGoalClamped(){
+bool IsGoalClamped(){ return IsGoalWithin(GetSensorSnapshot(), GOAL_PROXIMITY); }
+
+
+/**
+ * @brief Checks if a goal is in front of the clamp optical at least as close as a proximity.
+ *
+ * @param sensors Snapshot to check
+ * @param proximity Proximity 0-255 the goal has to reach
+ * @return true if a green goal reads at or above that proximity.
+ */
+bool IsGoalWithin(const SensorSnapshot& sensors, int proximity){
     // Proximity 0-255, check for close proximity and correct color hue
-    if(clampOptical.get_proximity() > 180){
-        int hue = clampOptical.get_hue();
+    if(sensors.clampProximity > proximity){
+        int hue = sensors.clampHue;
         if(hue > GOAL_HUE_MIN && hue < GOAL_HUE_MAX){
             return true;
         }
@@ -48,6 +69,44 @@ bool IsGoalClamped(){
 }
 
 
+/**
+ * @brief Closes the clamp from the control tick the moment the goal is in reach.
+ *
+ * Checked every scheduler slot right after the sensor snapshot. With lead on, the
+ * trigger fires early by however far the robot backs up while the piston closes
+ * and the reading ages, worked out from the drive sensors between snapshots, so a
+ * fast approach grips on contact instead of after it.
+ *
+ * @param timeoutMs Longest to wait for the goal
+ * @param lead Whether to fire early for the clamp's close time
+ * @return Handle that ends CONDITION_MET once the clamp has fired, TIME_UP if no goal came
+ */
+ActionHandle ClampOnGoal(int timeoutMs, bool lead){
+    auto lastTimeUs = std::make_shared<std::uint32_t>(0);
+    auto lastDistance = std::make_shared<double>(0);
+
+    auto inReach = [lead, lastTimeUs, lastDistance] {
+        SensorSnapshot sensors = GetSensorSnapshot();
+        double distance = (chassis.drive_sensor_left() + chassis.drive_sensor_right()) / 2;
+
+        // The clamp is on the back, so the goal closes in while the drive runs backwards
+        double leadInches = 0;
+        if(lead && *lastTimeUs != 0 && sensors.timeUs != *lastTimeUs){
+            double speed = (*lastDistance - distance) * 1e6 / (sensors.timeUs - *lastTimeUs);
+            leadInches = std::clamp(speed * (CLAMP_CLOSE_TIME + CLAMP_SENSE_LATENCY) / 1000.0, 0.0, CLAMP_MAX_LEAD);
+        }
+        *lastTimeUs = sensors.timeUs;
+        *lastDistance = distance;
+
+        if(!IsGoalWithin(sensors, GOAL_PROXIMITY - leadInches * GOAL_PROXIMITY_PER_INCH)) return false;
+        CloseClamp();
+        return true;
+    };
+
+    return RunUntil("Clamp", {}, {}, inReach, timeoutMs);
+}
+
+
 /**
  * @brief Handles manual clamp input using the R2 button.
  *
@@ -28,6 +28,38 @@ int intakeStartTime = 0;
 int lastRunningTime = 0;
 bool wasIntakeStopped = true;
 
+// Color sort ring travel, in mainIntake degrees past the optical sensor. Measured on the
+// encoder so the eject point doesn't move with intake speed or battery. Start values are
+// the old 60 ms and 230 ms delays at FAST (100/127 of 600 rpm, about 2.8 deg per ms).
+const double EJECT_FRONT_TRAVEL = 170;  // before reversing a ring out the front
+const double EJECT_TOP_TRAVEL = 650;    // before stopping to throw a ring off the top
+
+// Color sort and recovery timings, in ms
+const int EJECT_FRONT_REVERSE = 425;  // how long to reverse to spit a ring out the front
+const int EJECT_TOP_STOP = 150;       // how long to stop so the ring flies off the hooks
+const int UNJAM_REVERSE = 180;        // how long to reverse out of a jam
+const int SCORE_BACKOFF = 30;         // how long to reverse when the lady brown scores
+const int PULSE_TIME = 80;            // on and off time of an intake pulse
+
+/// What the intake tick is doing with the motors. Anything but NONE holds off driver commands until it ends.
+enum class IntakeAction { NONE, EJECT_STOP, EJECT_REVERSE, UNJAM, SCORE_BACKOFF };
+IntakeAction intakeAction = IntakeAction::NONE;
+int intakeActionEnd = 0;
+
+/// A wrong-color ring seen by the intake optical and waiting to be ejected.
+struct TrackedRing {
+    double seenAt;  // mainIntake position when the optical saw it
+    bool front;     // eject out the front instead of off the top
+};
+const int MAX_TRACKED_RINGS = 4;
+TrackedRing trackedRings[MAX_TRACKED_RINGS];
+int trackedRingCount = 0;
+bool sawWrongColor = false;           // last tick's color check, so each ring is only tracked once
+
+// Intake loop rate and its timing
+const int INTAKE_PERIOD_MS = 10;
+LoopStats intakeLoopStats{"Intake", INTAKE_PERIOD_MS};
+
 
 /**
  * @brief Directly sets motor speeds for front and main intakes.
@@ -102,18 +134,25 @@ void IntakeDown(){ intakePiston.set_value(true); }
  *
  * Uses velocity thresholds to infer intake motor activity.
  *
+ * @param sensors Snapshot to check
  * @return true if intake is moving; false otherwise.
  */
-bool IsIntakeRunning() {
-    double mainIntakeVelocity = mainIntake.get_actual_velocity();
-    double frontIntakeVelocity = frontIntake.get_actual_velocity();
+bool IsIntakeRunning(const SensorSnapshot& sensors) {
     double velocityThreshold = 100.0;
 
     // Return true only if the main intake is running
-    return (std::abs(mainIntakeVelocity) > velocityThreshold);
+    return (std::abs(sensors.intakeVelocity) > velocityThreshold);
 }
 
 
+/**
+ * @brief Determines if intake is currently running, from the latest sensor snapshot.
+ *
+ * @return true if intake is moving; false otherwise.
+ */
+bool IsIntakeRunning() { return IsIntakeRunning(GetSensorSnapshot()); }
+
+
 /**
  * @brief Checks if a hue matches the rejection condition for the selected alliance.
  *
@@ -204,23 +243,8 @@ AllianceMode GetAllianceMode(){
  * @return IntakeExit enum indicating result (TIMEOUT or RING_DETECTED)
  */
 IntakeExit IntakeWait(AllianceMode aMode, int maxWaitTimeMs) {
-    int startTime = pros::millis(); // Record the start time
-
-    // Flip the alliance mode (because we're waiting for as specific color)
-    switch (aMode) {
-        case AllianceMode::BLUE:
-            aMode = AllianceMode::RED;
-            break;
-        case AllianceMode::RED:
-            aMode = AllianceMode::BLUE;
-            break;
-    }
-
-    while (!RingColorCheck(aMode, intakeOptical.get_hue())) {
-        if (pros::millis() - startTime >= maxWaitTimeMs) {
-            return IntakeExit::TIMEOUT;
-        }
-        pros::delay(10);
+    if (WaitForRing(aMode, maxWaitTimeMs).Wait() != ActionExit::CONDITION_MET) {
+        return IntakeExit::TIMEOUT;
     }
 
     RunIntake(IntakeSpeed::STOP);
@@ -229,51 +253,190 @@ IntakeExit IntakeWait(AllianceMode aMode, int maxWaitTimeMs) {
 }
 
 
+/**
+ * @brief Returns a handle that ends once the intake optical sees a ring of one color.
+ *
+ * @param color Ring color to wait for
+ * @param timeoutMs Longest to wait in milliseconds
+ * @return Handle that ends CONDITION_MET on the ring, TIME_UP if none comes
+ */
+ActionHandle WaitForRing(AllianceMode color, int timeoutMs) {
+    // Flip the alliance mode (because RingColorCheck looks for the opposite color)
+    AllianceMode opposite = AllianceMode::OFF;
+    switch (color) {
+        case AllianceMode::BLUE: opposite = AllianceMode::RED; break;
+        case AllianceMode::RED: opposite = AllianceMode::BLUE; break;
+        case AllianceMode::OFF: break;
+    }
+
+    return Watch([opposite] { return RingColorCheck(opposite, GetSensorSnapshot().intakeHue); }, timeoutMs);
+}
+
+
+/**
+ * @brief Returns a handle that ends once the intake is driven but can't turn.
+ *
+ * With scoreMode on the hooks stall against a ring seated in the lady brown,
+ * so this is the ring-loaded event. Stalls during spin-up don't count.
+ *
+ * @param timeoutMs Longest to wait in milliseconds
+ * @return Handle that ends CONDITION_MET on a stall, TIME_UP if none comes
+ */
+ActionHandle WaitForIntakeStall(int timeoutMs) {
+    return Watch([] {
+        SensorSnapshot sensors = GetSensorSnapshot();
+        return !IsIntakeRunning(sensors) && std::abs(sensors.intakeTargetVelocity) > 0 &&
+               (int)pros::millis() - intakeStartTime > INTAKE_SPINUP_TIME;
+    }, timeoutMs);
+}
+
+
 /**
  * @brief Pulses the intake motor on and off repeatedly for a given duration.
  *
+ * Blocks the calling task until the pulse ends, use PulseIntake() to keep going.
+ *
  * @param ms Total pulse duration in milliseconds
  */
 void PulseIntakeBlocking(int ms) {
-    const int pulseTime = 80;
-    int elapsed = 0;
+    PulseIntake(ms).Wait();
+}
+
+
+/**
+ * @brief Pulses the intake FAST and STOP in the background, ending stopped.
+ *
+ * @param ms Total pulse duration in milliseconds
+ * @return Handle to wait on or cancel the pulse
+ */
+ActionHandle PulseIntake(int ms) {
+    return Pulse("Intake", [] { RunIntake(IntakeSpeed::FAST); }, [] { RunIntake(IntakeSpeed::STOP); }, PULSE_TIME, PULSE_TIME, ms);
+}
+
+
+/**
+ * @brief Runs the intake at a speed in the background, then stops it.
+ *
+ * @param speed IntakeSpeed enum
+ * @param ms How long to run in milliseconds
+ * @return Handle to wait on or cancel the run
+ */
+ActionHandle RunIntakeFor(IntakeSpeed speed, int ms) {
+    return RunFor("Intake", [speed] { RunIntake(speed); }, [] { RunIntake(IntakeSpeed::STOP); }, ms);
+}
 
-    while (elapsed < ms) {
+
+/**
+ * @brief Runs the intake at a speed in the background until a condition holds, then stops it.
+ *
+ * The condition is checked on the scheduler task right after each sensor snapshot,
+ * e.g. `[] { return RingColorCheck(AllianceMode::BLUE, GetSensorSnapshot().intakeHue); }`.
+ *
+ * @param speed IntakeSpeed enum
+ * @param condition Returns true when the intake should stop
+ * @param timeoutMs Longest to run in milliseconds
+ * @return Handle to wait on or cancel the run, CONDITION_MET or TIME_UP once it ends
+ */
+ActionHandle RunIntakeUntil(IntakeSpeed speed, std::function<bool()> condition, int timeoutMs) {
+    return RunUntil("Intake", [speed] { RunIntake(speed); }, [] { RunIntake(IntakeSpeed::STOP); }, std::move(condition), timeoutMs);
+}
+
+
+/**
+ * @brief Starts an intake action that owns the motors until it ends.
+ *
+ * @param action What the intake is doing
+ * @param speed Speed to hold for the action
+ * @param durationMs How long the action lasts
+ */
+void StartIntakeAction(IntakeAction action, IntakeSpeed speed, int durationMs){
+    RunIntake(speed);
+    intakeAction = action;
+    intakeActionEnd = pros::millis() + durationMs;
+}
+
+
+/**
+ * @brief Ends the current intake action once its time is up.
+ *
+ * Ejects and jam recovery go back to running the intake, the lady brown
+ * backoff leaves the motors to the next driver command.
+ */
+void UpdateIntakeAction(){
+    if(intakeAction == IntakeAction::NONE || (int)pros::millis() < intakeActionEnd) return;
+
+    if(intakeAction != IntakeAction::SCORE_BACKOFF)
         RunIntake(IntakeSpeed::FAST);
-        pros::delay(pulseTime);
-        elapsed += pulseTime;
+    intakeAction = IntakeAction::NONE;
+}
+
+
+/**
+ * @brief Tracks wrong-color rings and ejects each once it has travelled far enough.
+ *
+ * A ring is tracked when the color check turns true, so a second ring seen while
+ * the first is still being ejected gets its own eject instead of being missed.
+ * Travel is how far the hooks have turned since, so it stands still while the
+ * intake is stopped and runs backwards while it reverses.
+ *
+ * @param sensors This tick's sensor snapshot
+ * @param running Whether the intake is moving
+ */
+void UpdateColorSort(const SensorSnapshot& sensors, bool running){
+    bool wrongColor = RingColorCheck(intakeMode, sensors.intakeHue);
 
-        if (elapsed >= ms) break;
+    // Only color sort if the intake is running!
+    if(running && wrongColor && !sawWrongColor && trackedRingCount < MAX_TRACKED_RINGS){
+        master.rumble(".");
 
-        RunIntake(IntakeSpeed::STOP);
-        pros::delay(pulseTime);
-        elapsed += pulseTime ;
+        // reverse out of the front when staging lady brown or when manually set
+        trackedRings[trackedRingCount++] = {sensors.intakePosition, scoreMode || ejectFront};
     }
+    sawWrongColor = wrongColor;
 
-    RunIntake(IntakeSpeed::STOP);
+    // Let a running eject finish before starting the next
+    if(intakeAction != IntakeAction::NONE || trackedRingCount == 0) return;
+    const TrackedRing& ring = trackedRings[0];
+    double travel = sensors.intakePosition - ring.seenAt;
+
+    // reverse out of the front, which takes every ring behind it out too
+    if(ring.front && travel >= EJECT_FRONT_TRAVEL){
+        StartIntakeAction(IntakeAction::EJECT_REVERSE, IntakeSpeed::REVERSE, EJECT_FRONT_REVERSE);
+        trackedRingCount = 0;
+    }
+
+    // throw ring off the top
+    else if(!ring.front && travel >= EJECT_TOP_TRAVEL){
+        StartIntakeAction(IntakeAction::EJECT_STOP, IntakeSpeed::STOP, EJECT_TOP_STOP);
+        for(int i = 1; i < trackedRingCount; i++)
+            trackedRings[i - 1] = trackedRings[i];
+        trackedRingCount--;
+    }
 }
 
 
 /**
- * @brief Intake task loop for both driver control and autonomous.
+ * @brief One pass of the intake controller, for both driver control and autonomous.
  *
  * Handles jam recovery, color-based ejection, piston control, alliance detection,
- * and interaction with the scoring subsystem. Should be launched as a task.
+ * and interaction with the scoring subsystem. Never blocks: ejects, jam recovery
+ * and the lady brown backoff are timed actions that hold the motors for a few
+ * ticks while everything else keeps running. Runs from the scheduler every
+ * INTAKE_PERIOD_MS.
  */
-void IntakeController(){
+void IntakeTick(){
+    int now = pros::millis();
 
-    // Display mode on Startup
-    DisplayAllianceMode();
+    UpdateIntakeAction();
 
-    while(1){
+    // Driver Control Task - main block requires autonomous mode off and disable mode off
+    if(!pros::competition::is_autonomous() && !pros::competition::is_disabled()){
         
-        // Driver Control Task - main block requires autonomous mode off and disable mode off
-        if(!pros::competition::is_autonomous() && !pros::competition::is_disabled()){
-            
-            // ensure rejecting reverts to auto mode after autonomous
-            SetRejectMode(EjectMode::AUTO);
+        // ensure rejecting reverts to auto mode after autonomous
+        SetRejectMode(EjectMode::AUTO);
 
-            // run main intake
+        // run main intake, unless an eject or recovery is holding it
+        if(intakeAction == IntakeAction::NONE){
             if(master.get_digital(pros::E_CONTROLLER_DIGITAL_R1)){
                 RunIntake(IntakeSpeed::FAST);
             } else if(master.get_digital(pros::E_CONTROLLER_DIGITAL_B)){
@@ -281,75 +444,48 @@ void IntakeController(){
             } else {
                 RunIntake(IntakeSpeed::STOP);
             }
+        }
 
-            // Reverse intake slightly when scoring with lady brown
-            if(scoreMode && master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_L1)){
-                RunIntake(IntakeSpeed::REVERSE);
-                pros::delay(30);
-            } 
-
-            // Intake Piston Control -- almost never needed
-            if(master.get_digital(pros::E_CONTROLLER_DIGITAL_X))
-                IntakeUp();
-            else
-                IntakeDown();
-
-            // Manual Allianace Color Swap -- almost never needed
-            if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_Y)) {
-                CycleAllianceMode();
-            }
+        // Reverse intake slightly when scoring with lady brown
+        if(scoreMode && master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_L1) && intakeAction == IntakeAction::NONE){
+            StartIntakeAction(IntakeAction::SCORE_BACKOFF, IntakeSpeed::REVERSE, SCORE_BACKOFF);
+        } 
 
-        }
-        
-        // Always run jam detection & color sorting
-        int hue = intakeOptical.get_hue();
-        pros::lcd::print(6, "BLUE: %d, RED: %d", RingColorCheck(AllianceMode::RED, hue), RingColorCheck(AllianceMode::BLUE, hue));
-        pros::lcd::print(7, "Intake Running: %d", IsIntakeRunning());
-
-        // Only color sort if the intake is running!
-        if(IsIntakeRunning()){
-            lastRunningTime = pros::millis();
-
-            // reverse intake when a ring is detected
-            if (RingColorCheck(intakeMode, intakeOptical.get_hue())){
-                master.rumble(".");
-                
-                // reverse out of the front
-                // check for lady brown staging and manual set flag
-                if(scoreMode || ejectFront){
-                    pros::delay(60);
-                    RunIntake(IntakeSpeed::REVERSE);
-                    pros::delay(425);
-                    RunIntake(IntakeSpeed::FAST);
-                } 
-                
-                // throw ring off the top
-                else {
-                    pros::delay(230);
-                    RunIntake(IntakeSpeed::STOP);
-                    pros::delay(150);
-                    RunIntake(IntakeSpeed::FAST);
-                }
+        // Intake Piston Control -- almost never needed
+        if(master.get_digital(pros::E_CONTROLLER_DIGITAL_X))
+            IntakeUp();
+        else
+            IntakeDown();
 
-            }
-        } else {
-            // Check if intake should be running but hasn't moved for the delay time
-            if (std::abs(mainIntake.get_target_velocity()) > 0 && 
-                (pros::millis() - lastRunningTime) > JAM_DETECTION_DELAY && 
-                (pros::millis() - intakeStartTime) > INTAKE_SPINUP_TIME) {
-                
-                // make sure we're not scoring lady brown rings
-                if(!scoreMode){
-                    RunIntake(IntakeSpeed::REVERSE);
-                    pros::delay(180);
-                    RunIntake(IntakeSpeed::FAST);
-                }
+        // Manual Allianace Color Swap -- almost never needed
+        if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_Y)) {
+            CycleAllianceMode();
+        }
 
-            }
+    }
+    
+    // Always run jam detection & color sorting, every decision below sees the same readings
+    SensorSnapshot sensors = GetSensorSnapshot();
+    bool running = IsIntakeRunning(sensors);
+    int hue = sensors.intakeHue;
+    pros::lcd::print(6, "BLUE: %d, RED: %d", RingColorCheck(AllianceMode::RED, hue), RingColorCheck(AllianceMode::BLUE, hue));
+    pros::lcd::print(7, "Intake Running: %d", running);
+
+    if(running)
+        lastRunningTime = now;
+
+    UpdateColorSort(sensors, running);
+
+    // Check if intake should be running but hasn't moved for the delay time
+    if (!running && intakeAction == IntakeAction::NONE &&
+        std::abs(sensors.intakeTargetVelocity) > 0 && 
+        (now - lastRunningTime) > JAM_DETECTION_DELAY && 
+        (now - intakeStartTime) > INTAKE_SPINUP_TIME) {
+        
+        // make sure we're not scoring lady brown rings
+        if(!scoreMode){
+            StartIntakeAction(IntakeAction::UNJAM, IntakeSpeed::REVERSE, UNJAM_REVERSE);
         }
 
-        pros::delay(ez::util::DELAY_TIME);
     }
 }
-pros::Task IntakeTask(IntakeController);
-
@@ -9,6 +9,8 @@
 
 #include "main.h"
 #include "subsystems.hpp"
+#include "okapi/api/filter/emaFilter.hpp"
+#include <cmath>
 #include <cstdint>
 
 const int BASE_POSITION = 9000;          // Default resting height
@@ -16,82 +18,286 @@ const int PRIMED_POSITION = 10800;       // Slightly lifted "ready to score" hei
 const int WALLSTAKE_POSITION = 23500;    // Full extension height for scoring
 
 bool scoreMode = false;                  // Global scoring mode toggle
+bool liftRunning = false;                // Set once the lift controller should start driving the motors
+
+const int LIFT_PERIOD_MS = 5;            // Lift loop rate, matches the rotation sensor data rate
 
 /// PID controller instance for lift motor group
 /// @param kP Proportional gain
 /// @param kI Integral gain
-/// @param kD Derivative gain
+/// @param kD Derivative gain (unused, LiftTick() adds LIFT_KD on the filtered velocity)
 /// @param kF Feedforward (unused)
 /// @param name PID name for debugging
-ez::PID liftPID{0.044, 0, 0.16, 0, "Lift"};
+ez::PID liftPID{0.044, 0, 0, 0, "Lift"};
+
+// Derivative term, run on the arm's measured velocity against the setpoint's velocity
+const double LIFT_KD = 0.0016;               // motor command per cdeg/s of velocity error
+const double LIFT_VELOCITY_SMOOTHING = 0.3;  // EMA alpha, weight of the newest sample, ~12 ms lag at 5 ms
+const int LIFT_STALE_SAMPLE_US = 50000;      // a gap this long restarts the velocity estimate
+
+std::uint32_t liftSampleTick = UINT32_MAX;   // snapshot the controller last ran on
+std::uint32_t liftSampleTimeUs = 0;          // when that snapshot was read
+int liftSamplePosition = 0;
+double liftVelocity = 0;                     // filtered arm velocity, cdeg/s
+okapi::EmaFilter liftVelocityFilter{LIFT_VELOCITY_SMOOTHING};
+
+// Timing of the lift loop
+LoopStats liftLoopStats{"Lift", LIFT_PERIOD_MS};
+
+// Profiled moves, in rotation sensor centidegrees. The arm tops out near 40000 cdeg/s
+// (green motors through the 3:1 arm gearing), the limits leave some headroom.
+// UNTUNED: everything from here to the settle limits is worked out on paper, not
+// measured. Tune on the robot before trusting the profile:
+//  - LIFT_LEVEL_POSITION: read the sensor with the arm held level.
+//  - LIFT_KG: raise it until the arm holds level with no PID.
+//  - LIFT_KV and LIFT_KA: fit them to logged velocity steps.
+const double LIFT_MAX_VELOCITY = 32000;      // cdeg/s
+const double LIFT_MAX_ACCELERATION = 200000; // cdeg/s^2
+const double LIFT_KV = 127.0 / 40000;        // motor command per cdeg/s of planned velocity
+const double LIFT_KA = LIFT_KV * 0.05;       // motor command per cdeg/s^2, covers the motor's ~50 ms spin-up
+const double LIFT_KG = 12;                   // motor command that holds the arm level against gravity
+const int LIFT_LEVEL_POSITION = 18000;       // sensor reading with the arm level, it hangs straight down at BASE_POSITION
+
+// Lift settle, the arm is done moving once it is this close and this slow
+const int LIFT_SETTLE_ERROR = 50;            // cdeg from the goal
+const int LIFT_SETTLE_VELOCITY = 500;        // cdeg/s
+const int LIFT_SETTLE_TIMEOUT = 1500;        // ms, a full base to wallstake swing takes ~700
+
+// Set from any task under liftMutex, LiftTick() plans from them on the scheduler task
+pros::Mutex liftMutex;
+LiftMode liftMode = LiftMode::DIRECT;       // PROFILED waits on the UNTUNED constants above
+int liftGoal = BASE_POSITION;                // preset the lift is heading to
+bool liftReplan = true;                      // the goal or mode changed since LiftTick() last planned
+
+// Written by LiftTick() under liftMutex, read by IsLiftProfileDone() from any task
+TrapezoidProfile liftProfile;
+std::uint32_t liftProfileStart = 0;          // pros::millis() the current profile started at
+ProfileState liftSetpoint;                   // where the profile has the arm this tick
+
+
+/**
+ * @brief Selects how the lift reaches its targets.
+ *
+ * @param mode PROFILED follows a trapezoidal profile with feedforward, DIRECT steps the PID target
+ */
+void SetLiftMode(LiftMode mode){
+    liftMutex.take();
+    liftMode = mode;
+    liftReplan = true;
+    liftMutex.give();
+}
+
+
+/**
+ * @brief Sends the lift toward a new target.
+ *
+ * Only records the goal, from whichever task calls it. LiftTick() steps the PID
+ * target or plans the profile on its next pass, so the controller never runs
+ * on a half-written profile.
+ *
+ * @param position Target lift position in encoder ticks
+ */
+void SetLiftTarget(int position){
+    liftMutex.take();
+    if(position != liftGoal){
+        liftGoal = position;
+        liftReplan = true;
+    }
+    liftMutex.give();
+}
+
+
+/**
+ * @brief Checks whether the lift profile has finished planning its move.
+ *
+ * @return true once the setpoint has reached the target, always true in DIRECT mode, false until a new goal is planned
+ */
+bool IsLiftProfileDone(){
+    liftMutex.take();
+    bool done = !liftReplan &&
+                (liftMode == LiftMode::DIRECT || (pros::millis() - liftProfileStart) / 1000.0 >= liftProfile.Duration());
+    liftMutex.give();
+    return done;
+}
+
+
+/**
+ * @brief Checks whether the lift has reached its goal and stopped there.
+ *
+ * @return true once the profile is done and the arm is within LIFT_SETTLE_ERROR and below LIFT_SETTLE_VELOCITY
+ */
+bool IsLiftSettled(){
+    liftMutex.take();
+    int goal = liftGoal;
+    liftMutex.give();
+    return IsLiftProfileDone() &&
+           std::abs(GetSensorSnapshot().liftPosition - goal) <= LIFT_SETTLE_ERROR &&
+           std::fabs(liftVelocity) <= LIFT_SETTLE_VELOCITY;
+}
 
 
 /**
- * @brief Lift controller task loop.
+ * @brief Takes a new goal or mode into the controller. Runs on the scheduler task.
+ *
+ * In PROFILED mode a new goal plans a profile from where the arm is now,
+ * carrying over the planned velocity so retargeting mid-swing stays smooth.
+ *
+ * @param position Arm position to plan from
+ * @return The mode to run this tick in
+ */
+LiftMode LiftReplan(int position){
+    liftMutex.take();
+    LiftMode mode = liftMode;
+    if(liftReplan){
+        liftReplan = false;
+        if(mode == LiftMode::DIRECT){
+            liftPID.target_set(liftGoal);
+        } else {
+            liftProfile.Plan(position, liftSetpoint.velocity, liftGoal, LIFT_MAX_VELOCITY, LIFT_MAX_ACCELERATION);
+            liftProfileStart = pros::millis();
+        }
+    }
+    liftMutex.give();
+    return mode;
+}
+
+
+/**
+ * @brief Gravity feedforward for the arm at a sensor position.
+ *
+ * Torque from the arm's weight goes with the cosine of its angle from level,
+ * so it is zero hanging down at BASE_POSITION and largest when level.
+ *
+ * @param position Rotation sensor reading in centidegrees
+ * @return Motor command that cancels gravity
+ */
+double LiftGravityFeedforward(double position){
+    double angle = (position - LIFT_LEVEL_POSITION) / 100.0 * M_PI / 180.0;
+    return LIFT_KG * std::cos(angle);
+}
+
+
+/**
+ * @brief Updates the filtered arm velocity from a new sensor sample.
+ *
+ * Velocity comes from the snapshot timestamps rather than the nominal loop
+ * period, so a late tick doesn't read as the arm speeding up. That's also why
+ * this isn't okapi's VelMath: it stamps each sample with its own timer when
+ * step() is called, which is the lift tick's time, not when the sensor was read.
+ * The smoothing is okapi's EmaFilter.
+ *
+ * @param snapshot Sensor snapshot the controller is running on
+ */
+void UpdateLiftVelocity(const SensorSnapshot& snapshot){
+    std::uint32_t elapsedUs = snapshot.timeUs - liftSampleTimeUs;
+
+    if(elapsedUs == 0 || elapsedUs > LIFT_STALE_SAMPLE_US){
+        liftVelocityFilter = okapi::EmaFilter(LIFT_VELOCITY_SMOOTHING);
+        liftVelocity = 0;
+    } else {
+        double sample = (snapshot.liftPosition - liftSamplePosition) * 1e6 / elapsedUs;
+        liftVelocity = liftVelocityFilter.filter(sample);
+    }
+
+    liftSampleTick = snapshot.tick;
+    liftSampleTimeUs = snapshot.timeUs;
+    liftSamplePosition = snapshot.liftPosition;
+}
+
+
+/**
+ * @brief Starts the lift controller once autonomous or driver control begins.
+ *
+ * Until then LiftTick() leaves the lift motors alone.
+ */
+void LiftStart(){ liftRunning = true; }
+
+
+/**
+ * @brief One pass of the lift controller.
  *
  * Responds to operator input to toggle scoring mode and set lift targets accordingly.
- * Uses sensor feedback and PID control to precisely position the lift.
+ * Uses sensor feedback and PID control to precisely position the lift. Runs from
+ * the scheduler every LIFT_PERIOD_MS, right after the rotation sensor is sampled,
+ * and only drives the motors when there is a new sample to run on.
  */
-void LiftController(){
-
-    // pre-set base target position
-    liftPID.target_set(BASE_POSITION);
-
-    // block this task until signalled to begin
-    while(pros::Task::notify_take(true, TIMEOUT_MAX));
-
-    while(1){
-
-        // Op-Control Task
-        if(!pros::competition::is_autonomous()){
-            // Toggle Scoring Mode Button 
-            if(master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_L2)){
-                if(scoreMode)
-                    master.rumble(".");
-                else
-                    master.rumble("..");
-                
-                scoreMode = !scoreMode;
-            }
+void LiftTick(){
+
+    // hold off until signalled to begin
+    if(!liftRunning) return;
+
+    // Op-Control Task
+    if(!pros::competition::is_autonomous()){
+        // Toggle Scoring Mode Button 
+        if(master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_L2)){
+            if(scoreMode)
+                master.rumble(".");
+            else
+                master.rumble("..");
             
-            // Send lift to score while holding, cancel target when released
-            if(scoreMode && master.get_digital(pros::E_CONTROLLER_DIGITAL_L1)){
-                liftPID.target_set(WALLSTAKE_POSITION);
-            } else {
-                // Base Case: Target Base pos or Primed pos
-                if(scoreMode)
-                    liftPID.target_set(PRIMED_POSITION);
-                else
-                    liftPID.target_set(BASE_POSITION);
-
-            }
+            scoreMode = !scoreMode;
         }
+        
+        // Send lift to score while holding, cancel target when released
+        if(scoreMode && master.get_digital(pros::E_CONTROLLER_DIGITAL_L1)){
+            SetLiftTarget(WALLSTAKE_POSITION);
+        } else {
+            // Base Case: Target Base pos or Primed pos
+            if(scoreMode)
+                SetLiftTarget(PRIMED_POSITION);
+            else
+                SetLiftTarget(BASE_POSITION);
 
-        // always set motors to the PID Target
-        ladyBrown.move(liftPID.compute(liftRotation.get_position())); 
+        }
+    }
 
-        pros::delay(ez::util::DELAY_TIME);
+    SensorSnapshot snapshot = GetSensorSnapshot();
+    LiftMode mode = LiftReplan(snapshot.liftPosition);
+    if(snapshot.tick == liftSampleTick) return;
+    UpdateLiftVelocity(snapshot);
 
+    int position = snapshot.liftPosition;
+
+    // always set motors to the PID Target, damping toward zero velocity
+    if(mode == LiftMode::DIRECT){
+        liftSetpoint = {(double)position, 0, 0};   // a switch to PROFILED starts planning from rest
+        ladyBrown.move(liftPID.compute(position) - LIFT_KD * liftVelocity); 
+        return;
     }
+
+    // PID tracks the profile, feedforward supplies what the profile and gravity need
+    liftSetpoint = liftProfile.Sample((pros::millis() - liftProfileStart) / 1000.0);
+    liftPID.target_set(liftSetpoint.position);
+    double damping = LIFT_KD * (liftSetpoint.velocity - liftVelocity);
+    double feedforward = LIFT_KV * liftSetpoint.velocity + LIFT_KA * liftSetpoint.acceleration + LiftGravityFeedforward(position);
+    ladyBrown.move(liftPID.compute(position) + damping + feedforward);
 }
-pros::Task LiftTask(LiftController);
 
 
 /**
  * @brief Waits until the lift reaches a specified target position.
  *
- * This is a blocking function that halts progress until the PID controller exits.
+ * This is a blocking function that halts progress until the lift settles,
+ * use LiftTo() to keep going while it moves.
  *
  * @param position Target lift position in encoder ticks
  */
 void WaitLadyBrown(int position){
-    liftPID.target_set(position);
+    LiftTo(position).Wait();
+}
 
-    // wait on the lift to exit
-    while (liftPID.exit_condition(true) == ez::RUNNING) {
-        pros::delay(ez::util::DELAY_TIME);
-    }
 
+/**
+ * @brief Sends the lift to a target and returns a handle that ends once it settles there.
+ *
+ * Sending the lift somewhere else cancels the handle.
+ *
+ * @param position Target lift position in encoder ticks
+ * @param timeoutMs Longest to wait for the lift to settle
+ * @return Handle that ends CONDITION_MET once settled, TIME_UP if it never does
+ */
+ActionHandle LiftTo(int position, int timeoutMs){
+    return RunUntil("Lift", [position] { SetLiftTarget(position); }, {}, IsLiftSettled, timeoutMs);
 }
 
 /**
@@ -99,4 +305,4 @@ void WaitLadyBrown(int position){
  *
  * @param position Target lift position in encoder ticks
  */
-void AsyncLadyBrown(int position){ liftPID.target_set(position); }
+void AsyncLadyBrown(int position){ SetLiftTarget(position); }
@@ -0,0 +1,193 @@
+/**
+ * @file loop_stats.cpp
+ * @brief Period, body time, and jitter tracking for the periodic task loops.
+ *
+ * Keeps a registry of every LoopStats so they can all be shown on the brain,
+ * dumped, or reset together. Recording a tick only does integer math on fixed
+ * arrays, so it is cheap enough to leave in every loop.
+ */
+
+#include "main.h"
+#include "subsystems.hpp"
+#include <cstdio>
+
+const std::uint32_t LOOP_BUCKET_EDGES_US[LOOP_BUCKETS - 1] = {
+    500, 1000, 2000, 5000, 10000, 50000, 100000, 250000, 500000,
+};
+
+const int MAX_LOOPS = 12;                             // loops the registry has room for
+const char* LOOP_STATS_LOG = "/usd/loop_stats.txt";   // SD card file dumps are appended to
+const int SCREEN_LINES = 8;                           // lines on the brain screen
+const int LOOP_STATS_PAGE_MS = 2000;                  // how long each page of loops shows
+
+LoopStats* loopRegistry[MAX_LOOPS];
+int loopCount = 0;
+
+
+/**
+ * @brief Finds the histogram bucket for a duration.
+ *
+ * @param us Duration in microseconds
+ * @return Index of the first bucket whose edge is at or past `us`
+ */
+int LoopBucket(std::uint32_t us) {
+    int bucket = 0;
+    while (bucket < LOOP_BUCKETS - 1 && us > LOOP_BUCKET_EDGES_US[bucket])
+        bucket++;
+    return bucket;
+}
+
+
+/**
+ * @brief Creates a loop's statistics and adds them to the registry.
+ *
+ * @param name Name shown on the screen and in dumps
+ * @param periodMs Period the loop is meant to run at
+ */
+LoopStats::LoopStats(const char* name, int periodMs) : name(name), periodMs(periodMs) {
+    if (loopCount < MAX_LOOPS)
+        loopRegistry[loopCount++] = this;
+}
+
+
+/**
+ * @brief Records the time since the last tick started as this loop's period.
+ */
+void LoopStats::TickStart() {
+    tickStartUs = pros::micros();
+
+    // The first tick after a reset has no period to measure
+    if (lastStartUs != 0) {
+        std::uint32_t periodUs = tickStartUs - lastStartUs;
+        std::uint32_t targetUs = periodMs * 1000;
+        std::uint32_t lateUs = periodUs > targetUs ? periodUs - targetUs : 0;
+        std::uint32_t jitterUs = periodUs > targetUs ? lateUs : targetUs - periodUs;
+
+        ticks++;
+        periodTotalUs += periodUs;
+        if (periodUs > maxPeriodUs) maxPeriodUs = periodUs;
+        if (jitterUs > maxJitterUs) maxJitterUs = jitterUs;
+        if (lateUs >= targetUs) overruns++;
+        lateHistogram[LoopBucket(lateUs)]++;
+    }
+    lastStartUs = tickStartUs;
+}
+
+
+/**
+ * @brief Records how long the body since TickStart() took.
+ */
+void LoopStats::TickEnd() {
+    std::uint32_t bodyUs = pros::micros() - tickStartUs;
+    if (bodyUs > maxBodyUs) maxBodyUs = bodyUs;
+    bodyHistogram[LoopBucket(bodyUs)]++;
+}
+
+
+/** @brief Clears this loop's counters and histograms. */
+void LoopStats::Reset() {
+    ticks = overruns = 0;
+    periodTotalUs = 0;
+    maxPeriodUs = maxBodyUs = maxJitterUs = 0;
+    for (int i = 0; i < LOOP_BUCKETS; i++)
+        lateHistogram[i] = bodyHistogram[i] = 0;
+    lastStartUs = 0;
+}
+
+
+/**
+ * @brief Mean period of a loop in ms, or 0 before its second tick.
+ */
+double LoopMeanPeriodMs(const LoopStats& loop) {
+    return loop.ticks == 0 ? 0.0 : loop.periodTotalUs / 1000.0 / loop.ticks;
+}
+
+
+/**
+ * @brief Shows one line per loop: mean and max period, max body time, and overruns.
+ *
+ * When the loops don't all fit below `line`, the first line says which page is
+ * showing and the pages take turns every LOOP_STATS_PAGE_MS.
+ *
+ * @param line First brain screen line to print to
+ */
+void LoopStatsScreenPrint(int line) {
+    int rows = SCREEN_LINES - line;
+    int first = 0;
+    if (loopCount > rows) {
+        rows--;
+        int pages = (loopCount + rows - 1) / rows;
+        int page = pros::millis() / LOOP_STATS_PAGE_MS % pages;
+        first = page * rows;
+        ez::screen_print("Loops " + std::to_string(first + 1) + "-" + std::to_string(std::min(first + rows, loopCount)) + " of " +
+                             std::to_string(loopCount),
+                         line++);
+    }
+
+    for (int i = 0; i < rows; i++) {
+        if (first + i >= loopCount) {
+            ez::screen_print("", line + i);
+            continue;
+        }
+        const LoopStats& loop = *loopRegistry[first + i];
+        char text[64];
+        snprintf(text, sizeof(text), "%-9s %5.1f/%4lu ms  body %4lu  ovr %lu", loop.name, LoopMeanPeriodMs(loop),
+                 (unsigned long)(loop.maxPeriodUs / 1000), (unsigned long)(loop.maxBodyUs / 1000), (unsigned long)loop.overruns);
+        ez::screen_print(text, line + i);
+    }
+}
+
+
+/**
+ * @brief Writes one histogram as "<=edge:count" pairs, skipping empty buckets.
+ */
+void LoopHistogramPrint(FILE* out, const char* label, const std::uint32_t* histogram) {
+    fprintf(out, "  %-5s", label);
+    for (int i = 0; i < LOOP_BUCKETS; i++) {
+        if (histogram[i] == 0) continue;
+        if (i < LOOP_BUCKETS - 1)
+            fprintf(out, " <=%gms:%lu", LOOP_BUCKET_EDGES_US[i] / 1000.0, (unsigned long)histogram[i]);
+        else
+            fprintf(out, " >%gms:%lu", LOOP_BUCKET_EDGES_US[i - 1] / 1000.0, (unsigned long)histogram[i]);
+    }
+    fprintf(out, "\n");
+}
+
+
+/**
+ * @brief Writes every loop's statistics to a stream.
+ */
+void LoopStatsWrite(FILE* out) {
+    fprintf(out, "Loop stats at %lu ms\n", (unsigned long)pros::millis());
+    for (int i = 0; i < loopCount; i++) {
+        const LoopStats& loop = *loopRegistry[i];
+        fprintf(out, "%s: %lu ticks at %d ms, mean %.2f ms, max %.1f ms, max jitter %.1f ms, max body %.1f ms, %lu overruns\n",
+                loop.name, (unsigned long)loop.ticks, loop.periodMs, LoopMeanPeriodMs(loop), loop.maxPeriodUs / 1000.0,
+                loop.maxJitterUs / 1000.0, loop.maxBodyUs / 1000.0, (unsigned long)loop.overruns);
+        LoopHistogramPrint(out, "late", loop.lateHistogram);
+        LoopHistogramPrint(out, "body", loop.bodyHistogram);
+    }
+}
+
+
+/**
+ * @brief Dumps every loop to the terminal, and appends to LOOP_STATS_LOG when an SD card is in.
+ */
+void LoopStatsDump() {
+    LoopStatsWrite(stdout);
+
+    if (pros::usd::is_installed()) {
+        FILE* log = fopen(LOOP_STATS_LOG, "a");
+        if (log) {
+            LoopStatsWrite(log);
+            fclose(log);
+        }
+    }
+}
+
+
+/** @brief Clears the statistics of every registered loop. */
+void LoopStatsReset() {
+    for (int i = 0; i < loopCount; i++)
+        loopRegistry[i]->Reset();
+}
@@ -0,0 +1,83 @@
+/**
+ * @file motion_profile.cpp
+ * @brief Trapezoidal motion profile for one axis.
+ */
+
+#include "main.h"
+#include "subsystems.hpp"
+#include <algorithm>
+#include <cmath>
+
+
+/**
+ * @brief Plans the segments from the start state to a stop at `end`.
+ */
+void TrapezoidProfile::Plan(double start, double startVelocity, double end, double maxVelocity, double maxAcceleration) {
+    segmentCount = 0;
+    startState = {start, std::clamp(startVelocity, -maxVelocity, maxVelocity), 0};
+    endPosition = end;
+    if (maxVelocity <= 0 || maxAcceleration <= 0) return;
+
+    double position = start;
+    double velocity = startState.velocity;
+    double distance = end - position;
+    double direction = distance >= 0 ? 1 : -1;
+    double stoppingDistance = velocity * velocity / (2 * maxAcceleration);
+
+    // Moving away from the end, or too fast to stop before it: stop first, then plan from rest
+    if (velocity * direction < 0 || (velocity != 0 && stoppingDistance > std::fabs(distance))) {
+        double stopAcceleration = velocity > 0 ? -maxAcceleration : maxAcceleration;
+        segments[segmentCount++] = {std::fabs(velocity) / maxAcceleration, stopAcceleration};
+        position += velocity > 0 ? stoppingDistance : -stoppingDistance;
+        velocity = 0;
+        distance = end - position;
+        direction = distance >= 0 ? 1 : -1;
+    }
+
+    // Speed along the direction of travel from here on
+    double speed = std::fabs(velocity);
+    double length = std::fabs(distance);
+    if (length == 0 && speed == 0) return;
+
+    // Peak speed: the cruise limit, or where speeding up meets slowing down
+    double peak = std::min(maxVelocity, std::sqrt(maxAcceleration * length + speed * speed / 2));
+    double speedUpDistance = (peak * peak - speed * speed) / (2 * maxAcceleration);
+    double slowDownDistance = peak * peak / (2 * maxAcceleration);
+    double cruiseDistance = std::max(0.0, length - speedUpDistance - slowDownDistance);
+
+    segments[segmentCount++] = {(peak - speed) / maxAcceleration, direction * maxAcceleration};
+    segments[segmentCount++] = {peak > 0 ? cruiseDistance / peak : 0, 0};
+    segments[segmentCount++] = {peak / maxAcceleration, -direction * maxAcceleration};
+}
+
+
+/**
+ * @brief Integrates the segments up to `t` seconds after the start.
+ */
+ProfileState TrapezoidProfile::Sample(double t) const {
+    ProfileState state = startState;
+    if (t <= 0) return state;
+
+    for (int i = 0; i < segmentCount; i++) {
+        double dt = std::min(t, segments[i].duration);
+        state.position += state.velocity * dt + segments[i].acceleration * dt * dt / 2;
+        state.velocity += segments[i].acceleration * dt;
+        state.acceleration = segments[i].acceleration;
+        t -= dt;
+        if (t <= 0 && dt < segments[i].duration) return state;
+    }
+
+    // Past the end the axis holds still
+    return {segmentCount > 0 ? endPosition : startState.position, 0, 0};
+}
+
+
+/**
+ * @brief Sums the segment durations.
+ */
+double TrapezoidProfile::Duration() const {
+    double duration = 0;
+    for (int i = 0; i < segmentCount; i++)
+        duration += segments[i].duration;
+    return duration;
+}
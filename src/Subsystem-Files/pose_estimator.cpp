@@ -0,0 +1,325 @@
+/**
+ * @file pose_estimator.cpp
+ * @brief Extended Kalman filter odometry fusing the trackers, drive encoders, and IMU.
+ *
+ * Each sensor's noise is a standard deviation that grows with how far it moved
+ * this update, plus a floor for the quantization of a still sensor. Readings that
+ * jump further than the robot can move in one update are sensor resets, like
+ * chassis.drive_sensor_reset() or chassis.drive_imu_reset(), and are skipped.
+ */
+
+#include "main.h"
+#include "subsystems.hpp"
+#include <cmath>
+
+const int ODOMETRY_PERIOD_MS = 10;  // same rate as EZ's tracking task
+
+// UNMEASURED: a skid-steer turns as if its wheels were further apart than they are, so use the
+// effective track width Measure Offsets prints rather than a tape measure
+const double DRIVE_TRACK_WIDTH = 12.0;  // inches, drive side difference per radian of turn
+const double MAX_STEP = 6.0;            // inches, further than the drive moves in one update
+const double IMU_MAX_STEP = 0.8;        // radians, further than the robot turns in one update
+
+// Noise models, standard deviation as a fraction of the distance moved plus a floor
+const double TRACKER_NOISE = 0.005;                // unpowered wheels barely slip
+const double TRACKER_NOISE_FLOOR = 0.002;          // inches
+const double DRIVE_ENCODER_NOISE = 0.1;            // powered wheels scrub and slip
+const double DRIVE_ENCODER_NOISE_PER_G = 0.1;      // encoder noise added per g the accelerometer reads, for a push or a hit
+const double DRIVE_ENCODER_NOISE_FLOOR = 0.005;    // inches
+const double DRIVE_HEADING_NOISE = 0.1;            // turning scrubs the drive wheels sideways
+const double DRIVE_HEADING_NOISE_FLOOR = 0.0005;   // radians
+const double SIDEWAYS_NOISE_FLOOR = 0.01;          // inches, a skid-steer drive barely slides sideways
+const double IMU_HEADING_NOISE = 0.001;            // radians
+const double SLIP_GATE = 3.0;                      // standard deviations the encoders may disagree with the tracker by
+
+PoseEstimator fusedOdom;
+
+// Timing of the estimator
+LoopStats odometryLoopStats{"Odometry", ODOMETRY_PERIOD_MS};
+
+
+/**
+ * @brief Average of one drive side's encoders in inches, skipping unplugged motors.
+ *
+ * @return INFINITY when no motor on the side reads
+ */
+double DriveSideInches(std::vector<pros::Motor>& motors) {
+    double total = 0;
+    int count = 0;
+    for (pros::Motor& motor : motors) {
+        double position = motor.get_position();
+        if (!std::isfinite(position)) continue;
+        total += position;
+        count++;
+    }
+    return count > 0 ? total / count / chassis.drive_tick_per_inch() : INFINITY;
+}
+
+
+/**
+ * @brief Variance of a sensor whose standard deviation is `fraction` of `distance` plus `floor`.
+ */
+double MotionVariance(double distance, double fraction, double floor) {
+    double deviation = fraction * std::fabs(distance) + floor;
+    return deviation * deviation;
+}
+
+
+/**
+ * @brief Travel of the robot's center along a tracker's axis, taking out the tracker's swing about the center.
+ *
+ * Same arc as EZ's tracking task: a tracker reads the center's motion plus its offset times the turn.
+ */
+double CenterTravel(double delta, double offset, double turn) {
+    if (std::fabs(turn) < 1e-9) return delta;
+    return 2.0 * std::sin(turn / 2.0) * (delta / turn - offset);
+}
+
+
+/** @brief True when a new reading is a real delta from the last one, not a reset or an unplugged sensor. */
+bool StepOk(double delta, double maxStep) { return std::isfinite(delta) && std::fabs(delta) < maxStep; }
+
+
+/**
+ * @brief Reads every sensor, predicts the pose from the travel, and corrects the heading by the IMU.
+ */
+void PoseEstimator::Update() {
+    std::uint64_t timeUs = pros::micros();
+    double vertical = vert_tracker.get();
+    double horizontal = horiz_tracker.get();
+    double left = DriveSideInches(chassis.left_motors);
+    double right = DriveSideInches(chassis.right_motors);
+    double imu = ez::util::to_rad(chassis.drive_imu_get());
+    double accel = std::fabs(chassis.drive_imu_accel_get());
+    if (!std::isfinite(accel)) accel = 0;
+
+    mutex.take();
+    double dVertical = vertical - lastVertical;
+    double dHorizontal = horizontal - lastHorizontal;
+    double dLeft = left - lastLeft;
+    double dRight = right - lastRight;
+    double dImu = imu - lastImu;
+    bool verticalOk = StepOk(dVertical, MAX_STEP);
+    bool horizontalOk = StepOk(dHorizontal, MAX_STEP);
+    bool encodersOk = StepOk(dLeft, MAX_STEP) && StepOk(dRight, MAX_STEP);
+    bool imuOk = StepOk(dImu, IMU_MAX_STEP);
+
+    // Follow each sensor even through a reset, so the next delta is real
+    if (std::isfinite(vertical)) lastVertical = vertical;
+    if (std::isfinite(horizontal)) lastHorizontal = horizontal;
+    if (std::isfinite(left) && std::isfinite(right)) {
+        lastLeft = left;
+        lastRight = right;
+    }
+
+    // A heading jump is someone setting the IMU, so the estimate follows it like chassis.drive_angle_set()
+    if (std::isfinite(imu)) {
+        lastImu = imu;
+        if (!imuOk) {
+            state[2] = imu;
+            for (int i = 0; i < 3; i++)
+                covariance[i][2] = covariance[2][i] = 0;
+        }
+    }
+
+    // Heading change: predicted from the drive sides, or taken from the IMU without them
+    double driveTurn = encodersOk ? (dLeft - dRight) / DRIVE_TRACK_WIDTH : 0;
+    double turn = imuOk ? dImu : driveTurn;
+    double turnInput = encodersOk ? driveTurn : turn;
+    double turnVariance = encodersOk ? MotionVariance(driveTurn, DRIVE_HEADING_NOISE, DRIVE_HEADING_NOISE_FLOOR)
+                                     : MotionVariance(turn, 0, IMU_HEADING_NOISE);
+
+    // Forward: the tracker and the encoders weighted by their variances, dropping encoders that slipped
+    double forward = 0, forwardVariance = MotionVariance(0, 0, DRIVE_ENCODER_NOISE_FLOOR);
+    double trackerForward = verticalOk ? CenterTravel(dVertical, vert_tracker.distance_to_center_get(), turn) : 0;
+    double trackerVariance = MotionVariance(trackerForward, TRACKER_NOISE, TRACKER_NOISE_FLOOR);
+    double driveForward = encodersOk ? (dLeft + dRight) / 2.0 : 0;
+    double driveVariance = MotionVariance(driveForward, DRIVE_ENCODER_NOISE + DRIVE_ENCODER_NOISE_PER_G * accel, DRIVE_ENCODER_NOISE_FLOOR);
+    if (verticalOk && encodersOk) {
+        double disagreement = driveForward - trackerForward;
+        if (disagreement * disagreement > SLIP_GATE * SLIP_GATE * (trackerVariance + driveVariance)) {
+            forward = trackerForward;
+            forwardVariance = trackerVariance;
+            slipCount++;
+        } else {
+            forwardVariance = 1.0 / (1.0 / trackerVariance + 1.0 / driveVariance);
+            forward = forwardVariance * (trackerForward / trackerVariance + driveForward / driveVariance);
+        }
+    } else if (verticalOk) {
+        forward = trackerForward;
+        forwardVariance = trackerVariance;
+    } else if (encodersOk) {
+        forward = driveForward;
+        forwardVariance = driveVariance;
+    }
+
+    // Sideways: the horizontal tracker, or no slide at all without it
+    double sideways = horizontalOk ? CenterTravel(dHorizontal, horiz_tracker.distance_to_center_get(), turn) : 0;
+    double sidewaysVariance = MotionVariance(sideways, TRACKER_NOISE, horizontalOk ? TRACKER_NOISE_FLOOR : SIDEWAYS_NOISE_FLOOR);
+
+    // Predict: move along the heading halfway through the turn, forward is (sin, cos) and right is (cos, -sin)
+    double mid = state[2] + turnInput / 2.0;
+    double s = std::sin(mid), c = std::cos(mid);
+    double dxdTheta = forward * c - sideways * s;
+    double dydTheta = -forward * s - sideways * c;
+    state[0] += forward * s + sideways * c;
+    state[1] += forward * c - sideways * s;
+    state[2] += turnInput;
+
+    // P = F P F' + G Q G', with F the jacobian by the state and G by the travel (forward, sideways, turn)
+    double F[3][3] = {{1, 0, dxdTheta}, {0, 1, dydTheta}, {0, 0, 1}};
+    double G[3][3] = {{s, c, dxdTheta / 2.0}, {c, -s, dydTheta / 2.0}, {0, 0, 1}};
+    double Q[3] = {forwardVariance, sidewaysVariance, turnVariance};
+    double FP[3][3] = {};
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            for (int k = 0; k < 3; k++)
+                FP[i][j] += F[i][k] * covariance[k][j];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            covariance[i][j] = 0;
+            for (int k = 0; k < 3; k++)
+                covariance[i][j] += FP[i][k] * F[j][k] + G[i][k] * Q[k] * G[j][k];
+        }
+    }
+
+    if (imuOk) CorrectHeading(imu, IMU_HEADING_NOISE * IMU_HEADING_NOISE);
+
+    // Velocity over this update, none across a reset
+    PoseSample sample;
+    sample.timeUs = timeUs;
+    sample.x = state[0];
+    sample.y = state[1];
+    sample.theta = ez::util::to_deg(state[2]);
+    if (poseReset) {
+        PoseHistoryClear();
+        poseReset = false;
+    } else if (timeUs > lastSample.timeUs) {
+        double dt = (timeUs - lastSample.timeUs) / 1e6;
+        sample.xVelocity = (sample.x - lastSample.x) / dt;
+        sample.yVelocity = (sample.y - lastSample.y) / dt;
+        sample.angularVelocity = (sample.theta - lastSample.theta) / dt;
+    }
+    lastSample = sample;
+    mutex.give();
+
+    PoseHistoryPush(sample);
+}
+
+
+/**
+ * @brief Kalman update for a measurement of the heading alone. Call with the mutex held.
+ *
+ * The gain moves x and y too, through how their error has grown with the heading's.
+ */
+void PoseEstimator::CorrectHeading(double imuHeading, double variance) {
+    double innovation = imuHeading - state[2];
+    double innovationVariance = covariance[2][2] + variance;
+    double gain[3];
+    for (int i = 0; i < 3; i++)
+        gain[i] = covariance[i][2] / innovationVariance;
+
+    double headingRow[3] = {covariance[2][0], covariance[2][1], covariance[2][2]};
+    for (int i = 0; i < 3; i++) {
+        state[i] += gain[i] * innovation;
+        for (int j = 0; j < 3; j++)
+            covariance[i][j] -= gain[i] * headingRow[j];
+    }
+}
+
+
+/**
+ * @brief Kalman update for a measurement of x and y together.
+ *
+ * The 2x2 innovation covariance is inverted directly. The heading moves too, by
+ * how its error has grown with the position's.
+ */
+void PoseEstimator::CorrectPosition(double x, double y, double variance) {
+    mutex.take();
+    double a = covariance[0][0] + variance, b = covariance[0][1];
+    double c = covariance[1][0], d = covariance[1][1] + variance;
+    double determinant = a * d - b * c;
+    if (std::fabs(determinant) < 1e-12) {
+        mutex.give();
+        return;
+    }
+    double inverse[2][2] = {{d / determinant, -b / determinant}, {-c / determinant, a / determinant}};
+
+    double gain[3][2];
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 2; j++)
+            gain[i][j] = covariance[i][0] * inverse[0][j] + covariance[i][1] * inverse[1][j];
+
+    double innovation[2] = {x - state[0], y - state[1]};
+    double positionRows[2][3];
+    for (int j = 0; j < 3; j++) {
+        positionRows[0][j] = covariance[0][j];
+        positionRows[1][j] = covariance[1][j];
+    }
+    for (int i = 0; i < 3; i++) {
+        state[i] += gain[i][0] * innovation[0] + gain[i][1] * innovation[1];
+        for (int j = 0; j < 3; j++)
+            covariance[i][j] -= gain[i][0] * positionRows[0][j] + gain[i][1] * positionRows[1][j];
+    }
+    mutex.give();
+}
+
+
+/** @brief Current estimate, heading in degrees. */
+ez::pose PoseEstimator::odom_pose_get() {
+    mutex.take();
+    ez::pose pose = {state[0], state[1], ez::util::to_deg(state[2])};
+    mutex.give();
+    return pose;
+}
+
+double PoseEstimator::odom_x_get() { return odom_pose_get().x; }
+double PoseEstimator::odom_y_get() { return odom_pose_get().y; }
+double PoseEstimator::odom_theta_get() { return odom_pose_get().theta; }
+
+
+/** @brief Remembers every sensor's current reading. Call with the mutex held. */
+void PoseEstimator::ReadLast() {
+    lastVertical = vert_tracker.get();
+    lastHorizontal = horiz_tracker.get();
+    lastLeft = DriveSideInches(chassis.left_motors);
+    lastRight = DriveSideInches(chassis.right_motors);
+    lastImu = ez::util::to_rad(chassis.drive_imu_get());
+}
+
+
+/**
+ * @brief Sets the estimate and the chassis pose, with no uncertainty left.
+ */
+void PoseEstimator::odom_xyt_set(double x, double y, double theta) {
+    chassis.odom_xyt_set(x, y, theta);
+
+    mutex.take();
+    state[0] = x;
+    state[1] = y;
+    state[2] = ez::util::to_rad(theta);
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            covariance[i][j] = 0;
+    ReadLast();
+    slipCount = 0;
+    poseReset = true;
+    mutex.give();
+}
+
+void PoseEstimator::odom_xyt_set(okapi::QLength x, okapi::QLength y, okapi::QAngle theta) {
+    odom_xyt_set(x.convert(okapi::inch), y.convert(okapi::inch), theta.convert(okapi::degree));
+}
+
+
+/** @brief Updates where the encoders disagreed with the tracker by more than slip allows. */
+int PoseEstimator::SlipCount() {
+    mutex.take();
+    int count = slipCount;
+    mutex.give();
+    return count;
+}
+
+
+/** @brief One estimator update, called by the scheduler. */
+void OdometryTick() { fusedOdom.Update(); }
@@ -0,0 +1,179 @@
+/**
+ * @file pose_history.cpp
+ * @brief Timestamped history of odometry poses, readable from any task without locking.
+ *
+ * The ring is a seqlock per slot. The writer makes a slot's sequence odd, writes
+ * the sample, then makes it even again. A reader copies the sample between two
+ * reads of the sequence and keeps the copy only if both were the same even
+ * number, and the slot still holds the sample it asked for.
+ */
+
+#include "main.h"
+#include "subsystems.hpp"
+#include <atomic>
+
+const int POSE_HISTORY_SIZE = 8192;               // samples, power of two so indexes wrap cleanly
+const int POSE_HISTORY_MARGIN = 8;                // oldest samples readers skip, the writer may be about to reuse them
+const int POSE_READ_ATTEMPTS = 4;                 // reads of a slot before giving up on a busy one
+const char* POSE_HISTORY_LOG = "/usd/pose_history.csv";
+
+/// One ring slot.
+struct PoseSlot {
+    std::atomic<std::uint32_t> sequence{0};  // odd while the writer is in the slot
+    std::uint32_t index = 0;                 // which sample the slot holds
+    PoseSample sample;
+};
+
+PoseSlot poseHistory[POSE_HISTORY_SIZE];
+std::atomic<std::uint32_t> poseHistoryCount{0};   // samples ever pushed
+std::atomic<std::uint32_t> poseHistoryFirst{0};   // oldest sample since the last clear
+
+
+/**
+ * @brief Writes the sample into the next slot and publishes it.
+ */
+void PoseHistoryPush(const PoseSample& sample) {
+    std::uint32_t index = poseHistoryCount.load(std::memory_order_relaxed);
+    PoseSlot& slot = poseHistory[index % POSE_HISTORY_SIZE];
+
+    std::uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.index = index;
+    slot.sample = sample;
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+
+    poseHistoryCount.store(index + 1, std::memory_order_release);
+}
+
+
+/**
+ * @brief Copies one sample out of the ring.
+ *
+ * @return false if the slot has been reused for a newer sample or stayed busy
+ */
+bool PoseHistoryRead(std::uint32_t index, PoseSample& sample) {
+    PoseSlot& slot = poseHistory[index % POSE_HISTORY_SIZE];
+    for (int attempt = 0; attempt < POSE_READ_ATTEMPTS; attempt++) {
+        std::uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before & 1) continue;
+        std::uint32_t held = slot.index;
+        sample = slot.sample;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == before) return held == index;
+    }
+    return false;
+}
+
+
+/**
+ * @brief Range of samples safe to read, [first, end).
+ */
+void PoseHistoryRange(std::uint32_t& first, std::uint32_t& end) {
+    end = poseHistoryCount.load(std::memory_order_acquire);
+    first = poseHistoryFirst.load(std::memory_order_acquire);
+    std::uint32_t held = POSE_HISTORY_SIZE - POSE_HISTORY_MARGIN;
+    if (end - first > held) first = end - held;
+}
+
+
+/** @brief Blends two samples, `t` of the way from `a` to `b`. */
+PoseSample PoseLerp(const PoseSample& a, const PoseSample& b, double t) {
+    PoseSample blend;
+    blend.timeUs = a.timeUs + (std::uint64_t)(t * (b.timeUs - a.timeUs));
+    blend.x = a.x + (b.x - a.x) * t;
+    blend.y = a.y + (b.y - a.y) * t;
+    blend.theta = a.theta + (b.theta - a.theta) * t;
+    blend.xVelocity = a.xVelocity + (b.xVelocity - a.xVelocity) * t;
+    blend.yVelocity = a.yVelocity + (b.yVelocity - a.yVelocity) * t;
+    blend.angularVelocity = a.angularVelocity + (b.angularVelocity - a.angularVelocity) * t;
+    return blend;
+}
+
+
+/**
+ * @brief Binary searches for the samples either side of `timeUs` and blends them.
+ */
+bool PoseAt(std::uint64_t timeUs, PoseSample& sample) {
+    std::uint32_t first, end;
+    PoseHistoryRange(first, end);
+    if (end == first) return false;
+
+    // Past the newest sample: carry it forward at its velocity for a short while
+    PoseSample newest;
+    if (!PoseHistoryRead(end - 1, newest)) return false;
+    if (timeUs >= newest.timeUs) {
+        double dt = (timeUs - newest.timeUs) / 1e6;
+        if (dt > 2 * ODOMETRY_PERIOD_MS / 1000.0) return false;
+        sample = newest;
+        sample.timeUs = timeUs;
+        sample.x += newest.xVelocity * dt;
+        sample.y += newest.yVelocity * dt;
+        sample.theta += newest.angularVelocity * dt;
+        return true;
+    }
+
+    PoseSample oldest;
+    if (!PoseHistoryRead(first, oldest) || timeUs < oldest.timeUs) return false;
+
+    // Narrow to the last sample at or before timeUs
+    std::uint32_t low = first, high = end - 1;
+    PoseSample before = oldest;
+    while (high - low > 1) {
+        std::uint32_t middle = low + (high - low) / 2;
+        PoseSample probe;
+        if (!PoseHistoryRead(middle, probe)) return false;
+        if (probe.timeUs <= timeUs) {
+            low = middle;
+            before = probe;
+        } else {
+            high = middle;
+        }
+    }
+
+    PoseSample after;
+    if (!PoseHistoryRead(high, after)) return false;
+    if (after.timeUs <= before.timeUs) {
+        sample = after;
+        return true;
+    }
+    sample = PoseLerp(before, after, (double)(timeUs - before.timeUs) / (after.timeUs - before.timeUs));
+    return true;
+}
+
+
+/** @brief Newest sample, all zeros if there is none. */
+PoseSample PoseHistoryLatest() {
+    std::uint32_t first, end;
+    PoseHistoryRange(first, end);
+    PoseSample sample;
+    if (end == first || !PoseHistoryRead(end - 1, sample)) return {};
+    return sample;
+}
+
+
+/** @brief Moves the start of the history up to the next sample. */
+void PoseHistoryClear() {
+    poseHistoryFirst.store(poseHistoryCount.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+
+/**
+ * @brief Writes the held samples to the SD card, replacing the last dump.
+ */
+void PoseHistoryDump() {
+    if (!pros::usd::is_installed()) return;
+    FILE* log = fopen(POSE_HISTORY_LOG, "w");
+    if (!log) return;
+
+    std::uint32_t first, end;
+    PoseHistoryRange(first, end);
+    fprintf(log, "time_us,x,y,theta,x_velocity,y_velocity,angular_velocity\n");
+    for (std::uint32_t i = first; i != end; i++) {
+        PoseSample sample;
+        if (!PoseHistoryRead(i, sample)) continue;
+        fprintf(log, "%llu,%.3f,%.3f,%.3f,%.2f,%.2f,%.2f\n", (unsigned long long)sample.timeUs, sample.x, sample.y, sample.theta,
+                sample.xVelocity, sample.yVelocity, sample.angularVelocity);
+    }
+    fclose(log);
+}
@@ -0,0 +1,326 @@
+/**
+ * @file routine.cpp
+ * @brief Coroutine auton routines: many logical threads of control on one task.
+ *
+ * Parked routines sit in a fixed table with the event each is waiting on.
+ * Spawned routines are roots: they own the frames of everything they co_await,
+ * so destroying a root frees a whole chain of nested routines at once.
+ */
+
+#include "main.h"
+#include "subsystems.hpp"
+
+const int MAX_PARKED_ROUTINES = 16;  // routines that can wait at once
+const int MAX_ROOT_ROUTINES = 8;     // spawned routines that can run at once
+
+/// A routine waiting on an event.
+struct ParkedRoutine {
+    std::coroutine_handle<> handle;
+    Event ready{[] { return true; }};
+};
+
+ParkedRoutine parkedRoutines[MAX_PARKED_ROUTINES];
+std::coroutine_handle<> rootRoutines[MAX_ROOT_ROUTINES];
+bool routineTableFull = false;   // a routine couldn't be parked or spawned, so RunRoutine() stops
+bool routinesResuming = false;   // RunRoutine() is inside a routine, not waiting between steps
+
+
+/**
+ * @brief Parks a routine until an event happens.
+ *
+ * If the table is full the run fails hard: RunRoutine() stops at its next step
+ * and frees every routine, this one included, rather than leaving autonomous
+ * waiting on a routine nothing will resume. MAX_PARKED_ROUTINES bounds how many
+ * behaviors can wait at once.
+ */
+void ParkRoutine(std::coroutine_handle<> routine, Event event) {
+    for (int i = 0; i < MAX_PARKED_ROUTINES; i++) {
+        if (!parkedRoutines[i].handle) {
+            parkedRoutines[i] = {routine, std::move(event)};
+            return;
+        }
+    }
+    printf("Routine table full, stopping the routine\n");
+    routineTableFull = true;
+}
+
+
+/**
+ * @brief Resumes the routine that co_awaited this one, or frees a finished spawned routine.
+ */
+std::coroutine_handle<> Routine::promise_type::FinalAwaiter::await_suspend(std::coroutine_handle<promise_type> routine) noexcept {
+    promise_type& promise = routine.promise();
+    if (promise.continuation) return promise.continuation;
+
+    *promise.done = true;
+    for (int i = 0; i < MAX_ROOT_ROUTINES; i++) {
+        if (rootRoutines[i] == routine) rootRoutines[i] = nullptr;
+    }
+    routine.destroy();
+    return std::noop_coroutine();
+}
+
+
+/**
+ * @brief Parks on every event of a WhenAny(), resuming with the index of the first to happen.
+ */
+EventAwaiter<int> Routine::promise_type::await_transform(AnyOf any) {
+    auto winner = std::make_shared<int>(-1);
+    auto events = std::make_shared<std::vector<Event>>(std::move(any.events));
+    Event first([winner, events] {
+        for (int i = 0; i < (int)events->size(); i++) {
+            if ((*events)[i]()) {
+                *winner = i;
+                return true;
+            }
+        }
+        return false;
+    });
+    return {std::move(first), [winner] { return *winner; }};
+}
+
+
+/**
+ * @brief Takes ownership of a routine and runs it until it first waits.
+ *
+ * If every root slot is taken the routine is dropped and the run fails hard,
+ * like a full park table.
+ */
+Event Spawn(Routine routine) {
+    auto done = std::make_shared<bool>(false);
+
+    int slot = -1;
+    for (int i = 0; i < MAX_ROOT_ROUTINES && slot < 0; i++) {
+        if (!rootRoutines[i]) slot = i;
+    }
+    if (slot < 0) {
+        printf("Routine table full, a spawned routine was dropped, stopping the routine\n");
+        routineTableFull = true;
+        *done = true;
+        return Event([done] { return *done; });
+    }
+
+    std::coroutine_handle<Routine::promise_type> handle = routine.handle;
+    routine.handle = nullptr;
+    handle.promise().done = done;
+    rootRoutines[slot] = handle;
+    handle.resume();
+
+    return Event([done] { return *done; });
+}
+
+
+/**
+ * @brief Resumes each parked routine whose event has happened.
+ *
+ * A resumed routine can park again in any free slot, including one later in the
+ * table, which is then checked this same step.
+ */
+void RoutinesStep() {
+    for (int i = 0; i < MAX_PARKED_ROUTINES; i++) {
+        if (!parkedRoutines[i].handle || !parkedRoutines[i].ready()) continue;
+
+        std::coroutine_handle<> handle = parkedRoutines[i].handle;
+        parkedRoutines[i] = {};
+        handle.resume();
+    }
+}
+
+
+/**
+ * @brief Frees every spawned routine and forgets every parked one.
+ *
+ * Freeing the roots frees everything they co_awaited, parked or not. If the
+ * task running them was stopped while a routine was running rather than
+ * parked, that frame can't be destroyed safely, so the routines are only
+ * forgotten and their frames leak.
+ */
+void ClearRoutines() {
+    routineTableFull = false;
+    for (int i = 0; i < MAX_PARKED_ROUTINES; i++)
+        parkedRoutines[i] = {};
+
+    if (routinesResuming) printf("Routines stopped mid-step, their frames are not freed\n");
+    for (int i = 0; i < MAX_ROOT_ROUTINES; i++) {
+        if (rootRoutines[i] && !routinesResuming) rootRoutines[i].destroy();
+        rootRoutines[i] = nullptr;
+    }
+    routinesResuming = false;
+}
+
+
+/**
+ * @brief Runs a routine and its spawned routines on the calling task, stepping every DELAY_TIME.
+ *
+ * Anything left over from a run that was cut short, e.g. when autonomous ended
+ * mid-routine, is freed before starting, if disabled() or opcontrol() hasn't
+ * already. A run that overflows the routine
+ * tables stops and stops the drive.
+ */
+void RunRoutine(Routine routine) {
+    ClearRoutines();
+
+    routinesResuming = true;
+    Event finished = Spawn(std::move(routine));
+    routinesResuming = false;
+    std::uint32_t now = pros::millis();
+    while (!finished() && !routineTableFull) {
+        pros::Task::delay_until(&now, ez::util::DELAY_TIME);
+        routinesResuming = true;
+        RoutinesStep();
+        routinesResuming = false;
+    }
+    if (routineTableFull) chassis.drive_set(0, 0);
+
+    ClearRoutines();
+}
+
+
+/** @brief Happens once `condition` returns true. */
+Event Until(std::function<bool()> condition) { return Event(std::move(condition)); }
+
+
+/** @brief Happens `ms` after it is created. */
+Event Sleep(int ms) {
+    std::uint32_t end = pros::millis() + ms;
+    return Event([end] { return pros::millis() >= end; });
+}
+
+
+/** @brief Happens once every event has, checking each only until it happens. */
+Event WhenAll(std::vector<Event> events) {
+    auto pending = std::make_shared<std::vector<Event>>(std::move(events));
+    return Event([pending] {
+        for (int i = (int)pending->size() - 1; i >= 0; i--) {
+            if ((*pending)[i]()) pending->erase(pending->begin() + i);
+        }
+        return pending->empty();
+    });
+}
+
+
+/** @brief Waits on the first of several events. */
+AnyOf WhenAny(std::vector<Event> events) { return {std::move(events)}; }
+
+
+/**
+ * @brief Marks the drive as interfered if an exit means something got in the way, like pid_wait() does.
+ */
+void NoteInterference(ez::exit_output exit) {
+    if (exit == ez::mA_EXIT || exit == ez::VELOCITY_EXIT) chassis.interfered = true;
+}
+
+
+/**
+ * @brief Happens once the current motion's exit conditions all exit.
+ *
+ * Runs the same exit_condition() checks as chassis.pid_wait(), one pass per
+ * step, so the exit timers count the same DELAY_TIME per call. The first check
+ * is skipped: it comes from co_await's await_ready(), in the step the motion
+ * started, and would tick the exit timers once more than pid_wait() does.
+ */
+Event DriveSettled() {
+    chassis.interfered = false;
+    auto first = std::make_shared<ez::exit_output>(ez::RUNNING);
+    auto second = std::make_shared<ez::exit_output>(ez::RUNNING);
+    auto awaited = std::make_shared<bool>(false);
+
+    return Event([first, second, awaited] {
+        if (!*awaited) {
+            *awaited = true;
+            return false;
+        }
+
+        switch (chassis.drive_mode_get()) {
+            case ez::DRIVE:
+                if (*first == ez::RUNNING) *first = chassis.leftPID.exit_condition(chassis.left_motors[0]);
+                if (*second == ez::RUNNING) *second = chassis.rightPID.exit_condition(chassis.right_motors[0]);
+                break;
+            case ez::TURN:
+            case ez::TURN_TO_POINT:
+                *first = chassis.turnPID.exit_condition({chassis.left_motors[0], chassis.right_motors[0]});
+                *second = *first;
+                break;
+            case ez::SWING:
+                *first = chassis.swingPID.exit_condition(chassis.current_swing == ez::LEFT_SWING ? chassis.left_motors[0] : chassis.right_motors[0]);
+                *second = *first;
+                break;
+            case ez::POINT_TO_POINT:
+            case ez::PURE_PURSUIT:
+                if (*first == ez::RUNNING) *first = chassis.xyPID.exit_condition({chassis.left_motors[0], chassis.right_motors[0]});
+                if (*second == ez::RUNNING) *second = chassis.current_a_odomPID.exit_condition({chassis.left_motors[0], chassis.right_motors[0]});
+                break;
+            default:
+                return true;
+        }
+
+        if (*first == ez::RUNNING || *second == ez::RUNNING) return false;
+        NoteInterference(*first);
+        NoteInterference(*second);
+        return true;
+    });
+}
+
+
+/** @brief Waits for the motion to settle. */
+DriveMotion::operator Event() const { return DriveSettled(); }
+
+
+/**
+ * @brief Happens once both sides are past `distance` from the start, like chassis.pid_wait_until().
+ *
+ * Also happens if both sides' exit conditions exit first, so a blocked robot doesn't wait forever.
+ */
+Event DriveMotion::Until(okapi::QLength distance) const {
+    double target = distance.convert(okapi::inch);
+    double leftTarget = startLeft + target;
+    double rightTarget = startRight + target;
+    int leftSign = ez::util::sgn(leftTarget - chassis.drive_sensor_left());
+    int rightSign = ez::util::sgn(rightTarget - chassis.drive_sensor_right());
+    auto leftExit = std::make_shared<ez::exit_output>(ez::RUNNING);
+    auto rightExit = std::make_shared<ez::exit_output>(ez::RUNNING);
+
+    return Event([=] {
+        if (ez::util::sgn(leftTarget - chassis.drive_sensor_left()) != leftSign &&
+            ez::util::sgn(rightTarget - chassis.drive_sensor_right()) != rightSign)
+            return true;
+
+        if (*leftExit == ez::RUNNING) *leftExit = chassis.leftPID.exit_condition(chassis.left_motors[0]);
+        if (*rightExit == ez::RUNNING) *rightExit = chassis.rightPID.exit_condition(chassis.right_motors[0]);
+        return *leftExit != ez::RUNNING && *rightExit != ez::RUNNING;
+    });
+}
+
+
+/**
+ * @brief Happens once the heading is past `angle`, or the turn's exit conditions exit first.
+ */
+Event DriveMotion::Until(okapi::QAngle angle) const {
+    double target = angle.convert(okapi::degree);
+    int sign = ez::util::sgn(target - chassis.drive_imu_get());
+    auto exit = std::make_shared<ez::exit_output>(ez::RUNNING);
+
+    return Event([=] {
+        if (ez::util::sgn(target - chassis.drive_imu_get()) != sign) return true;
+
+        ez::PID& pid = chassis.drive_mode_get() == ez::SWING ? chassis.swingPID : chassis.turnPID;
+        if (*exit == ez::RUNNING) *exit = pid.exit_condition({chassis.left_motors[0], chassis.right_motors[0]});
+        return *exit != ez::RUNNING;
+    });
+}
+
+
+/** @brief Starts a drive motion, remembering where it started for Until(). */
+DriveMotion DriveDistance(okapi::QLength distance, int speed, bool slew) {
+    DriveMotion motion(chassis.drive_sensor_left(), chassis.drive_sensor_right());
+    chassis.pid_drive_set(distance, speed, slew);
+    return motion;
+}
+
+
+/** @brief Starts a turn motion. */
+DriveMotion TurnTo(okapi::QAngle angle, int speed) {
+    DriveMotion motion(chassis.drive_sensor_left(), chassis.drive_sensor_right());
+    chassis.pid_turn_set(angle, speed);
+    return motion;
+}
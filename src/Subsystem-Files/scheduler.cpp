@@ -0,0 +1,102 @@
+/**
+ * @file scheduler.cpp
+ * @brief Fixed-rate scheduler for the subsystem control loops.
+ *
+ * Slots are counted from an epoch aligned to SCHEDULER_SLOT_MS, so a tick with
+ * period P and phase F runs in every slot where (slot time - F) is a multiple
+ * of P.
+ */
+
+#include "main.h"
+#include "subsystems.hpp"
+
+const int MAX_TICKS = 12;  // ticks the schedule has room for
+
+/// One registered tick function.
+struct ScheduledTick {
+    const char* name;
+    int periodMs;
+    int phaseMs;
+    void (*tick)();
+    LoopStats* stats;
+};
+
+ScheduledTick tickSchedule[MAX_TICKS];
+int tickCount = 0;
+std::uint32_t scheduleEpoch = 0;
+
+
+/**
+ * @brief Adds a tick function to the schedule.
+ *
+ * Periods and phases that aren't multiples of SCHEDULER_SLOT_MS are rounded to the nearest slot.
+ */
+void SchedulerAdd(const char* name, int periodMs, int phaseMs, void (*tick)(), LoopStats* stats) {
+    if (tickCount >= MAX_TICKS) {
+        printf("Schedule full, %s tick not added\n", name);
+        return;
+    }
+
+    int slots = std::max(1, (periodMs + SCHEDULER_SLOT_MS / 2) / SCHEDULER_SLOT_MS);
+    int phaseSlots = ((phaseMs + SCHEDULER_SLOT_MS / 2) / SCHEDULER_SLOT_MS) % slots;
+    tickSchedule[tickCount++] = {name, slots * SCHEDULER_SLOT_MS, phaseSlots * SCHEDULER_SLOT_MS, tick, stats};
+}
+
+
+/**
+ * @brief Runs a tick once, timed into its loop statistics.
+ */
+void RunTick(const ScheduledTick& entry) {
+    entry.stats->TickStart();
+    entry.tick();
+    entry.stats->TickEnd();
+}
+
+
+/**
+ * @brief Moves a delay_until wake time past any slots that were already missed.
+ *
+ * delay_until returns immediately for a wake time in the past, which would run
+ * every missed tick back to back after a long body. Skipping keeps the phase.
+ *
+ * @param wake Wake time from the last delay_until, advanced in place
+ * @param periodMs Period between wakes
+ */
+void SkipMissed(std::uint32_t& wake, int periodMs) {
+    std::uint32_t now = pros::millis();
+    while (wake + periodMs < now)
+        wake += periodMs;
+}
+
+
+/**
+ * @brief Scheduler task: wakes every slot and runs the ticks due in it.
+ */
+void SchedulerTask(void*) {
+    std::uint32_t wake = scheduleEpoch;
+    pros::Task::delay_until(&wake, 0);
+
+    while (true) {
+        int slotTime = wake - scheduleEpoch;
+        for (int i = 0; i < tickCount; i++) {
+            const ScheduledTick& entry = tickSchedule[i];
+            if ((slotTime - entry.phaseMs) % entry.periodMs == 0)
+                RunTick(entry);
+        }
+
+        SkipMissed(wake, SCHEDULER_SLOT_MS);
+        pros::Task::delay_until(&wake, SCHEDULER_SLOT_MS);
+    }
+}
+
+
+/**
+ * @brief Aligns the slot epoch and starts the scheduler task.
+ */
+void SchedulerStart() {
+    // Start on the next slot boundary
+    std::uint32_t now = pros::millis();
+    scheduleEpoch = now - now % SCHEDULER_SLOT_MS + SCHEDULER_SLOT_MS;
+
+    pros::Task(SchedulerTask, nullptr, "Scheduler");
+}
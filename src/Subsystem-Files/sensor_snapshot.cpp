@@ -0,0 +1,80 @@
+/**
+ * @file sensor_snapshot.cpp
+ * @brief One read of every mechanism sensor per scheduler slot.
+ *
+ * Snapshots are double buffered: SensorsTick() fills the buffer readers aren't
+ * pointed at, then publishes it with a single atomic store. That alone isn't
+ * enough, since a reader preempted for two writer periods could be copying the
+ * buffer as it's rewritten. So each buffer is also a seqlock, like the pose
+ * history: the writer makes its sequence odd while filling it, and a reader
+ * keeps a copy only if the sequence was the same even number before and after.
+ * A failed copy is retried on whichever buffer is latest by then.
+ */
+
+#include "main.h"
+#include "subsystems.hpp"
+#include <atomic>
+
+const int SENSORS_PERIOD_MS = SCHEDULER_SLOT_MS;  // refreshed every slot, ahead of the lift
+
+/// One of the two snapshot buffers.
+struct SnapshotBuffer {
+    std::atomic<std::uint32_t> sequence{0};  // odd while SensorsTick() is filling it
+    SensorSnapshot snapshot;
+};
+
+SnapshotBuffer snapshots[2];
+std::atomic<int> latestSnapshot{0};
+std::uint32_t snapshotCount = 0;
+
+// Timing of the snapshot stage
+LoopStats sensorsLoopStats{"Sensors", SENSORS_PERIOD_MS};
+
+
+/**
+ * @brief Reads each sensor once into the unpublished buffer, then publishes it.
+ */
+void SensorsTick() {
+    int next = 1 - latestSnapshot.load(std::memory_order_relaxed);
+    SnapshotBuffer& buffer = snapshots[next];
+    SensorSnapshot& snapshot = buffer.snapshot;
+
+    std::uint32_t sequence = buffer.sequence.load(std::memory_order_relaxed);
+    buffer.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    snapshot.tick = snapshotCount++;
+    snapshot.timeUs = pros::micros();
+
+    snapshot.intakeHue = intakeOptical.get_hue();
+    snapshot.intakeVelocity = mainIntake.get_actual_velocity();
+    snapshot.intakeTargetVelocity = mainIntake.get_target_velocity();
+    snapshot.intakePosition = mainIntake.get_position();
+    snapshot.intakeCurrent = mainIntake.get_current_draw();
+
+    snapshot.clampProximity = clampOptical.get_proximity();
+    snapshot.clampHue = clampOptical.get_hue();
+
+    snapshot.liftPosition = liftRotation.get_position();
+
+    buffer.sequence.store(sequence + 2, std::memory_order_release);
+    latestSnapshot.store(next, std::memory_order_release);
+}
+
+
+/**
+ * @brief Returns a copy of the most recently published snapshot.
+ *
+ * Retries only when the writer refilled the buffer mid-copy, which takes a
+ * reader preempted for a whole slot, so the loop ends on the next try.
+ */
+SensorSnapshot GetSensorSnapshot() {
+    while (true) {
+        SnapshotBuffer& buffer = snapshots[latestSnapshot.load(std::memory_order_acquire)];
+        std::uint32_t before = buffer.sequence.load(std::memory_order_acquire);
+        if (before & 1) continue;
+        SensorSnapshot snapshot = buffer.snapshot;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (buffer.sequence.load(std::memory_order_relaxed) == before) return snapshot;
+    }
+}
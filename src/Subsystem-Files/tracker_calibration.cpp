@@ -0,0 +1,376 @@
+/**
+ * @file tracker_calibration.cpp
+ * @brief Calibrates the tracking wheels and IMU from one short maneuver with a least-squares fit.
+ *
+ * The fit works in raw units so nothing set before the run biases it: the
+ * trackers read inches at their current diameter, the IMU degrees before its
+ * scaler. A tracker reads the center's travel along its axis plus its offset
+ * times the turn, all over the wheel scale, so each moving sample gives one
+ * linear equation per tracker in the drive encoders' forward travel and the turn.
+ * The heading comes from the IMU and the scaler, which comes from the whole turns
+ * the wall squares the robot to, and the vertical tracker's wheel scale from the
+ * back distance sensor's change over each straight leg. The horizontal tracker
+ * only rolls as the robot turns on a drive that can't slide sideways, so its
+ * scale and offset can't be told apart; it keeps its diameter and the fit gives
+ * the offset at that diameter, which is what odometry uses.
+ */
+
+#include "main.h"
+#include "subsystems.hpp"
+#include <cmath>
+
+// The maneuver
+const okapi::QLength CALIBRATION_LEG = 36_in;  // straight out and back, long enough that the distance sensor's error is small next to it
+const okapi::QLength CALIBRATION_STANDOFF = 10_in;  // legs start and end this far out, flush against the wall the back sensor is under its range
+const okapi::QLength SQUARE_GAP = 2_in;        // stop this short of the wall before pushing into it
+const int CALIBRATION_TURNS = 2;               // full turns each spin, the IMU scaler is measured over this many
+const int CALIBRATION_DRIVE_SPEED = 80;
+const int CALIBRATION_TURN_SPEED = 90;
+const int SQUARE_POWER = 40;                   // out of 127, enough to swing the back flat against the wall
+const int SQUARE_MS = 700;
+const int STILL_MS = 300;                      // settle time, and long enough to average the distance sensor
+
+// The fit
+const int CALIBRATION_MAX_SAMPLES = 4000;      // 40 s at the step rate, the maneuver takes about 15
+const double CALIBRATION_MIN_LEG = 12.0;       // inches, shorter legs don't say much about the wheel scale
+const double MAX_SCALE_CHANGE = 0.1;           // a wheel more than 10% off the set size is a bad leg, not a worn wheel
+const double SLIP_RESIDUAL = 0.01;             // inches RMS per sample, a clean tracker fits to a few thousandths
+const int CALIBRATION_MIN_CONFIDENCE = 32;     // of 63
+const int CALIBRATION_MIN_MM = 200;            // closer than this the back sensor reports no confidence, so a bad reading can't be told from a good one
+
+CalibrationSample calibrationSamples[CALIBRATION_MAX_SAMPLES];
+int calibrationCount = 0;
+CalibrationPhase calibrationPhase = CalibrationPhase::STILL;
+bool calibrationLogging = false;
+TrackerCalibration lastCalibration;
+
+
+/// Running sums for fitting value = a * first + b * second by least squares.
+struct LeastSquares2 {
+    double ff = 0, fs = 0, ss = 0;
+    double fv = 0, sv = 0;
+
+    void Add(double first, double second, double value) {
+        ff += first * first;
+        fs += first * second;
+        ss += second * second;
+        fv += first * value;
+        sv += second * value;
+    }
+
+    /** @return false if the two inputs never varied independently */
+    bool Solve(double& a, double& b) const {
+        double determinant = ff * ss - fs * fs;
+        if (std::fabs(determinant) < 1e-9 * (ff * ss + 1e-12)) return false;
+        a = (fv * ss - sv * fs) / determinant;
+        b = (ff * sv - fs * fv) / determinant;
+        return true;
+    }
+};
+
+
+/** @brief True while a sample is logged with the robot moving under a motion. */
+bool Moving(CalibrationPhase phase) { return phase == CalibrationPhase::DRIVE || phase == CalibrationPhase::TURN; }
+
+
+/**
+ * @brief Mean of the samples with a back distance reading over the run of samples in the same phase as `index`.
+ *
+ * Averaging the trackers over the same samples as the distance sensor keeps a
+ * robot still creeping after a motion from skewing one against the other.
+ *
+ * @return Mean vertical tracker, IMU and back distance, the distance NAN if no sample in the run had a reading
+ */
+CalibrationSample RunMean(const CalibrationSample* samples, int count, int index) {
+    int first = index, last = index;
+    while (first > 0 && samples[first - 1].phase == samples[index].phase) first--;
+    while (last < count - 1 && samples[last + 1].phase == samples[index].phase) last++;
+
+    CalibrationSample mean;
+    int readings = 0;
+    for (int i = first; i <= last; i++) {
+        if (!std::isfinite(samples[i].backDistance)) continue;
+        mean.vertical += samples[i].vertical;
+        mean.imu += samples[i].imu;
+        mean.backDistance += samples[i].backDistance;
+        readings++;
+    }
+    if (readings == 0) {
+        mean.backDistance = NAN;
+        return mean;
+    }
+    mean.vertical /= readings;
+    mean.imu /= readings;
+    mean.backDistance /= readings;
+    return mean;
+}
+
+
+/**
+ * @brief A raw IMU turn in radians, scaled for the direction it went when that direction was fit.
+ */
+double ScaledTurn(const TrackerCalibration& fit, double rawDegrees) {
+    double scaler = rawDegrees >= 0 ? fit.imuScalerClockwise : fit.imuScalerCounterClockwise;
+    return ez::util::to_rad(rawDegrees * (scaler > 0 ? scaler : fit.imuScaler));
+}
+
+
+/**
+ * @brief Fits the log in three linear steps, each using the one before.
+ *
+ * 1. IMU scaler: at the end of each push into the wall the robot is square, so
+ *    its true heading is the nearest multiple of 90 degrees to what the IMU
+ *    says. Each turn between two squared-up ends gives the ratio of true to raw
+ *    turn for the direction it spun. A gyro can read differently each way, and
+ *    EZ takes one scaler, so it gets the mean of the two directions.
+ * 2. Per tracker, over every moving sample: reading = a * forward + b * turn,
+ *    forward from the drive encoders and turn from the IMU at its direction's
+ *    scaler. b is the offset over the wheel scale, and a the tracker's gearing
+ *    against the drive wheels, which isn't used, only there so straight travel
+ *    doesn't bend b.
+ *    The drive sides' difference over the spins, against the same turn, is the
+ *    effective track width.
+ * 3. Vertical wheel scale: over each straight leg between two still stops
+ *    with the back sensor in range, the back distance sensor's change against
+ *    the vertical tracker's, less the part of it that was the heading holding.
+ */
+TrackerCalibration FitTrackerCalibration(const CalibrationSample* samples, int count, double imuScaler) {
+    TrackerCalibration fit;
+    fit.imuScaler = imuScaler;
+    if (count < 2) return fit;
+
+    // IMU scaler per spin direction from the turn between squared-up headings, then their mean
+    double trueRaw[2] = {0, 0}, rawRaw[2] = {0, 0};
+    double lastRaw = 0, lastSquare = 0;
+    for (int i = 1; i < count; i++) {
+        bool squareEnds = samples[i].phase == CalibrationPhase::SQUARE &&
+                          (i == count - 1 || samples[i + 1].phase != CalibrationPhase::SQUARE);
+        if (!squareEnds) continue;
+        double raw = samples[i].imu - samples[0].imu;
+        double square = 90.0 * std::round(raw * imuScaler / 90.0);
+        double turn = square - lastSquare, rawTurn = raw - lastRaw;
+        lastRaw = raw;
+        lastSquare = square;
+        if (std::fabs(turn) < 360) continue;
+        int direction = turn > 0 ? 0 : 1;
+        trueRaw[direction] += turn * rawTurn;
+        rawRaw[direction] += rawTurn * rawTurn;
+    }
+    if (rawRaw[0] > 0) fit.imuScalerClockwise = trueRaw[0] / rawRaw[0];
+    if (rawRaw[1] > 0) fit.imuScalerCounterClockwise = trueRaw[1] / rawRaw[1];
+    fit.headingMeasured = rawRaw[0] > 0 || rawRaw[1] > 0;
+    if (rawRaw[0] > 0 && rawRaw[1] > 0) fit.imuScaler = (fit.imuScalerClockwise + fit.imuScalerCounterClockwise) / 2.0;
+    else if (rawRaw[0] > 0) fit.imuScaler = fit.imuScalerClockwise;
+    else if (rawRaw[1] > 0) fit.imuScaler = fit.imuScalerCounterClockwise;
+
+    // Tracker readings against the encoders' travel and the turn, and the drive sides' difference against the turn
+    LeastSquares2 vertical, horizontal;
+    double differenceTurn = 0, turnTurn = 0;
+    for (int i = 1; i < count; i++) {
+        if (!Moving(samples[i].phase)) continue;
+        const CalibrationSample& last = samples[i - 1];
+        double forward = (samples[i].left - last.left + samples[i].right - last.right) / 2.0;
+        double turn = ScaledTurn(fit, samples[i].imu - last.imu);
+        vertical.Add(forward, turn, samples[i].vertical - last.vertical);
+        horizontal.Add(forward, turn, samples[i].horizontal - last.horizontal);
+        fit.samples++;
+        if (samples[i].phase != CalibrationPhase::TURN) continue;
+        differenceTurn += (samples[i].left - last.left - samples[i].right + last.right) * turn;
+        turnTurn += turn * turn;
+    }
+    if (turnTurn > 0) fit.trackWidth = differenceTurn / turnTurn;
+    double verticalGearing = 0, verticalPerRadian = 0, horizontalGearing = 0, horizontalPerRadian = 0;
+    if (!vertical.Solve(verticalGearing, verticalPerRadian) || !horizontal.Solve(horizontalGearing, horizontalPerRadian)) {
+        fit.samples = 0;
+        return fit;
+    }
+
+    // How far each tracker strays from the fit
+    double verticalSquares = 0, horizontalSquares = 0;
+    for (int i = 1; i < count; i++) {
+        if (!Moving(samples[i].phase)) continue;
+        const CalibrationSample& last = samples[i - 1];
+        double forward = (samples[i].left - last.left + samples[i].right - last.right) / 2.0;
+        double turn = ScaledTurn(fit, samples[i].imu - last.imu);
+        double verticalMiss = samples[i].vertical - last.vertical - verticalGearing * forward - verticalPerRadian * turn;
+        double horizontalMiss = samples[i].horizontal - last.horizontal - horizontalGearing * forward - horizontalPerRadian * turn;
+        verticalSquares += verticalMiss * verticalMiss;
+        horizontalSquares += horizontalMiss * horizontalMiss;
+    }
+    fit.verticalResidual = std::sqrt(verticalSquares / fit.samples);
+    fit.horizontalResidual = std::sqrt(horizontalSquares / fit.samples);
+
+    // Vertical wheel scale from the straight legs that start and end still
+    double measuredRead = 0, readRead = 0;
+    for (int start = 1; start < count; start++) {
+        if (samples[start].phase != CalibrationPhase::DRIVE || samples[start - 1].phase != CalibrationPhase::STILL) continue;
+        int end = start;
+        while (end < count && samples[end].phase == CalibrationPhase::DRIVE) end++;
+        if (end == count || samples[end].phase != CalibrationPhase::STILL) continue;
+
+        CalibrationSample before = RunMean(samples, count, start - 1);
+        CalibrationSample after = RunMean(samples, count, end);
+        double read = after.vertical - before.vertical - verticalPerRadian * ScaledTurn(fit, after.imu - before.imu);
+        double measured = after.backDistance - before.backDistance;
+        if (!std::isfinite(measured) || std::fabs(read) < CALIBRATION_MIN_LEG) continue;
+        measuredRead += measured * read;
+        readRead += read * read;
+    }
+    if (readRead > 0 && std::fabs(measuredRead / readRead - 1.0) <= MAX_SCALE_CHANGE) {
+        fit.verticalScale = measuredRead / readRead;
+        fit.scaleMeasured = true;
+    }
+
+    // The per-radian readings are at the old diameter: the vertical offset is true inches, the horizontal stays at its diameter
+    fit.verticalOffset = verticalPerRadian * fit.verticalScale;
+    fit.horizontalOffset = horizontalPerRadian;
+    return fit;
+}
+
+
+/**
+ * @brief Reads every sensor the fit uses.
+ */
+CalibrationSample ReadCalibrationSample() {
+    CalibrationSample sample;
+    sample.phase = calibrationPhase;
+    sample.vertical = vert_tracker.get();
+    sample.horizontal = horiz_tracker.get();
+    sample.left = DriveSideInches(chassis.left_motors);
+    sample.right = DriveSideInches(chassis.right_motors);
+    sample.imu = chassis.imu.get_rotation();
+
+    std::int32_t millimeters = backDistance.get();
+    bool inRange = millimeters >= CALIBRATION_MIN_MM && millimeters < 9999;
+    sample.backDistance = inRange && backDistance.get_confidence() >= CALIBRATION_MIN_CONFIDENCE ? millimeters / 25.4 : NAN;
+    return sample;
+}
+
+
+/**
+ * @brief Logs a sample every step until the maneuver ends.
+ */
+Routine CalibrationLog() {
+    while (calibrationLogging) {
+        if (calibrationCount < CALIBRATION_MAX_SAMPLES) calibrationSamples[calibrationCount++] = ReadCalibrationSample();
+        co_await Sleep(ez::util::DELAY_TIME);
+    }
+}
+
+
+/**
+ * @brief Drives one straight leg and waits still at its end, so the fit can use it.
+ */
+Routine CalibrationLeg(okapi::QLength distance) {
+    calibrationPhase = CalibrationPhase::DRIVE;
+    co_await DriveDistance(distance, CALIBRATION_DRIVE_SPEED);
+    calibrationPhase = CalibrationPhase::STILL;
+    co_await Sleep(STILL_MS);
+}
+
+
+/**
+ * @brief Backs from the standoff into the wall until the robot sits square against it.
+ */
+Routine SquareToWall() {
+    calibrationPhase = CalibrationPhase::DRIVE;
+    co_await DriveDistance(SQUARE_GAP - CALIBRATION_STANDOFF, CALIBRATION_DRIVE_SPEED);
+    calibrationPhase = CalibrationPhase::SQUARE;
+    chassis.drive_set(-SQUARE_POWER, -SQUARE_POWER);
+    co_await Sleep(SQUARE_MS);
+    chassis.drive_set(0, 0);
+    calibrationPhase = CalibrationPhase::STILL;
+    co_await Sleep(STILL_MS);
+}
+
+
+/**
+ * @brief Prints a calibration to the terminal and the brain screen.
+ */
+void PrintTrackerCalibration(const TrackerCalibration& fit) {
+    printf("Tracker calibration from %d samples\n", fit.samples);
+    printf("  vertical offset   %7.3f in, residual %.4f in%s\n", fit.verticalOffset, fit.verticalResidual,
+           fit.verticalResidual > SLIP_RESIDUAL ? "  SLIPPING" : "");
+    printf("  horizontal offset %7.3f in, residual %.4f in%s\n", fit.horizontalOffset, fit.horizontalResidual,
+           fit.horizontalResidual > SLIP_RESIDUAL ? "  SLIPPING" : "");
+    printf("  vertical scale    %7.4f%s\n", fit.verticalScale, fit.scaleMeasured ? "" : "  (not measured, kept)");
+    printf("  horizontal scale   can't be measured on this drive, kept\n");
+    printf("  IMU scaler        %7.4f%s\n", fit.imuScaler, fit.headingMeasured ? "" : "  (not measured, kept)");
+    if (fit.headingMeasured)
+        printf("    clockwise %.4f, counterclockwise %.4f\n", fit.imuScalerClockwise, fit.imuScalerCounterClockwise);
+    printf("  track width       %7.3f in, copy into DRIVE_TRACK_WIDTH (set %.3f)\n", fit.trackWidth, DRIVE_TRACK_WIDTH);
+
+    ez::screen_print("vert " + ez::util::to_string_with_precision(fit.verticalOffset, 3) + " rms " +
+                         ez::util::to_string_with_precision(fit.verticalResidual, 4) + (fit.verticalResidual > SLIP_RESIDUAL ? " SLIP" : ""), 1);
+    ez::screen_print("horiz " + ez::util::to_string_with_precision(fit.horizontalOffset, 3) + " rms " +
+                         ez::util::to_string_with_precision(fit.horizontalResidual, 4) + (fit.horizontalResidual > SLIP_RESIDUAL ? " SLIP" : ""), 2);
+    ez::screen_print("vert x" + ez::util::to_string_with_precision(fit.verticalScale, 4) + "  imu x" +
+                         ez::util::to_string_with_precision(fit.imuScaler, 4), 3);
+    ez::screen_print("track " + ez::util::to_string_with_precision(fit.trackWidth, 3) + " in", 4);
+}
+
+
+/**
+ * @brief Drives the maneuver with the logger running alongside, then fits and applies it.
+ *
+ * Each pass backs off the wall to the standoff, drives a leg out, spins
+ * CALIBRATION_TURNS turns in place, drives the leg back to the standoff, and
+ * squares up against the wall. The first pass spins clockwise and the second back, so
+ * the fit sees the IMU's scale each way.
+ */
+Routine CalibrateTrackers() {
+    chassis.pid_targets_reset();
+    chassis.drive_imu_reset();
+    chassis.drive_sensor_reset();
+    chassis.drive_brake_set(MOTOR_BRAKE_HOLD);
+    vert_tracker.reset();
+    horiz_tracker.reset();
+    fusedOdom.odom_xyt_set(0_in, 0_in, 0_deg);
+    double scalerBefore = chassis.drive_imu_scaler_get();
+
+    calibrationCount = 0;
+    calibrationPhase = CalibrationPhase::STILL;
+    calibrationLogging = true;
+    Event logger = Spawn(CalibrationLog());
+    co_await Sleep(STILL_MS);
+
+    for (int pass = 0; pass < 2; pass++) {
+        co_await CalibrationLeg(CALIBRATION_STANDOFF);
+        co_await CalibrationLeg(CALIBRATION_LEG);
+
+        // Raw, since the default shortest path would see a whole number of turns as no turn at all
+        calibrationPhase = CalibrationPhase::TURN;
+        chassis.pid_turn_set(pass == 0 ? 360.0 * CALIBRATION_TURNS : 0.0, CALIBRATION_TURN_SPEED, ez::raw);
+        co_await DriveSettled();
+        calibrationPhase = CalibrationPhase::STILL;
+        co_await Sleep(STILL_MS);
+
+        co_await CalibrationLeg(0_in - CALIBRATION_LEG);
+        co_await SquareToWall();
+    }
+
+    calibrationLogging = false;
+    co_await logger;
+
+    TrackerCalibration fit = FitTrackerCalibration(calibrationSamples, calibrationCount, scalerBefore);
+    if (fit.samples == 0) {
+        printf("Tracker calibration failed, the robot didn't move\n");
+        co_return;
+    }
+
+    vert_tracker.distance_to_center_set(fit.verticalOffset);
+    horiz_tracker.distance_to_center_set(fit.horizontalOffset);
+    if (fit.scaleMeasured) vert_tracker.wheel_diameter_set(vert_tracker.wheel_diameter_get() * fit.verticalScale);
+    chassis.drive_imu_scaler_set(fit.imuScaler);
+
+    // The trackers read differently now, so start odometry over from them
+    chassis.drive_imu_reset();
+    fusedOdom.odom_xyt_set(0_in, 0_in, 0_deg);
+
+    lastCalibration = fit;
+    PrintTrackerCalibration(fit);
+}
+
+
+/** @brief The last calibration's fit. */
+TrackerCalibration LastTrackerCalibration() { return lastCalibration; }
@@ -0,0 +1,380 @@
+/**
+ * @file trajectory.cpp
+ * @brief Squiggles trajectories generated in initialize() and followed by feedforward plus PD per side.
+ *
+ * Squiggles is given feet. Its splines assume moves a few units long with the
+ * robot going 1 unit/s at each waypoint, which in meters turns a 2 ft move into
+ * a straight line with a corner; in feet field moves come out as smooth arcs.
+ * Headings go in as radians counterclockwise from +x. Everything it hands back
+ * is converted to inches and EZ's degrees clockwise from +y before it's stored.
+ *
+ * The conversion takes squiggles' curvature as positive counterclockwise and
+ * wheel_velocities as {left, right}, which its headers don't say. Every profile
+ * is checked against its own poses before it's stored, so a library that reads
+ * the other way drops the trajectory at boot instead of driving it mirrored.
+ *
+ * Both controllers end in the same per-side voltage: feedforward for a wheel
+ * speed and acceleration and D on the side's speed error. WHEEL_FEEDBACK adds P on
+ * each side's encoder travel; RAMSETE picks the wheel speeds from the pose error.
+ */
+
+#include "main.h"
+#include "subsystems.hpp"
+#include "okapi/squiggles/squiggles.hpp"
+#include <cmath>
+
+const int TRAJECTORY_PERIOD_MS = 10;
+
+// Drive limits, 459 RPM on 3.25 in wheels
+const double MAX_WHEEL_SPEED = 459.0 * M_PI * 3.25 / 60.0;   // in/s, about 78
+const double TRAJECTORY_SPEED_FRACTION = 0.85;                // of MAX_WHEEL_SPEED, leaves the feedback room to catch up
+const double TRAJECTORY_MAX_ACCEL = 150.0;                    // in/s^2, what the drive reaches without wheelies or slip
+const double TRAJECTORY_MAX_JERK = 1500.0;                    // in/s^3
+const double FEET_PER_INCH = 1.0 / 12.0;                      // squiggles' units, see the file comment
+const double TRAJECTORY_DT = 0.01;                            // s between points, one follower tick
+const double PROFILE_CHECK_TOLERANCE = 0.05;                  // fraction a profile's own totals may disagree by
+const double PROFILE_CHECK_MIN_TURN = 0.2;                    // radians, less turning than this can't show a sign
+const double PROFILE_CHECK_END_TOLERANCE = 0.5;               // inches from the first and last waypoint
+
+// Follower gains, in drive_set() units of 127
+const double TRAJECTORY_KV = 127.0 / MAX_WHEEL_SPEED;   // per in/s of planned wheel speed
+const double TRAJECTORY_KA = TRAJECTORY_KV * 0.12;      // per in/s^2, the drive reaches 63% of a step in about 120 ms
+const double TRAJECTORY_KP = 4.0;                       // per inch a side is behind the plan
+const double TRAJECTORY_KD = 0.5;                       // per in/s a side is slower than the plan
+const int TRAJECTORY_SETTLE_MS = 200;                   // feedback holds the end this long before the drive stops
+
+// RAMSETE gains, b is 5 /m^2 in inches, a little past the usual 2 so short moves still converge
+const double RAMSETE_B = 5.0 * 0.0254 * 0.0254;   // 1/in^2, how hard to steer out sideways error
+const double RAMSETE_ZETA = 0.7;                  // damping, 0 to 1
+
+std::vector<TrajectoryPoint> trajectories[(int)TrajectoryId::COUNT];
+
+pros::Mutex trajectoryMutex;
+const std::vector<TrajectoryPoint>* activeTrajectory = nullptr;
+TrajectoryController trajectoryController = TrajectoryController::WHEEL_FEEDBACK;
+std::uint32_t trajectoryStartMs = 0;
+double trajectoryStartLeft = 0;     // side encoders when the trajectory started, inches
+double trajectoryStartRight = 0;
+double trajectoryLastLeft = 0;      // side travel at the last tick, for the speed
+double trajectoryLastRight = 0;
+
+// Timing of the trajectory follower
+LoopStats trajectoryLoopStats{"Trajectory", TRAJECTORY_PERIOD_MS};
+
+
+/**
+ * @brief Converts squiggles' profile to inches and EZ's heading, and fills in what the follower needs per side.
+ */
+std::vector<TrajectoryPoint> TrajectoryFromProfile(const std::vector<squiggles::ProfilePoint>& profile) {
+    std::vector<TrajectoryPoint> output;
+    output.reserve(profile.size());
+
+    for (const squiggles::ProfilePoint& profilePoint : profile) {
+        TrajectoryPoint point;
+        point.time = profilePoint.time;
+        point.x = profilePoint.vector.pose.x / FEET_PER_INCH;
+        point.y = profilePoint.vector.pose.y / FEET_PER_INCH;
+        point.velocity = profilePoint.vector.vel / FEET_PER_INCH;
+        point.acceleration = profilePoint.vector.accel / FEET_PER_INCH;
+        point.curvature = -profilePoint.curvature * FEET_PER_INCH;
+        point.leftVelocity = profilePoint.wheel_velocities[0] / FEET_PER_INCH;
+        point.rightVelocity = profilePoint.wheel_velocities[1] / FEET_PER_INCH;
+
+        // Headings keep counting past 180 so interpolation never spins the long way
+        double theta = 90.0 - ez::util::to_deg(profilePoint.vector.pose.yaw);
+        if (!output.empty()) {
+            const TrajectoryPoint& last = output.back();
+            theta = last.theta + std::remainder(theta - last.theta, 360.0);
+
+            double dt = point.time - last.time;
+            point.leftDistance = last.leftDistance + (last.leftVelocity + point.leftVelocity) / 2.0 * dt;
+            point.rightDistance = last.rightDistance + (last.rightVelocity + point.rightVelocity) / 2.0 * dt;
+            if (dt > 0) {
+                point.leftAcceleration = (point.leftVelocity - last.leftVelocity) / dt;
+                point.rightAcceleration = (point.rightVelocity - last.rightVelocity) / dt;
+            }
+        }
+        point.theta = theta;
+        output.push_back(point);
+    }
+    return output;
+}
+
+
+/**
+ * @brief Checks the conventions the conversion assumes against the profile's own poses.
+ *
+ * Integrated over the profile, the heading change must equal the curvature
+ * times the distance and the right wheel's lead over the left divided by the
+ * track width, all counterclockwise positive, and the distance the poses cover
+ * must equal the speed times the time. The ends must sit on the waypoints
+ * given, so the units came back as they went in.
+ *
+ * @return false with the reason printed if any of them disagree
+ */
+bool ProfileConventionsOk(const std::vector<squiggles::ProfilePoint>& profile, const std::vector<squiggles::Pose>& waypoints, double trackWidth) {
+    double poseTurn = 0, curvatureTurn = 0, wheelTurn = 0, poseDistance = 0, speedDistance = 0;
+    for (std::size_t i = 1; i < profile.size(); i++) {
+        const squiggles::ProfilePoint& last = profile[i - 1];
+        const squiggles::ProfilePoint& point = profile[i];
+        double dt = point.time - last.time;
+        double step = point.vector.pose.dist(last.vector.pose);
+        poseTurn += std::remainder(point.vector.pose.yaw - last.vector.pose.yaw, 2.0 * M_PI);
+        curvatureTurn += (last.curvature + point.curvature) / 2.0 * step;
+        wheelTurn += ((last.wheel_velocities[1] - last.wheel_velocities[0]) + (point.wheel_velocities[1] - point.wheel_velocities[0])) / 2.0 / trackWidth * dt;
+        poseDistance += step;
+        speedDistance += (last.vector.vel + point.vector.vel) / 2.0 * dt;
+    }
+
+    auto agrees = [](double value, double expected, double floor) {
+        return std::fabs(value - expected) <= PROFILE_CHECK_TOLERANCE * std::fabs(expected) + floor;
+    };
+    auto endOff = [](const squiggles::Pose& pose, const squiggles::Pose& waypoint) { return pose.dist(waypoint) / FEET_PER_INCH; };
+
+    if (endOff(profile.front().vector.pose, waypoints.front()) > PROFILE_CHECK_END_TOLERANCE ||
+        endOff(profile.back().vector.pose, waypoints.back()) > PROFILE_CHECK_END_TOLERANCE) {
+        printf("Trajectory profile doesn't end on its waypoints, squiggles changed units\n");
+        return false;
+    }
+    if (!agrees(speedDistance, poseDistance, 0.01)) {
+        printf("Trajectory profile speed covers %.2f but its poses %.2f, squiggles changed units\n", speedDistance, poseDistance);
+        return false;
+    }
+    if (std::fabs(poseTurn) < PROFILE_CHECK_MIN_TURN) return true;
+    if (!agrees(curvatureTurn, poseTurn, 0.02)) {
+        printf("Trajectory curvature turns %.2f rad but the poses %.2f, squiggles' curvature sign is the other way\n", curvatureTurn, poseTurn);
+        return false;
+    }
+    if (!agrees(wheelTurn, poseTurn, 0.02)) {
+        printf("Trajectory wheels turn %.2f rad but the poses %.2f, squiggles' wheel_velocities aren't {left, right}\n", wheelTurn, poseTurn);
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * @brief Generates every auton trajectory, leaving any squiggles can't fit or that fails the convention check empty.
+ *
+ * Each spline between waypoints is the smoothest squiggles finds, not its first
+ * that fits, so the curve is gentle enough for the profile to stay fast.
+ */
+void TrajectoryBuild() {
+    double maxSpeed = MAX_WHEEL_SPEED * TRAJECTORY_SPEED_FRACTION * FEET_PER_INCH;
+    squiggles::Constraints constraints(maxSpeed, TRAJECTORY_MAX_ACCEL * FEET_PER_INCH, TRAJECTORY_MAX_JERK * FEET_PER_INCH);
+    squiggles::SplineGenerator generator(
+        constraints, std::make_shared<squiggles::TankModel>(DRIVE_TRACK_WIDTH * FEET_PER_INCH, constraints), TRAJECTORY_DT);
+
+    for (std::vector<TrajectoryPoint>& trajectory : trajectories) trajectory.clear();
+    for (int i = 0; i < AUTON_TRAJECTORY_COUNT; i++) {
+        const TrajectorySpec& spec = AUTON_TRAJECTORIES[i];
+        std::vector<squiggles::Pose> waypoints;
+        for (const ez::united_pose& waypoint : spec.waypoints) {
+            ez::pose pose = ez::util::united_pose_to_pose(waypoint);
+            waypoints.emplace_back(pose.x * FEET_PER_INCH, pose.y * FEET_PER_INCH, ez::util::to_rad(90.0 - pose.theta));
+        }
+
+        std::vector<squiggles::ProfilePoint> profile = generator.generate(waypoints, false);
+        if (profile.empty()) {
+            printf("Trajectory %d couldn't be generated\n", (int)spec.id);
+            continue;
+        }
+        if (!ProfileConventionsOk(profile, waypoints, DRIVE_TRACK_WIDTH * FEET_PER_INCH)) {
+            printf("Trajectory %d dropped\n", (int)spec.id);
+            continue;
+        }
+        trajectories[(int)spec.id] = TrajectoryFromProfile(profile);
+    }
+}
+
+
+const std::vector<TrajectoryPoint>& TrajectoryGet(TrajectoryId id) {
+    return trajectories[(int)id];
+}
+
+
+/**
+ * @brief Linear interpolation between the two points around `time`.
+ */
+TrajectoryPoint TrajectorySample(const std::vector<TrajectoryPoint>& trajectory, double time) {
+    if (trajectory.empty()) return {};
+    if (time <= trajectory.front().time) return trajectory.front();
+    if (time >= trajectory.back().time) return trajectory.back();
+
+    // Points are TRAJECTORY_DT apart, so the index is close to time / dt
+    std::size_t i = std::min(trajectory.size() - 2, (std::size_t)((time - trajectory.front().time) / TRAJECTORY_DT));
+    while (i > 0 && trajectory[i].time > time) i--;
+    while (i + 2 < trajectory.size() && trajectory[i + 1].time < time) i++;
+
+    const TrajectoryPoint& from = trajectory[i];
+    const TrajectoryPoint& to = trajectory[i + 1];
+    double span = to.time - from.time;
+    double t = span > 0 ? (time - from.time) / span : 1.0;
+    auto lerp = [t](double a, double b) { return a + (b - a) * t; };
+
+    TrajectoryPoint point;
+    point.time = time;
+    point.x = lerp(from.x, to.x);
+    point.y = lerp(from.y, to.y);
+    point.theta = lerp(from.theta, to.theta);
+    point.velocity = lerp(from.velocity, to.velocity);
+    point.acceleration = lerp(from.acceleration, to.acceleration);
+    point.curvature = lerp(from.curvature, to.curvature);
+    point.leftVelocity = lerp(from.leftVelocity, to.leftVelocity);
+    point.rightVelocity = lerp(from.rightVelocity, to.rightVelocity);
+    point.leftAcceleration = to.leftAcceleration;
+    point.rightAcceleration = to.rightAcceleration;
+    point.leftDistance = lerp(from.leftDistance, to.leftDistance);
+    point.rightDistance = lerp(from.rightDistance, to.rightDistance);
+    return point;
+}
+
+
+/**
+ * @brief Starts following a trajectory, taking the drive from EZ.
+ */
+void TrajectoryStart(TrajectoryId id, TrajectoryController controller) {
+    const std::vector<TrajectoryPoint>& trajectory = trajectories[(int)id];
+    if (trajectory.empty()) {
+        printf("Trajectory %d wasn't built, skipping it\n", (int)id);
+        return;
+    }
+
+    trajectoryMutex.take();
+    chassis.drive_set(0, 0);
+    trajectoryStartLeft = DriveSideInches(chassis.left_motors);
+    trajectoryStartRight = DriveSideInches(chassis.right_motors);
+    trajectoryLastLeft = 0;
+    trajectoryLastRight = 0;
+    trajectoryStartMs = pros::millis();
+    activeTrajectory = &trajectory;
+    trajectoryController = controller;
+    trajectoryMutex.give();
+}
+
+
+bool TrajectoryRunning() {
+    trajectoryMutex.take();
+    bool running = activeTrajectory != nullptr;
+    trajectoryMutex.give();
+    return running;
+}
+
+
+double TrajectoryElapsed() {
+    trajectoryMutex.take();
+    double elapsed = activeTrajectory ? (pros::millis() - trajectoryStartMs) / 1000.0 : 0.0;
+    trajectoryMutex.give();
+    return elapsed;
+}
+
+
+void TrajectoryStop() {
+    trajectoryMutex.take();
+    activeTrajectory = nullptr;
+    chassis.drive_set(0, 0);
+    trajectoryMutex.give();
+}
+
+
+void TrajectoryWait() {
+    while (TrajectoryRunning()) pros::delay(TRAJECTORY_PERIOD_MS);
+}
+
+
+Event TrajectoryDone() {
+    return Until([] { return !TrajectoryRunning(); });
+}
+
+
+Event TrajectoryAt(double seconds) {
+    return Until([seconds] { return !TrajectoryRunning() || TrajectoryElapsed() >= seconds; });
+}
+
+
+/**
+ * @brief RAMSETE: wheel speeds that steer the robot back onto the planned pose.
+ *
+ * Works in the usual frame, radians counterclockwise from +x, with the error
+ * turned into the robot's frame. The correction grows with the planned speed
+ * and turn rate, so it does nothing once the plan has stopped.
+ */
+void RamseteWheelSpeeds(const TrajectoryPoint& target, ez::pose robot, double& left, double& right) {
+    double heading = ez::util::to_rad(90.0 - robot.theta);
+    double targetHeading = ez::util::to_rad(90.0 - target.theta);
+    double dx = target.x - robot.x;
+    double dy = target.y - robot.y;
+    double errorX = std::cos(heading) * dx + std::sin(heading) * dy;
+    double errorY = -std::sin(heading) * dx + std::cos(heading) * dy;
+    double errorHeading = std::remainder(targetHeading - heading, 2.0 * M_PI);
+
+    double v = target.velocity;
+    double omega = -target.velocity * target.curvature;   // curvature is positive clockwise
+    double k = 2.0 * RAMSETE_ZETA * std::sqrt(omega * omega + RAMSETE_B * v * v);
+    double sinc = std::fabs(errorHeading) > 1e-6 ? std::sin(errorHeading) / errorHeading : 1.0;
+
+    double speed = v * std::cos(errorHeading) + k * errorX;
+    double turn = omega + k * errorHeading + RAMSETE_B * v * sinc * errorY;
+    left = speed - turn * DRIVE_TRACK_WIDTH / 2.0;
+    right = speed + turn * DRIVE_TRACK_WIDTH / 2.0;
+}
+
+
+/**
+ * @brief One tick of the follower: feedforward for the wheel speeds, feedback from the chosen controller.
+ *
+ * Past the end the planned speed is zero and the feedback holds the end, then
+ * the drive stops. EZ's heading target is moved to where
+ * the robot ended up so the next EZ motion doesn't turn back to the old one.
+ */
+void TrajectoryTick() {
+    trajectoryMutex.take();
+    if (!activeTrajectory) {
+        trajectoryMutex.give();
+        return;
+    }
+
+    double left = DriveSideInches(chassis.left_motors) - trajectoryStartLeft;
+    double right = DriveSideInches(chassis.right_motors) - trajectoryStartRight;
+    if (!std::isfinite(left) || !std::isfinite(right)) {
+        printf("Trajectory stopped, the drive encoders aren't reading\n");
+        activeTrajectory = nullptr;
+        chassis.drive_set(0, 0);
+        trajectoryMutex.give();
+        return;
+    }
+
+    double elapsed = (pros::millis() - trajectoryStartMs) / 1000.0;
+    double duration = activeTrajectory->back().time;
+    TrajectoryPoint target = TrajectorySample(*activeTrajectory, elapsed);
+    double period = TRAJECTORY_PERIOD_MS / 1000.0;
+    double leftSpeed = (left - trajectoryLastLeft) / period;
+    double rightSpeed = (right - trajectoryLastRight) / period;
+    trajectoryLastLeft = left;
+    trajectoryLastRight = right;
+
+    if (elapsed >= duration + TRAJECTORY_SETTLE_MS / 1000.0) {
+        activeTrajectory = nullptr;
+        chassis.drive_set(0, 0);
+        chassis.headingPID.target_set(chassis.drive_imu_get());
+        trajectoryMutex.give();
+        return;
+    }
+    if (elapsed >= duration) target.leftAcceleration = target.rightAcceleration = 0;
+
+    double leftVelocity = target.leftVelocity, rightVelocity = target.rightVelocity;
+    double leftLag = 0, rightLag = 0;
+    if (trajectoryController == TrajectoryController::RAMSETE) {
+        RamseteWheelSpeeds(target, fusedOdom.odom_pose_get(), leftVelocity, rightVelocity);
+    } else {
+        leftLag = target.leftDistance - left;
+        rightLag = target.rightDistance - right;
+    }
+
+    double leftPower = TRAJECTORY_KV * leftVelocity + TRAJECTORY_KA * target.leftAcceleration +
+                       TRAJECTORY_KP * leftLag + TRAJECTORY_KD * (leftVelocity - leftSpeed);
+    double rightPower = TRAJECTORY_KV * rightVelocity + TRAJECTORY_KA * target.rightAcceleration +
+                        TRAJECTORY_KP * rightLag + TRAJECTORY_KD * (rightVelocity - rightSpeed);
+    chassis.drive_set(std::clamp((int)std::round(leftPower), -127, 127), std::clamp((int)std::round(rightPower), -127, 127));
+    trajectoryMutex.give();
+}
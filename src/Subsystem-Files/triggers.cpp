@@ -0,0 +1,126 @@
+/**
+ * @file triggers.cpp
+ * @brief Registered "when this, do that" triggers checked every scheduler slot.
+ *
+ * Triggers sit in a fixed table guarded by one mutex. They are added and removed
+ * from auton tasks and checked from the scheduler task.
+ */
+
+#include "main.h"
+#include "subsystems.hpp"
+
+const int TRIGGERS_PERIOD_MS = SCHEDULER_SLOT_MS;  // checked every slot, right after the snapshot
+const int MAX_TRIGGERS = 16;                       // triggers that can be registered at once
+
+/// One registered trigger.
+struct Trigger {
+    const char* name = nullptr;
+    std::function<bool()> condition;
+    std::function<void()> response;
+    TriggerMode mode = TriggerMode::ONCE;
+    bool held = false;  // condition was true last tick, so REPEAT triggers fire on the edge
+    int id = -1;        // -1 marks a free slot
+};
+
+Trigger triggers[MAX_TRIGGERS];
+int nextTriggerId = 0;
+pros::Mutex triggersMutex;
+
+// Timing of the trigger checks
+LoopStats triggersLoopStats{"Triggers", TRIGGERS_PERIOD_MS};
+
+
+/**
+ * @brief Adds a trigger to the first free slot.
+ */
+int TriggerAdd(const char* name, std::function<bool()> condition, std::function<void()> response, TriggerMode mode) {
+    triggersMutex.take();
+    int id = -1;
+    for (int i = 0; i < MAX_TRIGGERS; i++) {
+        if (triggers[i].id >= 0) continue;
+        id = nextTriggerId++;
+        triggers[i] = {name, std::move(condition), std::move(response), mode, false, id};
+        break;
+    }
+    triggersMutex.give();
+
+    if (id < 0) printf("Trigger table full, dropped %s\n", name);
+    return id;
+}
+
+
+/**
+ * @brief Frees the slot holding a trigger.
+ */
+void TriggerRemove(int id) {
+    if (id < 0) return;
+
+    triggersMutex.take();
+    for (int i = 0; i < MAX_TRIGGERS; i++) {
+        if (triggers[i].id == id) triggers[i] = {};
+    }
+    triggersMutex.give();
+}
+
+
+/**
+ * @brief Frees every slot.
+ */
+void TriggersClear() {
+    triggersMutex.take();
+    for (int i = 0; i < MAX_TRIGGERS; i++)
+        triggers[i] = {};
+    triggersMutex.give();
+}
+
+
+/**
+ * @brief Checks each trigger once. ONCE triggers are removed as they fire, REPEAT triggers fire on each rising edge.
+ */
+void TriggersTick() {
+    triggersMutex.take();
+    for (int i = 0; i < MAX_TRIGGERS; i++) {
+        Trigger& trigger = triggers[i];
+        if (trigger.id < 0) continue;
+
+        bool holds = trigger.condition();
+        if (holds && !trigger.held) {
+            trigger.response();
+            if (trigger.mode == TriggerMode::ONCE) {
+                trigger = {};
+                continue;
+            }
+        }
+        trigger.held = holds;
+    }
+    triggersMutex.give();
+}
+
+
+/**
+ * @brief Builds a condition that turns true once odometry crosses the line through `target`
+ * square to the direction from the robot's current pose to it.
+ */
+std::function<bool()> OdomPassed(ez::united_pose target) {
+    ez::pose goal = ez::util::united_pose_to_pose(target);
+    ez::pose start = chassis.odom_pose_get();
+    double dx = goal.x - start.x;
+    double dy = goal.y - start.y;
+
+    return [goal, dx, dy] {
+        ez::pose current = chassis.odom_pose_get();
+        return (current.x - goal.x) * dx + (current.y - goal.y) * dy >= 0;
+    };
+}
+
+
+/** @brief Builds a condition on the clamp optical's proximity in the latest snapshot. */
+std::function<bool()> ClampProximityAbove(int proximity) {
+    return [proximity] { return GetSensorSnapshot().clampProximity > proximity; };
+}
+
+
+/** @brief Builds a condition on the intake's current draw in the latest snapshot. */
+std::function<bool()> IntakeCurrentAbove(int milliamps) {
+    return [milliamps] { return GetSensorSnapshot().intakeCurrent > milliamps; };
+}
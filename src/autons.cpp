@@ -70,147 +70,132 @@ void default_constants() {
 
 
 /**
- * @brief Full autonomous routine used during Skills Challenge.
+ * @brief Full autonomous routine used during Skills Challenge, as a coroutine.
  *
  * @details
  * Executes intake, clamp, and wall scoring logic using odometry and sensor feedback.
- * Includes use of IntakeWait for alliance color sorting.
+ * Waits on ring and lift events instead of fixed delays, see routine.hpp.
  */
-void skills(){
+Routine SkillsRoutine(){
   // used for color sort!
   SetAllianceMode(AllianceMode::RED);
   IntakeDown();
 
   // face goal
-  chassis.pid_turn_set(27_deg, TURN_SPEED);
-  chassis.pid_wait();
+  co_await TurnTo(27_deg, TURN_SPEED);
 
-  // drive towards goal and pick it up
-  chassis.pid_drive_set(-38_in, DRIVE_SPEED, true);
-  chassis.pid_wait_until(-14_in);
+  // drive towards goal and pick it up, the clamp fires on contact. Creeps the last
+  // stretch and closes by distance until the clamp lead constants are measured
+  ActionHandle grab = ClampOnGoal(3000);
+  DriveMotion approach = DriveDistance(-38_in, DRIVE_SPEED, true);
+  co_await approach.Until(-14_in);
   chassis.pid_speed_max_set(30);
-  chassis.pid_wait_until(-29_in);
+  co_await WhenAny(grab, approach.Until(-29_in));
+  grab.Cancel();
   CloseClamp();
-  chassis.pid_wait();
-  chassis.pid_drive_set(2_in, DRIVE_SPEED, true);
-  chassis.pid_wait();
+  co_await approach;
+  co_await DriveDistance(2_in, DRIVE_SPEED, true);
   
   // collect first ring
   RunIntake(IntakeSpeed::FAST);
-  chassis.pid_turn_set(90_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(24_in, DRIVE_SPEED, true);
-  chassis.pid_wait();
+  co_await TurnTo(90_deg, TURN_SPEED);
+  co_await DriveDistance(24_in, DRIVE_SPEED, true);
 
   // Turn to angle towards 2nd ring
-  chassis.pid_turn_set(225_deg, TURN_SPEED);
-  chassis.pid_wait();
+  co_await TurnTo(225_deg, TURN_SPEED);
   
   // Intake second and third rings
-  chassis.pid_drive_set(33.5_in, DRIVE_SPEED, true);
-  chassis.pid_wait_until(16_in);
+  DriveMotion rings = DriveDistance(33.5_in, DRIVE_SPEED, true);
+  co_await rings.Until(16_in);
   chassis.pid_speed_max_set(35);
-  chassis.pid_wait();
-  chassis.pid_turn_set(268_deg, TURN_SPEED);
-  chassis.pid_wait();
+  co_await rings;
+  co_await TurnTo(268_deg, TURN_SPEED);
 
   // Score wallstake
   scoreMode = true;
-  AsyncLadyBrown(PRIMED_POSITION);
-  chassis.pid_drive_set(11_in, 35, true);
-  chassis.pid_wait();
-  pros::delay(600);
-  chassis.pid_drive_set(5_in, 35, true);
-  chassis.pid_wait();
-  pros::delay(1500);
+  ActionHandle primed = LiftTo(PRIMED_POSITION);
+  co_await DriveDistance(11_in, 35, true);
+  co_await primed;
+  co_await DriveDistance(5_in, 35, true);
+  co_await WaitForIntakeStall(1500);  // hooks stall once the ring sits in the lady brown
   RunIntake(IntakeSpeed::STOP);
   AsyncLadyBrown(WALLSTAKE_POSITION);
   scoreMode = false;
-  pros::delay(400);
+  co_await Sleep(400);
 
   //Drive back and intake next ring
-  chassis.pid_drive_set(-10_in, DRIVE_SPEED, true);
-  chassis.pid_wait();
+  co_await DriveDistance(-10_in, DRIVE_SPEED, true);
   //AsyncLadyBrown(BASE_POSITION);
-  chassis.pid_turn_set(0_deg, TURN_SPEED);
-  chassis.pid_wait();
+  co_await TurnTo(0_deg, TURN_SPEED);
   RunIntake(IntakeSpeed::FAST);
-  chassis.pid_drive_set(50_in, DRIVE_SPEED, true);
-  chassis.pid_wait_until(30_in);
+  DriveMotion nextRing = DriveDistance(50_in, DRIVE_SPEED, true);
+  co_await nextRing.Until(30_in);
   chassis.pid_speed_max_set(35);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-3_in, DRIVE_SPEED, true);
-  chassis.pid_wait();
+  co_await nextRing;
+  co_await DriveDistance(-3_in, DRIVE_SPEED, true);
 
   //Intake corner and score goal
-  chassis.pid_turn_set(315_deg, SLOW_TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(23_in, DRIVE_SPEED, true);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-12_in, DRIVE_SPEED, true);
-  chassis.pid_wait();
-  chassis.pid_turn_set(135_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-14_in, DRIVE_SPEED, true);
-  chassis.pid_wait();
+  co_await TurnTo(315_deg, SLOW_TURN_SPEED);
+  co_await DriveDistance(23_in, DRIVE_SPEED, true);
+  co_await DriveDistance(-12_in, DRIVE_SPEED, true);
+  co_await TurnTo(135_deg, TURN_SPEED);
+  co_await DriveDistance(-14_in, DRIVE_SPEED, true);
   OpenClamp();
-  chassis.pid_drive_set(18_in, DRIVE_SPEED, true);
-  chassis.pid_wait();
+  co_await DriveDistance(18_in, DRIVE_SPEED, true);
 
   //Intake next stack
-  chassis.pid_turn_set(180_deg, TURN_SPEED);
-  chassis.pid_wait();
+  co_await TurnTo(180_deg, TURN_SPEED);
   RunIntake(IntakeSpeed::SLOW);
-  chassis.pid_drive_set(69_in, SLOW_DRIVE_SPEED, true);
-  IntakeWait(AllianceMode::RED, 3000);
-  chassis.pid_wait();
+  DriveMotion stack = DriveDistance(69_in, SLOW_DRIVE_SPEED, true);
+  if(co_await WaitForRing(AllianceMode::RED, 3000) == ActionExit::CONDITION_MET)
+    RunIntake(IntakeSpeed::STOP);
+  co_await stack;
   RunIntake(IntakeSpeed::STOP);
 
   // Turn and clamp goal
-  chassis.pid_turn_set(270_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-26_in, 40, true);
-  chassis.pid_wait_until(-23_in);
+  co_await TurnTo(270_deg, TURN_SPEED);
+  ActionHandle grab2 = ClampOnGoal(2000);
+  co_await WhenAny(grab2, DriveDistance(-26_in, 40, true).Until(-23_in));
+  grab2.Cancel();
   CloseClamp();
-  pros::delay(300);
+  co_await Sleep(300);
   RunIntake(IntakeSpeed::FAST);
 
   // Face ring stack and collect ring
-  chassis.pid_turn_set(180_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(25_in, DRIVE_SPEED, true);
-  chassis.pid_wait();
-  pros::delay(200);
+  co_await TurnTo(180_deg, TURN_SPEED);
+  co_await DriveDistance(25_in, DRIVE_SPEED, true);
+  co_await Sleep(200);
 
   // Grab the second ring stack
-  chassis.pid_turn_set(270_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(28_in, DRIVE_SPEED, true);
-  chassis.pid_wait();
-  pros::delay(1500);
+  co_await TurnTo(270_deg, TURN_SPEED);
+  co_await DriveDistance(28_in, DRIVE_SPEED, true);
+  co_await Sleep(1500);
 
   // face corner, release goal
   RunIntake(IntakeSpeed::STOP);
-  chassis.pid_turn_set(45_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-13_in, DRIVE_SPEED, true);
-  chassis.pid_wait_until(-10_in);
+  co_await TurnTo(45_deg, TURN_SPEED);
+  DriveMotion corner = DriveDistance(-13_in, DRIVE_SPEED, true);
+  co_await corner.Until(-10_in);
   OpenClamp();
-  chassis.pid_wait();
-  pros::delay(500);
+  co_await corner;
+  co_await Sleep(500);
 
-  chassis.pid_drive_set(10_in, DRIVE_SPEED, true);
-  chassis.pid_wait();
+  co_await DriveDistance(10_in, DRIVE_SPEED, true);
 
   // ram back into corner for good measure
-  chassis.pid_drive_set(-10_in, DRIVE_SPEED, true);
-  chassis.pid_wait();
-  chassis.pid_drive_set(10_in, DRIVE_SPEED, true);
-  chassis.pid_wait();
+  co_await DriveDistance(-10_in, DRIVE_SPEED, true);
+  co_await DriveDistance(10_in, DRIVE_SPEED, true);
   RunIntake(IntakeSpeed::STOP); 
 
 }
 
+/**
+ * @brief Full autonomous routine used during Skills Challenge.
+ *
+ * Runs SkillsRoutine() on the autonomous task.
+ */
+void skills(){ RunRoutine(SkillsRoutine()); }
+
 /**
  * @brief Red-side match autonomous routine.
  *
@@ -320,15 +305,17 @@ void MatchAuton(){
   RunIntake(IntakeSpeed::STOP);
 
 
-  // clamp last goal
+  // clamp last goal, creeping in and closing by distance until the clamp lead constants are measured
   chassis.pid_turn_set(205_deg, TURN_SPEED);
   chassis.pid_wait();
   AsyncLadyBrown(WALLSTAKE_POSITION + 2000);
+  ActionHandle grab = ClampOnGoal(2000);
   chassis.pid_drive_set(-32.5_in, DRIVE_SPEED);
   chassis.pid_wait_until(-15_in);
   chassis.pid_speed_max_set(30);
   chassis.pid_wait_until(-27_in);
   CloseClamp();
+  grab.Cancel();
   chassis.pid_wait();
 
   pros::delay(300);
@@ -559,14 +546,15 @@ void odom_pure_pursuit_example() {
 // Odom Pure Pursuit Wait Until
 ///
 void odom_pure_pursuit_wait_until_example() {
+  // Start the intake from the control tick once the robot passes 12, 24, without stopping to wait for it
+  TriggerAdd("Intake at (12, 24)", OdomPassed({12_in, 24_in, 0_deg}), [] { RunIntake(IntakeSpeed::FAST); });
+
   chassis.pid_odom_set({{{0_in, 24_in}, fwd, DRIVE_SPEED},
                         {{12_in, 24_in}, fwd, DRIVE_SPEED},
                         {{24_in, 24_in}, fwd, DRIVE_SPEED}},
                        true);
-  chassis.pid_wait_until_index(1);  // Waits until the robot passes 12, 24
-  // Intake.move(127);  // Set your intake to start moving once it passes through the second point in the index
   chassis.pid_wait();
-  // Intake.move(0);  // Turn the intake off
+  RunIntake(IntakeSpeed::STOP);  // Turn the intake off
 }
 
 ///
@@ -598,61 +586,32 @@ void odom_boomerang_injected_pure_pursuit_example() {
 }
 
 ///
-// Calculate the offsets of your tracking wheels
+// Trajectories the spline example follows, generated by TrajectoryBuild() in initialize()
 ///
-void measure_offsets() {
-  // Number of times to test
-  int iterations = 10;
+const TrajectorySpec AUTON_TRAJECTORIES[] = {
+    // Spline Trajectory: from 0, 0 facing forward, curving to 24, 24 facing right
+    {TrajectoryId::SPLINE_EXAMPLE,
+     {{0_in, 0_in, 0_deg},
+      {24_in, 24_in, 90_deg}}},
+};
+const int AUTON_TRAJECTORY_COUNT = sizeof(AUTON_TRAJECTORIES) / sizeof(AUTON_TRAJECTORIES[0]);
 
-  // Our final offsets
-  double l_offset = 0.0, r_offset = 0.0, b_offset = 0.0, f_offset = 0.0;
-
-  // Reset all trackers if they exist
-  if (chassis.odom_tracker_left != nullptr) chassis.odom_tracker_left->reset();
-  if (chassis.odom_tracker_right != nullptr) chassis.odom_tracker_right->reset();
-  if (chassis.odom_tracker_back != nullptr) chassis.odom_tracker_back->reset();
-  if (chassis.odom_tracker_front != nullptr) chassis.odom_tracker_front->reset();
-  
-  for (int i = 0; i < iterations; i++) {
-    // Reset pid targets and get ready for running an auton
-    chassis.pid_targets_reset();
-    chassis.drive_imu_reset();
-    chassis.drive_sensor_reset();
-    chassis.drive_brake_set(MOTOR_BRAKE_HOLD);
-    chassis.odom_xyt_set(0_in, 0_in, 0_deg);
-    double imu_start = chassis.odom_theta_get();
-    double target = i % 2 == 0 ? 90 : 270;  // Switch the turn target every run from 270 to 90
-
-    // Turn to target at half power
-    chassis.pid_turn_set(target, 63, ez::raw);
-    chassis.pid_wait();
-    pros::delay(250);
-
-    // Calculate delta in angle
-    double t_delta = util::to_rad(fabs(util::wrap_angle(chassis.odom_theta_get() - imu_start)));
-
-    // Calculate delta in sensor values that exist
-    double l_delta = chassis.odom_tracker_left != nullptr ? chassis.odom_tracker_left->get() : 0.0;
-    double r_delta = chassis.odom_tracker_right != nullptr ? chassis.odom_tracker_right->get() : 0.0;
-    double b_delta = chassis.odom_tracker_back != nullptr ? chassis.odom_tracker_back->get() : 0.0;
-    double f_delta = chassis.odom_tracker_front != nullptr ? chassis.odom_tracker_front->get() : 0.0;
-
-    // Calculate the radius that the robot traveled
-    l_offset += l_delta / t_delta;
-    r_offset += r_delta / t_delta;
-    b_offset += b_delta / t_delta;
-    f_offset += f_delta / t_delta;
-  }
+///
+// Spline Trajectory
+///
+void odom_spline_example() {
+  // Curve to 24, 24 at the fastest speed the drive can hold along the spline.
+  // RAMSETE once DRIVE_TRACK_WIDTH is set from the tracker calibration fit, it splits the turn rate by it
+  TrajectoryStart(TrajectoryId::SPLINE_EXAMPLE, TrajectoryController::WHEEL_FEEDBACK);
+  TrajectoryWait();
 
-  // Average all offsets
-  l_offset /= iterations;
-  r_offset /= iterations;
-  b_offset /= iterations;
-  f_offset /= iterations;
-
-  // Set new offsets to trackers that exist
-  if (chassis.odom_tracker_left != nullptr) chassis.odom_tracker_left->distance_to_center_set(l_offset);
-  if (chassis.odom_tracker_right != nullptr) chassis.odom_tracker_right->distance_to_center_set(r_offset);
-  if (chassis.odom_tracker_back != nullptr) chassis.odom_tracker_back->distance_to_center_set(b_offset);
-  if (chassis.odom_tracker_front != nullptr) chassis.odom_tracker_front->distance_to_center_set(f_offset);
+  // Drive to 0, 0 backwards
+  chassis.pid_odom_set({{0_in, 0_in, 0_deg}, rev, DRIVE_SPEED},
+                       true);
+  chassis.pid_wait();
 }
+
+///
+// Calibrate the tracking wheels and IMU, starting with the back square against a wall
+///
+void measure_offsets() { RunRoutine(CalibrateTrackers()); }
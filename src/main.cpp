@@ -17,6 +17,17 @@
 #include "main.h"
 #include "subsystems.hpp"
 
+// Scheduler rates for the loops that live in this file
+const int DRIVE_PERIOD_MS = 10;
+const int SCREEN_PERIOD_MS = 100;
+
+// Set while driver control owns the drive, cleared when autonomous starts
+bool driverControl = false;
+
+// Scheduled ticks defined below
+void DriveTick();
+void ez_screen_tick();
+
 /**
  * @brief Initializes all robot hardware, chassis, and sensors.
  *
@@ -39,6 +50,9 @@ void initialize() {
   // Set the drive to constants from autons.cpp
   default_constants();
 
+  // Generate every auton trajectory now so the motions don't wait on it
+  TrajectoryBuild();
+
   // Use a limit switch to select autons
   ez::as::limit_switch_lcd_initialize(&selectButton);
 
@@ -59,7 +73,8 @@ void initialize() {
       {"Pure Pursuit Wait Until\n\nGo to (24, 24) but start running an intake once the robot passes (12, 24)", odom_pure_pursuit_wait_until_example},
       {"Boomerang\n\nGo to (0, 24, 45) then come back to (0, 0, 0)", odom_boomerang_example},
       {"Boomerang Pure Pursuit\n\nGo to (0, 24, 45) on the way to (24, 24) then come back to (0, 0, 0)", odom_boomerang_injected_pure_pursuit_example},
-      {"Measure Offsets\n\nThis will turn the robot a bunch of times and calculate your offsets for your tracking wheels.", measure_offsets},
+      {"Spline Trajectory\n\nCurve to (24, 24) facing right on a time-optimal spline tracked with RAMSETE, then come back to (0, 0, 0)", odom_spline_example},
+      {"Measure Offsets\n\nBack square against a wall, 4 ft clear ahead. Drives out, spins and backs in twice, then fits the tracker offsets, wheel size and IMU scaler.", measure_offsets},
   });
 
   // Initialize chassis and auton selector
@@ -73,7 +88,27 @@ void initialize() {
   // Update rotation sensor a little faster 
   liftRotation.set_data_rate(5);
 
-  liftPID.exit_condition_set(80, 50, 300, 150, 500, 500);
+  // PROFILED once the UNTUNED feedforward constants in lift.cpp are measured on the arm
+  SetLiftMode(LiftMode::DIRECT);
+
+  // Show the alliance mode on the controller at startup
+  DisplayAllianceMode();
+
+  // Fixed-rate control loops. Every 5 ms slot takes a sensor snapshot, advances the
+  // background actions and runs the lift. The 100 Hz loops take alternate slots, the
+  // intake in one and odometry and the drive in the other, and the screen
+  // rides the intake's slot. Odometry runs before the drive so driver code sees this slot's pose. Ticks in a
+  // slot run in the order they are added here, so the snapshot always comes first.
+  SchedulerAdd("Sensors", SENSORS_PERIOD_MS, 0, SensorsTick, &sensorsLoopStats);
+  SchedulerAdd("Odometry", ODOMETRY_PERIOD_MS, 5, OdometryTick, &odometryLoopStats);
+  SchedulerAdd("Trajectory", TRAJECTORY_PERIOD_MS, 5, TrajectoryTick, &trajectoryLoopStats);
+  SchedulerAdd("Actions", ACTIONS_PERIOD_MS, 0, ActionsTick, &actionsLoopStats);
+  SchedulerAdd("Triggers", TRIGGERS_PERIOD_MS, 0, TriggersTick, &triggersLoopStats);
+  SchedulerAdd("Lift", LIFT_PERIOD_MS, 0, LiftTick, &liftLoopStats);
+  SchedulerAdd("Drive", DRIVE_PERIOD_MS, 5, DriveTick, &driveLoopStats);
+  SchedulerAdd("Intake", INTAKE_PERIOD_MS, 0, IntakeTick, &intakeLoopStats);
+  SchedulerAdd("Screen", SCREEN_PERIOD_MS, 0, ez_screen_tick, &screenLoopStats);
+  SchedulerStart();
 
 }
 
@@ -85,7 +120,15 @@ void initialize() {
  * the VEX Competition Switch, following either autonomous or opcontrol. When
  * the robot is enabled, this task will exit.
  */
-void disabled(){}
+void disabled(){
+  // The auton task is gone, free the routines it left parked and stop what they started
+  ClearRoutines();
+  CancelActions();
+
+  // Keep the loop timing and the path of the period that just ended
+  LoopStatsDump();
+  PoseHistoryDump();
+}
 
 /**
  *
@@ -120,11 +163,13 @@ void autonomous() {
   chassis.pid_targets_reset();                   // Resets PID targets to 0
   chassis.drive_imu_reset();                     // Reset gyro position to 0
   chassis.drive_sensor_reset();                  // Reset drive sensors to 0
-  chassis.odom_xyt_set(0_in, 0_in, 0_deg);       // Set the current position, you can start at a specific position with this
+  fusedOdom.odom_xyt_set(0_in, 0_in, 0_deg);     // Set the current position, you can start at a specific position with this
   chassis.drive_brake_set(MOTOR_BRAKE_HOLD);     // Set motors to hold.  This helps autonomous consistency
-  IntakeTask.resume();
-  LiftTask.resume();
-  LiftTask.notify();
+  LoopStatsReset();                              // Time the loops over this period only
+  TriggersClear();                               // Drop triggers left over from an earlier run
+  TrajectoryStop();                              // A trajectory cut off with the last auton doesn't carry over
+  driverControl = false;                         // Hand the drive to the auton
+  LiftStart();
   ez::as::auton_selector.selected_auton_call();  // Calls selected auton from autonomous selector
 }
 
@@ -149,52 +194,85 @@ void screen_print_tracker(ez::tracking_wheel *tracker, std::string name, int lin
 }
 
 
+// Timing of the screen loop
+LoopStats screenLoopStats{"Screen", SCREEN_PERIOD_MS};
+
 /**
  *
  * @brief Runs an odometry debug page on the screen.
  *
  * Adding new pages here will let you view them during user control or autonomous
- * and will help you debug problems you're having
+ * and will help you debug problems you're having. Runs from the scheduler every
+ * SCREEN_PERIOD_MS.
  */
-void ez_screen_task() {
-  while (true) {
-    // Only run this when not connected to a competition switch
-    if (!pros::competition::is_connected()) {
-      // Blank page for odom debugging
-      if (chassis.odom_enabled() && !chassis.pid_tuner_enabled()) {
-        // If we're on the first blank page...
-        if (ez::as::page_blank_is_on(0)) {
-          // Display X, Y, and Theta
-          ez::screen_print("x: " + util::to_string_with_precision(chassis.odom_x_get()) +
-                               "\ny: " + util::to_string_with_precision(chassis.odom_y_get()) +
-                               "\na: " + util::to_string_with_precision(chassis.odom_theta_get()),
-                           1);  // Don't override the top Page line
-
-          // Display all trackers that are being used
-          screen_print_tracker(chassis.odom_tracker_left, "l", 4);
-          screen_print_tracker(chassis.odom_tracker_right, "r", 5);
-          screen_print_tracker(chassis.odom_tracker_back, "b", 6);
-          screen_print_tracker(chassis.odom_tracker_front, "f", 7);
-        }
+void ez_screen_tick() {
+  // Only run this when not connected to a competition switch
+  if (!pros::competition::is_connected()) {
+    // Blank page for odom debugging
+    if (chassis.odom_enabled() && !chassis.pid_tuner_enabled()) {
+      // If we're on the first blank page...
+      if (ez::as::page_blank_is_on(0)) {
+        // Display X, Y, and Theta
+        ez::screen_print("x: " + util::to_string_with_precision(chassis.odom_x_get()) +
+                             "\ny: " + util::to_string_with_precision(chassis.odom_y_get()) +
+                             "\na: " + util::to_string_with_precision(chassis.odom_theta_get()),
+                         1);  // Don't override the top Page line
+
+        // Display all trackers that are being used
+        screen_print_tracker(chassis.odom_tracker_left, "l", 4);
+        screen_print_tracker(chassis.odom_tracker_right, "r", 5);
+        screen_print_tracker(chassis.odom_tracker_back, "b", 6);
+        screen_print_tracker(chassis.odom_tracker_front, "f", 7);
       }
     }
 
-    // Remove all blank pages when connected to a comp switch
-    else {
-      if (ez::as::page_blank_amount() > 0)
-        ez::as::page_blank_remove_all();
+    // Second blank page shows how on time each task loop is running
+    if (ez::as::page_blank_is_on(1)) {
+      LoopStatsScreenPrint(1);
     }
+  }
 
-    pros::delay(ez::util::DELAY_TIME);
+  // Remove all blank pages when connected to a comp switch
+  else {
+    if (ez::as::page_blank_amount() > 0)
+      ez::as::page_blank_remove_all();
   }
 }
-pros::Task ezScreenTask(ez_screen_task);
+
+
+// Timing of the drive loop
+LoopStats driveLoopStats{"Drive", DRIVE_PERIOD_MS};
+
+/**
+ * @brief One pass of driver control for the drive and the mechanisms without their own loop.
+ *
+ * Runs from the scheduler every DRIVE_PERIOD_MS, but only while opcontrol() has
+ * handed it the robot.
+ */
+void DriveTick() {
+  if (!driverControl || pros::competition::is_disabled()) return;
+
+  // Run the drive mode
+  ChassisController(drive_type::ARCADE_SPLIT);
+
+  // Run doinker - driver control
+  DoinkerController();
+
+  // Run clamp - driver control
+  ClampController();
+
+  // Run timer that vibrates leading up to 30 seconds
+  CompTimerController();
+
+  // NOTE: intake and lift run on their own ticks
+}
 
 
 /**
- * @brief Main driver control loop.
+ * @brief Hands the robot to driver control.
  *
- * Runs the operator control code. This function will be started in its own task
+ * Resets the mechanisms for the match and lets the scheduler start running
+ * DriveTick(). Runs the operator control code. This function will be started in its own task
  * with the default priority and stack size whenever the robot is enabled via
  * the Field Management System or the VEX Competition Switch in the operator
  * control mode.
@@ -210,10 +288,8 @@ void opcontrol() {
   // This is preference to what you like to drive on
   chassis.drive_brake_set(MOTOR_BRAKE_COAST);
 
-  // ensure tasks are resumed before match
-  IntakeTask.resume();
-  LiftTask.resume();
-  LiftTask.notify();
+  // make sure the lift controller is running before the match
+  LiftStart();
 
   // make sure intake is down
   IntakeDown(); 
@@ -224,21 +300,17 @@ void opcontrol() {
   // Store the start time for timer calculations
   matchStartTime = pros::millis();
 
-  while (true) {
-    // Run the drive mode
-    ChassisController(drive_type::ARCADE_SPLIT);
-
-    // Run doinker - driver control
-    DoinkerController();
+  // Time the loops over this period only
+  LoopStatsReset();
 
-    // Run clamp - driver control
-    ClampController();
+  // auton routines, actions and triggers don't carry into driver control
+  ClearRoutines();
+  CancelActions();
+  TriggersClear();
 
-    // Run timer that vibrates leading up to 30 seconds
-    CompTimerController();
+  // nor does a trajectory the auton was following
+  TrajectoryStop();
 
-    // NOTE: intake and lift run on their own tasks
-
-    pros::delay(ez::util::DELAY_TIME);
-  }
+  // The scheduler runs DriveTick() from here on
+  driverControl = true;
 }
@@ -19,6 +19,9 @@ pros::adi::DigitalIn selectButton('D');
 pros::Optical clampOptical(3);
 pros::Optical intakeOptical(19);
 
+// Distance sensor facing back, the tracker calibration measures the straight legs with it
+pros::Distance backDistance(16);
+
 // Chassis constructor
 ez::Drive chassis(
     // These are your drive motors, the first motor is used for sensing!